@@ -5,6 +5,7 @@
 #include "PixelsScanFunction.hpp"
 #include "physical/StorageArrayScheduler.h"
 #include "profiler/CountProfiler.h"
+#include <atomic>
 
 namespace duckdb {
 
@@ -19,28 +20,38 @@ static idx_t PixelsScanGetBatchIndex(ClientContext &context, const FunctionData
 
 static double PixelsProgress(ClientContext &context, const FunctionData *bind_data_p,
                               const GlobalTableFunctionState *global_state) {
-	auto &bind_data = (PixelsReadBindData &)*bind_data_p;
-	if (bind_data.files.empty()) {
-		return 100.0;
+	auto &gstate = (const PixelsReadGlobalState &)*global_state;
+	if (gstate.storageArrayScheduler == nullptr) {
+		return 0.0;
 	}
-	auto percentage = bind_data.curFileId * 100.0 / bind_data.files.size();
-	return percentage;
+	// the files are split into scan units of row groups, see PixelsScanInitGlobal
+	return gstate.storageArrayScheduler->getProgress() * 100.0;
 }
 
 static unique_ptr<NodeStatistics> PixelsCardinality(ClientContext &context, const FunctionData *bind_data) {
 	auto &data = (PixelsReadBindData &)*bind_data;
 
-	return make_uniq<NodeStatistics>(data.initialPixelsReader->getNumberOfRows() * data.files.size());
+	idx_t numberOfRows = 0;
+	for (auto &fileTail : data.fileTails) {
+		if (fileTail == nullptr) {
+			// estimate by the first file if some files are not in the manifests
+			return make_uniq<NodeStatistics>(data.initialPixelsReader->getNumberOfRows() * data.files.size());
+		}
+		numberOfRows += fileTail->postscript().numberofrows();
+	}
+	return make_uniq<NodeStatistics>(numberOfRows);
 }
 
 TableFunctionSet PixelsScanFunction::GetFunctionSet() {
     TableFunction table_function("pixels_scan", {LogicalType::VARCHAR}, PixelsScanImplementation, PixelsScanBind,
 	                             PixelsScanInitGlobal, PixelsScanInitLocal);
 	table_function.projection_pushdown = true;
-//	table_function.filter_pushdown = true;
+	table_function.filter_pushdown = true;
     //table_function.filter_prune = true;
     enable_filter_pushdown = table_function.filter_pushdown;
     MultiFileReader::AddParameters(table_function);
+	// the priority class of the scan, interactive or batch, see read.request.priority
+	table_function.named_parameters["priority"] = LogicalType::VARCHAR;
 	table_function.get_batch_index = PixelsScanGetBatchIndex;
 	table_function.cardinality = PixelsCardinality;
 	table_function.table_scan_progress = PixelsProgress;
@@ -81,7 +92,15 @@ void PixelsScanFunction::PixelsScanImplementation(ClientContext &context,
         uint64_t currentLoc = data.vectorizedRowBatch->position();
         std::shared_ptr<TypeDescription> resultSchema = data.currPixelsRecordReader->getResultSchema();
         uint64_t remaining = data.vectorizedRowBatch->remaining();
-        assert(remaining > 0);
+        if (remaining == 0) {
+            // the batch is empty, e.g., all the row groups of the scan unit are pruned,
+            // read the next batch, or move on to the next scan unit if this one is done
+            data.vectorizedRowBatch = nullptr;
+            if (currPixelsRecordReader->isEndOfFile()) {
+                data.currPixelsRecordReader.reset();
+            }
+            continue;
+        }
         auto thisOutputChunkRows = MinValue<idx_t>(STANDARD_VECTOR_SIZE, remaining);
         output.SetCardinality(thisOutputChunkRows);
         std::shared_ptr<PixelsBitMask> filterMask =
@@ -142,7 +161,12 @@ unique_ptr<FunctionData> PixelsScanFunction::PixelsScanBind(
     // sort the pxl file by file name, so that all SSD arrays can be fully utilized
     sort(files.begin(), files.end(), compare_file_name());
 
-	auto footerCache = std::make_shared<PixelsFooterCache>();
+	auto footerCache = PixelsFooterCache::Instance();
+	// the tails in the manifests are put into the footer cache, so the files in them are not opened to plan the scan
+	std::vector<std::shared_ptr<pixels::proto::FileTail>> fileTails(files.size());
+	if (ConfigFactory::Instance().boolCheckProperty("manifest.enabled")) {
+		fileTails = PixelsManifest::getFileTails(files, footerCache);
+	}
 	auto builder = std::make_shared<PixelsReaderBuilder>();
 
 	std::shared_ptr<::Storage> storage = StorageFactory::getInstance()->getStorage(::Storage::file);
@@ -156,9 +180,14 @@ unique_ptr<FunctionData> PixelsScanFunction::PixelsScanBind(
 	names = fileSchema->getFieldNames();
 
 	auto result = make_uniq<PixelsReadBindData>();
+	auto priority = input.named_parameters.find("priority");
+	result->priority = RateLimitedScheduler::ParsePriority(
+	        priority != input.named_parameters.end() ? StringValue::Get(priority->second)
+	                                                 : ConfigFactory::Instance().getProperty("read.request.priority"));
 	result->initialPixelsReader = pixelsReader;
 	result->fileSchema = fileSchema;
 	result->files = files;
+	result->fileTails = fileTails;
 
 	return std::move(result);
 }
@@ -179,13 +208,66 @@ unique_ptr<GlobalTableFunctionState> PixelsScanFunction::PixelsScanInitGlobal(
 
     result->storageArrayScheduler = std::make_shared<StorageArrayScheduler>(bind_data.files, max_threads);
 
-    result->file_index.resize(result->storageArrayScheduler->getDeviceSum());
+    // split the files into row group ranges, so that a few large files can also be
+    // scanned by all the threads.
+    std::unordered_map<std::string, int> rowGroupNums;
+    std::shared_ptr<::Storage> storage = StorageFactory::getInstance()->getStorage(::Storage::file);
+    auto fileTails = bind_data.fileTails;
+    if (ConfigFactory::Instance().boolCheckProperty("footer.prefetch.enabled")) {
+        // prefetch the tails not in the manifests, so that the scan threads find all of them in the footer cache
+        std::vector<std::string> missedFiles;
+        std::vector<int> missedIndexes;
+        for (int i = 0; i < bind_data.files.size(); i++) {
+            if (fileTails[i] == nullptr) {
+                missedFiles.emplace_back(bind_data.files[i]);
+                missedIndexes.emplace_back(i);
+            }
+        }
+        auto prefetched = PixelsFooterPrefetcher::prefetch(missedFiles, PixelsFooterCache::Instance());
+        for (int i = 0; i < missedIndexes.size(); i++) {
+            fileTails[missedIndexes[i]] = prefetched[i];
+        }
+    }
+    std::vector<int> unknownFiles;
+    for (int i = 0; i < bind_data.files.size(); i++) {
+        if (fileTails[i] != nullptr) {
+            rowGroupNums[bind_data.files[i]] = fileTails[i]->footer().rowgroupinfos_size();
+        } else {
+            unknownFiles.emplace_back(i);
+        }
+    }
+    // the files whose tails are neither in the manifests nor prefetched are opened by max_threads threads
+    std::vector<int> unknownRowGroupNums(unknownFiles.size());
+    std::atomic<int> nextFile(0);
+    std::vector<std::future<void>> openers;
+    for (int t = 0; t < std::min<int>(max_threads, unknownFiles.size()); t++) {
+        openers.emplace_back(std::async(std::launch::async, [&]() {
+            for (int j = nextFile++; j < unknownFiles.size(); j = nextFile++) {
+                auto builder = std::make_shared<PixelsReaderBuilder>();
+                auto reader = builder->setPath(bind_data.files[unknownFiles[j]])
+                        ->setStorage(storage)
+                        ->setPixelsFooterCache(PixelsFooterCache::Instance())
+                        ->build();
+                unknownRowGroupNums[j] = reader->getRowGroupNum();
+                reader->close();
+            }
+        }));
+    }
+    for (auto &opener : openers) {
+        opener.get();
+    }
+    for (int j = 0; j < unknownFiles.size(); j++) {
+        rowGroupNums[bind_data.files[unknownFiles[j]]] = unknownRowGroupNums[j];
+    }
+    int rowGroupsPerUnit = std::stoi(ConfigFactory::Instance().getProperty("pixel.scan.unit.rowgroups"));
+    result->storageArrayScheduler->initScanUnits(rowGroupNums, rowGroupsPerUnit);
 
 	result->max_threads = max_threads;
 
 	result->batch_index = 0;
 
     result->filters = input.filters.get();
+    result->priority = bind_data.priority;
 
 	return std::move(result);
 }
@@ -211,7 +293,18 @@ unique_ptr<LocalTableFunctionState> PixelsScanFunction::PixelsScanInitLocal(
 		}
 	}
 
-    ::DirectUringRandomAccessFile::Initialize();
+    // the idle buffers of this thread beyond the budget of all the threads are freed before its scan,
+    // a thread that does not scan for a while frees them here rather than at the end of its next scan
+    bool buffersFreed = ::BufferPool::Trim();
+    if(ConfigFactory::Instance().getProperty("localfs.async.lib") == "iouring") {
+        ::DirectUringRandomAccessFile::Initialize();
+        if(buffersFreed) {
+            // the freed buffers are unpinned only when they are unregistered
+            ::DirectUringRandomAccessFile::Release(true);
+        }
+    } else {
+        ::DirectAioRandomAccessFile::Initialize();
+    }
 	if(!PixelsParallelStateNext(context.client, bind_data, *result, gstate, true)) {
 		return nullptr;
 	}
@@ -269,6 +362,22 @@ void PixelsScanFunction::TransformDuckdbType(const std::shared_ptr<TypeDescripti
 	}
 }
 
+// the values of the column vector at its read position. The values of a vector served from the
+// vector cache are referenced in the cache, they are not decoded into the column vector.
+static data_ptr_t CurrentData(ColumnVector & col, idx_t width) {
+    if(col.cachedVector != nullptr) {
+        return (data_ptr_t)(col.cachedVector->values.get() + col.readIndex * width);
+    }
+    return (data_ptr_t)(col.current());
+}
+
+static uint64_t * CurrentValid(ColumnVector & col) {
+    if(col.cachedVector != nullptr) {
+        return col.cachedVector->valid.data() + col.readIndex / 64;
+    }
+    return col.currentValid();
+}
+
 void PixelsScanFunction::TransformDuckdbChunk(PixelsReadLocalState & data,
                                               DataChunk & output,
                                               const std::shared_ptr<TypeDescription> & schema,
@@ -293,7 +402,7 @@ void PixelsScanFunction::TransformDuckdbChunk(PixelsReadLocalState & data,
 			case TypeDescription::INT: {
 			    auto intCol = std::static_pointer_cast<LongColumnVector>(col);
                 Vector vector(LogicalType::INTEGER,
-                              (data_ptr_t)(intCol->current()), col->currentValid());
+                              CurrentData(*intCol, sizeof(int32_t)), CurrentValid(*col));
                 output.data.at(col_id).Reference(vector);
 //			    auto result_ptr = FlatVector::GetData<int>(output.data.at(col_id));
 //			    memcpy(result_ptr, intCol->intVector + row_offset, thisOutputChunkRows * sizeof(int));
@@ -306,7 +415,7 @@ void PixelsScanFunction::TransformDuckdbChunk(PixelsReadLocalState & data,
 			case TypeDescription::LONG: {
 				auto longCol = std::static_pointer_cast<LongColumnVector>(col);
                 Vector vector(LogicalType::BIGINT,
-                              (data_ptr_t)(longCol->current()), col->currentValid());
+                              CurrentData(*longCol, sizeof(int64_t)), CurrentValid(*col));
                 output.data.at(col_id).Reference(vector);
 //			    auto result_ptr = FlatVector::GetData<long>(output.data.at(col_id));
 //			    memcpy(result_ptr, longCol->longVector + row_offset, thisOutputChunkRows * sizeof(long));
@@ -322,7 +431,7 @@ void PixelsScanFunction::TransformDuckdbChunk(PixelsReadLocalState & data,
 		    case TypeDescription::DECIMAL: {
 			    auto decimalCol = std::static_pointer_cast<DecimalColumnVector>(col);
                 Vector vector(LogicalType::DECIMAL(colSchema->getPrecision(), colSchema->getScale()),
-                              (data_ptr_t)(decimalCol->current()), col->currentValid());
+                              CurrentData(*decimalCol, sizeof(int64_t)), CurrentValid(*col));
                 output.data.at(col_id).Reference(vector);
 //			    auto result_ptr = FlatVector::GetData<long>(output.data.at(col_id));
 //			    memcpy(result_ptr, decimalCol->vector + row_offset, thisOutputChunkRows * sizeof(long));
@@ -337,7 +446,7 @@ void PixelsScanFunction::TransformDuckdbChunk(PixelsReadLocalState & data,
 			case TypeDescription::DATE:{
 			    auto dateCol = std::static_pointer_cast<DateColumnVector>(col);
                 Vector vector(LogicalType::DATE,
-                              (data_ptr_t)(dateCol->current()), col->currentValid());
+                              CurrentData(*dateCol, sizeof(int32_t)), CurrentValid(*col));
                 output.data.at(col_id).Reference(vector);
 //			    auto result_ptr = FlatVector::GetData<int>(output.data.at(col_id));
 //			    memcpy(result_ptr, dateCol->dates + row_offset, thisOutputChunkRows * sizeof(int));
@@ -352,7 +461,7 @@ void PixelsScanFunction::TransformDuckdbChunk(PixelsReadLocalState & data,
             case TypeDescription::TIMESTAMP: {
                 auto tsCol = std::static_pointer_cast<TimestampColumnVector>(col);
                 Vector vector(LogicalType::TIMESTAMP,
-                              (data_ptr_t)(tsCol->current()), col->currentValid());
+                              CurrentData(*tsCol, sizeof(int64_t)), CurrentValid(*col));
                 output.data.at(col_id).Reference(vector);
                 break;
             }
@@ -365,9 +474,23 @@ void PixelsScanFunction::TransformDuckdbChunk(PixelsReadLocalState & data,
 			case TypeDescription::CHAR:
 		    {
 			    auto binaryCol = std::static_pointer_cast<BinaryColumnVector>(col);
-                Vector vector(LogicalType::VARCHAR,
-                              (data_ptr_t)(binaryCol->current()), col->currentValid());
-                output.data.at(col_id).Reference(vector);
+                if(binaryCol->cachedVector != nullptr || binaryCol->isDictionary) {
+                    // emit a dictionary vector, nulls point to the null entry at the end of the dictionary
+                    auto & dictionary = binaryCol->cachedVector != nullptr ?
+                            binaryCol->cachedVector->dictionary : binaryCol->dictionary;
+                    Vector dictVector(LogicalType::VARCHAR,
+                                      (data_ptr_t)(dictionary->values.data()), dictionary->valid.data());
+                    // the dictionary ids of the cached vector, or of the chunk decoded by this reader
+                    auto dictIds = binaryCol->cachedVector != nullptr ?
+                            CurrentData(*binaryCol, sizeof(uint32_t)) :
+                            (data_ptr_t)(binaryCol->dictIds + binaryCol->readIndex);
+                    SelectionVector sel((sel_t *)dictIds);
+                    output.data.at(col_id).Slice(dictVector, sel, thisOutputChunkRows);
+                } else {
+                    Vector vector(LogicalType::VARCHAR,
+                                  (data_ptr_t)(binaryCol->current()), col->currentValid());
+                    output.data.at(col_id).Reference(vector);
+                }
 //			    auto result_ptr = FlatVector::GetData<duckdb::string_t>(output.data.at(col_id));
 //                memcpy(result_ptr, binaryCol->vector + row_offset, thisOutputChunkRows * sizeof(string_t));
 			    break;
@@ -393,32 +516,36 @@ bool PixelsScanFunction::PixelsParallelStateNext(ClientContext &context, const P
 
     auto& StorageInstance = parallel_state.storageArrayScheduler;
     // In the following two cases, the state ends:
-    // 1. When PixelsScanInitLocal invokes this function, if all files are
+    // 1. When PixelsScanInitLocal invokes this function, if all scan units are
     // fetched by other threads, this means this thread doesn't need do anything, so just return false;
-    // 2. When PixelsScanImplementation invokes this function (scan_data.next_file_index > -1), if
-    // scan_data.next_file_index >= (int) StorageInstance.getFileSum(scan_data.deviceID), it means the current file is already
-    // done, so the function return false.
-    if ((is_init_state && parallel_state.file_index.at(scan_data.deviceID) >= StorageInstance->getFileSum(scan_data.deviceID)) ||
-            scan_data.next_file_index >= StorageInstance->getFileSum(scan_data.deviceID)) {
-		::BufferPool::Reset();
-		// if async io is enabled, we need to unregister uring buffer
+    // 2. When PixelsScanImplementation invokes this function, if no scan unit was prefetched
+    // (scan_data.nextPixelsRecordReader == nullptr), the current scan unit is already done,
+    // so the function return false.
+    ScanUnit nextUnit;
+    bool hasNextUnit = (is_init_state || scan_data.nextPixelsRecordReader != nullptr) &&
+            StorageInstance->acquireScanUnit(scan_data.deviceID, nextUnit);
+    if ((is_init_state && !hasNextUnit) ||
+            (!is_init_state && scan_data.nextPixelsRecordReader == nullptr)) {
+		// the buffers and the io_uring ring of this thread are kept for its next scan
+		bool buffersFreed = ::BufferPool::Release();
 		if(ConfigFactory::Instance().boolCheckProperty("localfs.enable.async.io")) {
 			if(ConfigFactory::Instance().getProperty("localfs.async.lib") == "iouring") {
-				::DirectUringRandomAccessFile::Reset();
-			} else if(ConfigFactory::Instance().getProperty("localfs.async.lib") == "aio") {
-				throw InvalidArgumentException("PhysicalLocalReader::readAsync: We don't support aio for our async read yet.");
+				::DirectUringRandomAccessFile::Release(buffersFreed);
+			} else {
+				::DirectAioRandomAccessFile::Release();
 			}
 		}
         parallel_lock.unlock();
         return false;
     }
 
-    scan_data.curr_file_index = scan_data.next_file_index;
     scan_data.curr_batch_index = scan_data.next_batch_index;
-    scan_data.next_file_index = parallel_state.file_index.at(scan_data.deviceID);
-    scan_data.next_batch_index = StorageInstance->getBatchID(scan_data.deviceID, scan_data.next_file_index);
     scan_data.curr_file_name = scan_data.next_file_name;
-    parallel_state.file_index.at(scan_data.deviceID)++;
+    if (hasNextUnit) {
+        // batch index is handed out in acquisition order, so it is increasing in each thread
+        // even if the scan unit is stolen from another device
+        scan_data.next_batch_index = parallel_state.batch_index++;
+    }
     parallel_lock.unlock();
     // The below code uses global state but no race happens, so we don't need the lock anymore
     
@@ -430,16 +557,15 @@ bool PixelsScanFunction::PixelsParallelStateNext(ClientContext &context, const P
     ::BufferPool::Switch();
     scan_data.currReader = scan_data.nextReader;
     scan_data.currPixelsRecordReader = scan_data.nextPixelsRecordReader;
-    // asyncReadComplete is not invoked in the first run (is_init_state = true)
-    if (scan_data.currPixelsRecordReader != nullptr) {
-        auto currPixelsRecordReader = std::static_pointer_cast<PixelsRecordReaderImpl>(scan_data.currPixelsRecordReader);
-        currPixelsRecordReader->asyncReadComplete((int)scan_data.column_names.size());
-    }
-    if(scan_data.next_file_index < StorageInstance->getFileSum(scan_data.deviceID)) {
-        auto footerCache = std::make_shared<PixelsFooterCache>();
+    // the reads of the current reader are not waited here, readBatch decodes each column as soon as
+    // its chunk arrives, while the reads of the next reader are in flight
+    if(hasNextUnit) {
+        auto footerCache = PixelsFooterCache::Instance();
         auto builder = std::make_shared<PixelsReaderBuilder>();
         std::shared_ptr<::Storage> storage = StorageFactory::getInstance()->getStorage(::Storage::file);
-        scan_data.next_file_name = StorageInstance->getFileName(scan_data.deviceID, scan_data.next_file_index);
+        scan_data.next_file_name = nextUnit.fileName;
+        scan_data.next_rg_start = nextUnit.rgStart;
+        scan_data.next_rg_len = nextUnit.rgLen;
         scan_data.nextReader = builder->setPath(scan_data.next_file_name)
                 ->setStorage(storage)
                 ->setPixelsFooterCache(footerCache)
@@ -465,8 +591,9 @@ PixelsReaderOption PixelsScanFunction::GetPixelsReaderOption(PixelsReadLocalStat
     option.setEnabledFilterPushDown(enable_filter_pushdown);
     // includeCols comes from the caller of PixelsPageSource
     option.setIncludeCols(local_state.column_names);
-    option.setRGRange(0, local_state.nextReader->getRowGroupNum());
+    option.setRGRange(local_state.next_rg_start, local_state.next_rg_len);
     option.setQueryId(1);
+    option.setPriority(global_state.priority);
     int stride = std::stoi(ConfigFactory::Instance().getProperty("pixel.stride"));
     option.setBatchSize(stride);
     return option;
@@ -12,6 +12,7 @@
 #include "duckdb/function/scalar_function.hpp"
 #include <duckdb/parser/parsed_data/create_scalar_function_info.hpp>
 #include "PixelsReader.h"
+#include "physical/Request.h"
 
 
 namespace duckdb {
@@ -20,6 +21,10 @@ struct PixelsReadBindData : public TableFunctionData {
 	std::shared_ptr<PixelsReader> initialPixelsReader;
 	std::shared_ptr<TypeDescription> fileSchema;
 	vector<string> files;
+	// the tail of each file from the .pxl-manifest of its directory, nullptr if it is not in a valid manifest
+	std::vector<std::shared_ptr<pixels::proto::FileTail>> fileTails;
+	// the priority class of the read requests of the scan
+	RequestPriority priority;
 	atomic<idx_t> curFileId;
 };
 
@@ -12,6 +12,7 @@
 #include <duckdb/parser/parsed_data/create_scalar_function_info.hpp>
 #include "PixelsReader.h"
 #include "physical/StorageArrayScheduler.h"
+#include "physical/Request.h"
 
 namespace duckdb {
 
@@ -29,9 +30,6 @@ struct PixelsReadGlobalState : public GlobalTableFunctionState {
 
     std::shared_ptr<StorageArrayScheduler> storageArrayScheduler;
 
-	//! Index of file currently up for scanning
-	vector<idx_t> file_index;
-
 	//! Batch index of the next row group to be scanned
 	idx_t batch_index;
 
@@ -39,6 +37,8 @@ struct PixelsReadGlobalState : public GlobalTableFunctionState {
 
     TableFilterSet * filters;
 
+    RequestPriority priority;
+
 	idx_t MaxThreads() const override {
 		return max_threads;
 	}
@@ -17,8 +17,8 @@ namespace duckdb {
 
 struct PixelsReadLocalState : public LocalTableFunctionState {
     PixelsReadLocalState() {
-        curr_file_index = 0;
-        next_file_index = 0;
+        next_rg_start = 0;
+        next_rg_len = 0;
         curr_batch_index = 0;
         next_batch_index = 0;
         rowOffset = 0;
@@ -38,8 +38,9 @@ struct PixelsReadLocalState : public LocalTableFunctionState {
 	vector<string> column_names;
 	std::shared_ptr<PixelsReader> currReader;
     std::shared_ptr<PixelsReader> nextReader;
-	idx_t curr_file_index;
-    idx_t next_file_index;
+    // the row group range of the prefetched scan unit
+    int next_rg_start;
+    int next_rg_len;
     idx_t curr_batch_index;
     idx_t next_batch_index;
     std::string next_file_name;
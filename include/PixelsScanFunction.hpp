@@ -23,6 +23,7 @@
 #include "physical/storage/LocalFS.h"
 #include "physical/natives/ByteBuffer.h"
 #include "physical/natives/DirectRandomAccessFile.h"
+#include "physical/natives/DirectAioRandomAccessFile.h"
 #include "physical/io/PhysicalLocalReader.h"
 #include "physical/StorageFactory.h"
 #include "PixelsReaderImpl.h"
@@ -34,6 +35,9 @@
 #include "physical/SchedulerFactory.h"
 #include "PixelsVersion.h"
 #include "PixelsFooterCache.h"
+#include "PixelsVectorCache.h"
+#include "PixelsManifest.h"
+#include "PixelsFooterPrefetcher.h"
 #include "exception/PixelsReaderException.h"
 #include "reader/PixelsReaderOption.h"
 #include "TypeDescription.h"
@@ -30,6 +30,7 @@
 #include "vector/VectorizedRowBatch.h"
 #include "physical/storage/LocalFS.h"
 #include "PixelsWriterImpl.h"
+#include "PixelsManifest.h"
 #include <boost/regex.hpp>
 #include <iostream>
 #include <fstream>
@@ -63,6 +64,7 @@ void PixelsConsumer::run() {
     int pixelsStride = 2;
     int rowGroupSize = 100;
     int64_t blockSize = 1024;
+    int compressionBlockSize = std::stoi(ConfigFactory::Instance().getProperty("compression.block.size"));
 
     short replication = static_cast<short>(std::stoi(ConfigFactory::Instance().getProperty("block.replication")));
 
@@ -101,7 +103,7 @@ void PixelsConsumer::run() {
                     targetFileName = std::to_string(std::chrono::system_clock::to_time_t(std::chrono::system_clock::now())) + ".pxl";
                     targetFilePath = targetPath + targetFileName;
                     pixelsWriter = std::make_shared<PixelsWriterImpl>(schema, pixelsStride, rowGroupSize, targetFilePath, blockSize,
-                                                                      true, encodingLevel, nullPadding,false, 1);
+                                                                      true, encodingLevel, nullPadding,false, compressionBlockSize);
                 }
                 initPixelsFile = false;
 
@@ -151,5 +153,7 @@ void PixelsConsumer::run() {
         pixelsWriter->close();
         this->loadedFiles.push_back(targetFilePath);
     }
+    // keep the manifest of the target directory up to date with the loaded files
+    PixelsManifest::refresh(targetPath);
     std::cout << "Exit PixelsConsumer" << std::endl;
 }
\ No newline at end of file
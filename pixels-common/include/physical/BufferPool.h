@@ -13,29 +13,73 @@
 #include "exception/InvalidArgumentException.h"
 #include "utils/ColumnSizeCSVReader.h"
 #include <map>
+#include <atomic>
+#include <chrono>
 
-// when allocating buffer pool, we use the size of the first pxl file. Consider that
-// the remaining pxl file has larger size than the first file, we allocate some extra
-// size (10MB) to each column.
-// TODO: how to evaluate the maximal pool size
-#define EXTRA_POOL_SIZE 3*1024*1024
+// the smallest size class of the buffers
+#define MIN_POOL_BUFFER_SIZE 64*1024
 
 class DirectUringRandomAccessFile;
-// This class is global class. The variable is shared by each thread
+/**
+ * The buffers of the column chunks, one per column and double buffered for the current and the next file.
+ * The buffer sizes are rounded up to power-of-two size classes. When a chunk does not fit into its buffer,
+ * the buffer is replaced by one of a large enough size class, so the pool adapts to skewed files without
+ * a column size file, and DirectUringRandomAccessFile re-registers only the replaced buffers.
+ *
+ * The buffers are kept per thread rather than in a pool shared by the threads. A scan thread reads its
+ * files one at a time, so its buffers are never used by another thread. They are also registered with
+ * the io_uring ring of the thread, and fixed buffers belong to a ring. A buffer shared by the threads
+ * would have to be registered with every ring that reads into it. Only the idle buffers are reused
+ * between scans, and their budget, buffer.pool.idle.bytes, is shared by all the threads.
+ */
 class BufferPool {
 public:
 	static void Initialize(std::vector<uint32_t> colIds, std::vector<uint64_t> bytes, std::vector<std::string> columnNames);
+	// @return the size class of a buffer holding the given number of bytes
+	static uint64_t GetSizeClass(uint64_t bytes);
 	static std::shared_ptr<ByteBuffer> GetBuffer(uint32_t colId);
+	// get the buffer that a compressed column chunk of colId is decompressed into
+	static std::shared_ptr<ByteBuffer> GetDecompressBuffer(uint32_t colId, uint64_t size);
     static int64_t GetBufferId(uint32_t index);
     static void Switch();
 	static void Reset();
+	/**
+	 * Release the buffers of the scan that ends in this thread to the idle buffers, and trim them.
+	 * @return whether any buffer is freed
+	 */
+	static bool Release();
+	/**
+	 * Free the idle buffers of this thread that are not reused for buffer.pool.idle.timeout seconds, and
+	 * the largest ones while the idle buffers of all the threads take more than buffer.pool.idle.bytes.
+	 * A thread can only free its own idle buffers, as they may be registered with its io_uring ring.
+	 * @return whether any buffer is freed
+	 */
+	static bool Trim();
+	// @return the bytes of the idle buffers of all the threads
+	static uint64_t GetIdleBytes();
 private:
+	struct IdleBuffer {
+		std::shared_ptr<ByteBuffer> buffer;
+		std::chrono::steady_clock::time_point since;
+	};
+	// takes the idle buffers of a thread off the total when the thread exits
+	struct IdleBytesCloser {
+		~IdleBytesCloser();
+	};
 	BufferPool() = default;
+	static std::shared_ptr<ByteBuffer> AllocateBuffer(uint64_t bytes);
+	static void ReleaseBuffer(const std::shared_ptr<ByteBuffer> & buffer, std::chrono::steady_clock::time_point now);
 	static thread_local int colCount;
-	static thread_local std::map<uint32_t, uint64_t> nrBytes;
 	static thread_local bool isInitialized;
 	static thread_local std::map<uint32_t, std::shared_ptr<ByteBuffer>> buffers[2];
-	static std::shared_ptr<DirectIoLib> directIoLib;
+	// double buffered like the chunk buffers, since the next reader decompresses its chunks
+	// on the sync read path while the current reader still decodes from its own
+	static thread_local std::map<uint32_t, std::shared_ptr<ByteBuffer>> decompressBuffers[2];
+	// the idle buffers of this thread keyed by their sizes
+	static thread_local std::multimap<uint64_t, IdleBuffer> idleBuffers;
+	static thread_local uint64_t idleBytes;
+	static std::atomic<uint64_t> totalIdleBytes;
+	static thread_local std::shared_ptr<DirectIoLib> directIoLib;
     static thread_local int currBufferIdx;
     static thread_local int nextBufferIdx;
     friend class DirectUringRandomAccessFile;
@@ -49,7 +49,13 @@ public:
 //    virtual int readInt() = 0;
     virtual void close() = 0;
 
-//    virtual std::string getPath() = 0;
+    virtual std::string getPath() = 0;
+
+    /**
+     * @return the last modification time of the file in nanoseconds since epoch,
+     * it is used together with the file length to tell whether cached metadata is stale.
+     */
+    virtual long getLastModified() = 0;
 
     /**
     * Get the last domain in path.
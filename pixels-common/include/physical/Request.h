@@ -7,6 +7,12 @@
 
 #include <iostream>
 
+// the priority class of the query that issues the requests, see RateLimitedScheduler
+enum class RequestPriority {
+    INTERACTIVE,  // the latency sensitive queries, e.g., the dashboards
+    BATCH         // the long running scans, e.g., the backfills, they give way to the interactive queries
+};
+
 class Request {
 public:
     int64_t bufferId;
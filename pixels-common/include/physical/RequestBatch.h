@@ -19,10 +19,14 @@ public:
     void add(Request request);
     int getSize();
     std::vector<Request> getRequests();
+    void setPriority(RequestPriority priority);
+    RequestPriority getPriority() const;
 //    std::vector<std::promise<ByteBuffer *>> * getPromises();
 private:
     int size;
     std::vector<Request> requests;
+    // the requests in a batch are issued by the same query
+    RequestPriority priority;
 //    std::vector<std::promise<ByteBuffer *>> promises;
 
 };
@@ -7,24 +7,60 @@
 
 #include "utils/ConfigFactory.h"
 #include <vector>
+#include <deque>
 #include <mutex>
 #include <unordered_map>
 
+/**
+ * A scan unit is a contiguous range of row groups in one pxl file.
+ * It is the granularity that the scan threads fetch work from the scheduler.
+ */
+struct ScanUnit {
+    std::string fileName;
+    int rgStart;
+    int rgLen;
+};
+
 class StorageArrayScheduler {
 public:
     StorageArrayScheduler(std::vector<std::string>& files, int threadNum);
     int acquireDeviceId();
+    /**
+     * @param file the path of a file
+     * @param storageDepth the directory depth that determines the storage device, see storage.directory.depth
+     * @return the name of the storage device that the file is on
+     */
+    static std::string getDeviceName(const std::string &file, int storageDepth);
     int getDeviceSum();
-
-    std::string getFileName(int deviceID, int fileID);
-    uint64_t getFileSum(int deviceID);
-    int getMaxFileSum();
-    int getBatchID(int deviceID, int fileID);
+    /**
+     * Split each file into scan units of at most rowGroupsPerUnit row groups.
+     * If rowGroupsPerUnit is not positive, each file is a single scan unit.
+     *
+     * @param rowGroupNums the row group number of each file, keyed by file name
+     * @param rowGroupsPerUnit the maximal number of row groups in one scan unit
+     */
+    void initScanUnits(const std::unordered_map<std::string, int>& rowGroupNums, int rowGroupsPerUnit);
+    /**
+     * Fetch the next scan unit of the given device. If the queue of this device
+     * is drained, steal a scan unit from the tail of the device that has the most
+     * remaining units, so that no thread sits idle while others still have work.
+     *
+     * @return false if all the scan units are consumed
+     */
+    bool acquireScanUnit(int deviceID, ScanUnit& unit);
+    /**
+     * @return the fraction of the row groups in the scan units that are handed out to the scan threads,
+     * 1 if there is no row group to scan
+     */
+    double getProgress();
 private:
     std::mutex m;
     int currentDeviceID;
     int devicesNum;
     std::vector<std::vector<std::string>> filesVector;
+    std::vector<std::deque<ScanUnit>> scanUnitQueues;
+    uint64_t totalRowGroups = 0;
+    uint64_t acquiredRowGroups = 0;
 };
 
 #endif //DUCKDB_STORAGEARRAYSCHEDULER_H
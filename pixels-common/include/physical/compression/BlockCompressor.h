@@ -0,0 +1,34 @@
+//
+// Block compression of column chunks.
+//
+
+#ifndef DUCKDB_BLOCKCOMPRESSOR_H
+#define DUCKDB_BLOCKCOMPRESSOR_H
+
+#include "pixels-common/pixels.pb.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * A compressed column chunk is a sequence of blocks, each of which holds at most
+ * compressionBlockSize bytes of the original chunk. A block starts with an 8-byte
+ * little-endian header: the stored length of the block and its original length.
+ * If compression does not make a block smaller, the block is stored as is and
+ * the two lengths are equal.
+ */
+class BlockCompressor {
+public:
+    static const int BLOCK_HEADER_SIZE = 8;
+
+    static std::vector<uint8_t> compress(pixels::proto::CompressionKind kind, const uint8_t * data,
+                                         uint64_t length, uint32_t blockSize);
+    // the length of the original chunk, read from the block headers
+    static uint64_t getDecompressedLength(const uint8_t * data, uint64_t length);
+    static void decompress(pixels::proto::CompressionKind kind, const uint8_t * data, uint64_t length,
+                           uint8_t * output, uint64_t outputLength);
+    // parse the compression kind from its name in the config, e.g., none, lz4 or zstd
+    static pixels::proto::CompressionKind parseKind(const std::string & name);
+};
+
+#endif // DUCKDB_BLOCKCOMPRESSOR_H
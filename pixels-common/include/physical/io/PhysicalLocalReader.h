@@ -21,6 +21,9 @@ public:
 	std::shared_ptr<ByteBuffer> readAsync(int length, std::shared_ptr<ByteBuffer> bb, int index);
 	void readAsyncSubmit(uint32_t size);
 	void readAsyncComplete(uint32_t size);
+	void readAsyncComplete(uint32_t size, const std::function<void(int)> & onComplete);
+	// @return the buffer id of the next completed request that is waited, see DirectUringRandomAccessFile::readAsyncCompleteNext
+	int readAsyncCompleteNext(const std::function<bool(int)> & isWaited);
 	void readAsyncSubmitAndComplete(uint32_t size);
     void close() override;
     long getFileLength() override;
@@ -29,10 +32,13 @@ public:
     int readInt() override;
     char readChar() override;
     std::string getName() override;
+    std::string getPath() override;
+    long getLastModified() override;
 private:
     std::shared_ptr<LocalFS> local;
     std::string path;
     long id;
+    long lastModified;
     std::atomic<int> numRequests;
 	std::atomic<int> asyncNumRequests;
 	std::shared_ptr<PixelsRandomAccessFile> raf;
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PIXELS_DIRECTAIORANDOMACCESSFILE_H
+#define PIXELS_DIRECTAIORANDOMACCESSFILE_H
+
+#include "physical/natives/DirectRandomAccessFile.h"
+#include "exception/InvalidArgumentException.h"
+#include <linux/aio_abi.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * The async reads of localfs.async.lib=aio and pread, for the hosts where io_uring is not available, e.g.,
+ * the old kernels or the containers whose seccomp profile blocks it. The reads are batched, submitted and
+ * completed like the reads of DirectUringRandomAccessFile, and identified by their buffer indexes.
+ *
+ * With aio, the reads are submitted to the Linux native AIO context of the thread. If the context can not
+ * be set up, or with pread, the reads are issued by pread on a pool of worker threads instead. The native
+ * AIO only reads asynchronously with localfs.enable.direct.io, otherwise the kernel reads in io_submit.
+ */
+class DirectAioRandomAccessFile: public DirectRandomAccessFile {
+public:
+	explicit DirectAioRandomAccessFile(const std::string& file);
+	// set up the AIO context of this thread if it does not exist, or fall back to the pread workers
+	static void Initialize();
+	static void Reset();
+	// the requests of the scan that ends in this thread are done, the AIO context is kept for the next scan
+	static void Release();
+	// @return whether the reads of this thread are issued by the pread workers
+	static bool IsThreadPoolFallback();
+	std::shared_ptr<ByteBuffer> readAsync(int length, std::shared_ptr<ByteBuffer> buffer, int index);
+	void readAsyncSubmit(int size);
+	void readAsyncComplete(int size);
+	// onComplete is called with the buffer index of each request as soon as the request completes
+	void readAsyncComplete(int size, const std::function<void(int)> & onComplete);
+	// see DirectUringRandomAccessFile::readAsyncCompleteNext
+	int readAsyncCompleteNext(const std::function<bool(int)> & isWaited);
+	~DirectAioRandomAccessFile();
+private:
+	// a read prepared by readAsync and not submitted yet
+	struct PendingRead {
+		int fd;
+		// shared with the read, so that the buffer outlives the reads in flight on the pread workers
+		std::shared_ptr<ByteBuffer> buffer;
+		uint64_t length;
+		uint64_t offset;
+		int index;
+	};
+	// the completions of the reads issued by the pread workers for a thread
+	struct Completions {
+		std::mutex lock;
+		std::condition_variable cv;
+		// the buffer index and the result of each completed read, a negative result is -errno
+		std::deque<std::pair<int, long>> done;
+	};
+	// @return the buffer index of the next completed read of this thread
+	static int waitCompletion();
+	static thread_local aio_context_t context;
+	static thread_local bool threadPoolFallback;
+	static thread_local bool isInitialized;
+	static thread_local std::vector<PendingRead> pendingReads;
+	static thread_local std::shared_ptr<Completions> completions;
+	// the buffer indexes of the completed requests that are not waited by readAsyncCompleteNext yet
+	static thread_local std::vector<int> completedBuffers;
+};
+
+#endif //PIXELS_DIRECTAIORANDOMACCESSFILE_H
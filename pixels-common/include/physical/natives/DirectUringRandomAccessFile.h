@@ -11,19 +11,86 @@
 #include "exception/InvalidArgumentException.h"
 #include "DirectIoLib.h"
 #include "physical/BufferPool.h"
+#include <functional>
+#include <map>
+
+/**
+ * The io_uring setup of the ring of each thread, see the localfs.iouring.* properties.
+ */
+struct UringOptions {
+	unsigned queueDepth = 4096;
+	// register the file descriptors, so that the kernel does not look up the file of each read
+	bool registerFiles = false;
+	// a kernel thread polls the submission queue, so that submitting the reads takes no system call
+	bool sqpoll = false;
+	// the milliseconds after which the idle SQPOLL thread sleeps
+	unsigned sqpollIdle = 2000;
+	// poll the completions instead of waiting for interrupts, only for O_DIRECT files
+	bool iopoll = false;
+	// issue the reads with IOSQE_ASYNC, i.e., to the io-wq workers without trying a non-blocking read first
+	bool asyncHint = false;
+	// @return the options in pixels-cxx.properties, they are parsed once
+	static const UringOptions & FromConfig();
+};
+
 class DirectUringRandomAccessFile: public DirectRandomAccessFile {
 public:
 	explicit DirectUringRandomAccessFile(const std::string& file);
 	static void RegisterBuffer(std::vector<std::shared_ptr<ByteBuffer>> buffers);
     static void RegisterBufferFromPool(std::vector<uint32_t> colIds);
+	// initialize the ring of this thread with the options in pixels-cxx.properties if it does not exist
 	static void Initialize();
+	// initialize the ring of this thread with the given options if it does not exist, e.g., for the benchmarks
+	static void Initialize(const UringOptions & uringOptions);
 	static void Reset();
+	/**
+	 * Release the registered buffers of the scan that ends in this thread. The ring and its buffer table
+	 * are kept for the next scan of the thread, which only updates the slots of the buffers that change.
+	 * @param buffersFreed whether the buffer pool freed some buffers, then the buffer table is unregistered,
+	 * since the kernel pins the registered buffers
+	 */
+	static void Release(bool buffersFreed);
 	std::shared_ptr<ByteBuffer> readAsync(int length, std::shared_ptr<ByteBuffer> buffer, int index);
 	void readAsyncSubmit(int size);
 	void readAsyncComplete(int size);
+	// onComplete is called with the buffer index of each request as soon as the request completes
+	void readAsyncComplete(int size, const std::function<void(int)> & onComplete);
+	/**
+	 * Wait for the next request of the caller to complete. The ring of the thread serves the requests of
+	 * the current and the next file, so the completions of the other requests are kept until they are waited.
+	 * @param isWaited whether a buffer index belongs to the requests of the caller
+	 * @return the buffer index of the completed request
+	 */
+	int readAsyncCompleteNext(const std::function<bool(int)> & isWaited);
+	void close() override;
 	~DirectUringRandomAccessFile();
 private:
+	static void UpdateBuffer(uint32_t bufferId, const std::shared_ptr<ByteBuffer> & buffer);
+	static void UnregisterBuffers();
+	// @return a free sqe, the queued sqes are submitted if the submission queue is full
+	static struct io_uring_sqe * GetSqe();
+	// mark the cqe as seen, and throw if its read failed or is shorter than requested
+	static int CompleteCqe(struct io_uring_cqe * cqe);
+	// @return the fd of the sqes that read this file, i.e., its index in the registered files if it is registered
+	int getSqeFd();
+	// @return the flags of the sqes that read this file, call it after getSqeFd
+	unsigned getSqeFlags() const;
+	void unregisterFile();
+	// the index of this file in the registered files of the ring with fixedFileRingId, or -1 if it is not registered
+	int fixedFileIndex = -1;
+	uint64_t fixedFileRingId = 0;
 	static thread_local struct io_uring * ring;
+	// the id of the ring, the rings of the threads and the rings initialized after a Reset have different ids
+	static thread_local uint64_t ringId;
+	static thread_local UringOptions options;
+	// the registered file table of the ring, -1 for the free slots
+	static thread_local std::vector<int> fixedFiles;
+	// the buffer indexes of the completed requests that are not waited by readAsyncCompleteNext yet
+	static thread_local std::vector<int> completedBuffers;
+	// the bytes that the request of each buffer index in flight must read
+	static thread_local std::map<int, uint64_t> requestedBytes;
+	// the sqes submitted by GetSqe since the last readAsyncSubmit
+	static thread_local int submittedSqes;
 	static thread_local bool isRegistered;
 	static thread_local struct iovec * iovecs;
 	static thread_local uint32_t iovecSize;
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PIXELS_RATELIMITEDSCHEDULER_H
+#define PIXELS_RATELIMITEDSCHEDULER_H
+
+#include "physical/Scheduler.h"
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * The scheduler that limits the bandwidth (read.request.ratelimit.mbps) and the number of requests
+ * (read.request.ratelimit.iops) issued to each storage device, so that a long running scan does not
+ * saturate the devices shared with the other queries. The device of a file is determined by
+ * storage.directory.depth, see StorageArrayScheduler::getDeviceName.
+ *
+ * Each device has a token bucket that is refilled at the configured rates, and a batch of requests
+ * takes the tokens of all its requests before it is issued by NoopScheduler. A batch is issued as long
+ * as the bucket is not in debt, so the batches larger than the bucket are not blocked forever, and the
+ * debt delays the following batches instead. The batches of the interactive queries are admitted before
+ * the batches of the batch queries waiting for the same device (see RequestPriority), and the requests
+ * are issued with the best-effort io priority 0 and 7 respectively, so that the kernel io scheduler of
+ * the device orders them in the same way.
+ */
+class RateLimitedScheduler : public Scheduler {
+public:
+    static Scheduler * Instance();
+    // @return the priority class named interactive or batch, case insensitive
+    static RequestPriority ParsePriority(const std::string & name);
+    std::vector<std::shared_ptr<ByteBuffer>> executeBatch(std::shared_ptr<PhysicalReader> reader, RequestBatch batch, long queryId) override;
+    std::vector<std::shared_ptr<ByteBuffer>> executeBatch(std::shared_ptr<PhysicalReader> reader, RequestBatch batch,
+                                                          std::vector<std::shared_ptr<ByteBuffer>> reuseBuffers, long queryId) override;
+    ~RateLimitedScheduler();
+private:
+    struct TokenBucket {
+        std::mutex lock;
+        std::condition_variable cv;
+        // the tokens in bytes and in requests, they are negative if the bucket is in debt
+        double bytes;
+        double requests;
+        std::chrono::steady_clock::time_point refillTime;
+        // the number of the interactive batches waiting for the tokens, the batches of the batch queries wait for them
+        int interactiveWaiters = 0;
+    };
+    RateLimitedScheduler();
+    TokenBucket & getBucket(const std::string & path);
+    void refill(TokenBucket & bucket);
+    // wait until the batch can be issued to the device of the bucket, and take its tokens
+    void acquire(TokenBucket & bucket, uint64_t bytes, uint64_t requests, RequestPriority priority);
+    // set the io priority of this thread, which issues the requests of the batch
+    static void setIoPriority(RequestPriority priority);
+
+    static Scheduler * instance;
+    // the io priority set by this thread, -1 if it is not set yet
+    static thread_local int ioPriority;
+    // the rates of each device, 0 means unlimited
+    double bytesPerSecond;
+    double requestsPerSecond;
+    // the tokens a device accumulates while it is idle, in seconds of its rates
+    double burstSeconds;
+    int storageDepth;
+    std::mutex bucketsLock;
+    std::unordered_map<std::string, std::unique_ptr<TokenBucket>> buckets;
+};
+#endif //PIXELS_RATELIMITEDSCHEDULER_H
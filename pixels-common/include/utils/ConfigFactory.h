@@ -19,6 +19,8 @@ public:
 	static ConfigFactory & Instance();
 	void Print();
 	std::string getProperty(std::string key);
+	// add or override a property, e.g., in the tests
+	void addProperty(std::string key, std::string value);
     bool boolCheckProperty(std::string key);
 	std::string getPixelsDirectory();
     std::string getPixelsSourceDirectory();
@@ -21,6 +21,8 @@ public:
     static int MIN_REPEAT;
     static int MAX_SCOPE;
     static int MAX_SHORT_REPEAT_LENGTH;
+    // the max absolute base value of PATCHED_BASE, so that base and its sign fit in 8 bytes
+    static long BASE_VALUE_LIMIT;
     static float DICT_KEY_SIZE_THRESHOLD;
     static int INIT_DICT_SIZE;
 
@@ -0,0 +1,34 @@
+//
+// A fixed-size pool of worker threads.
+//
+
+#ifndef DUCKDB_THREADPOOL_H
+#define DUCKDB_THREADPOOL_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+    // threadNum <= 0 means using all CPU cores
+    explicit ThreadPool(int threadNum);
+    ~ThreadPool();
+    // the exception thrown by the task is rethrown by the get() of the returned future
+    std::future<void> submit(std::function<void()> task);
+private:
+    void work();
+
+    std::vector<std::thread> workers;
+    std::queue<std::packaged_task<void()>> tasks;
+    std::mutex lock;
+    std::condition_variable cv;
+    bool stopped;
+};
+
+#endif // DUCKDB_THREADPOOL_H
@@ -3,66 +3,86 @@
 //
 
 #include "physical/BufferPool.h"
+#include <algorithm>
 
 thread_local int BufferPool::colCount = 0;
-thread_local std::map<uint32_t, uint64_t> BufferPool::nrBytes;
 thread_local bool BufferPool::isInitialized = false;
 thread_local std::map<uint32_t, std::shared_ptr<ByteBuffer>> BufferPool::buffers[2];
+thread_local std::map<uint32_t, std::shared_ptr<ByteBuffer>> BufferPool::decompressBuffers[2];
 // The currBufferIdx is set to 1. When executing the first file, this value is 0
 // since we call switch function first.
 thread_local int BufferPool::currBufferIdx = 1;
 thread_local int BufferPool::nextBufferIdx = 0;
-std::shared_ptr<DirectIoLib> BufferPool::directIoLib;
+thread_local std::multimap<uint64_t, BufferPool::IdleBuffer> BufferPool::idleBuffers;
+thread_local uint64_t BufferPool::idleBytes = 0;
+std::atomic<uint64_t> BufferPool::totalIdleBytes(0);
+thread_local std::shared_ptr<DirectIoLib> BufferPool::directIoLib;
 
 void BufferPool::Initialize(std::vector<uint32_t> colIds, std::vector<uint64_t> bytes, std::vector<std::string> columnNames) {
 	assert(colIds.size() == bytes.size());
-	int fsBlockSize = std::stoi(ConfigFactory::Instance().getProperty("localfs.block.size"));
-    std::string columnSizePath = ConfigFactory::Instance().getProperty("pixel.column.size.path");
-    std::shared_ptr<ColumnSizeCSVReader> csvReader;
-    if (!columnSizePath.empty()) {
-        csvReader = std::make_shared<ColumnSizeCSVReader>(columnSizePath);
-    }
-
-    // give the maximal column size, which is stored in csv reader
 	if(!BufferPool::isInitialized) {
+		int fsBlockSize = std::stoi(ConfigFactory::Instance().getProperty("localfs.block.size"));
+		std::string columnSizePath = ConfigFactory::Instance().getProperty("pixel.column.size.path");
+		std::shared_ptr<ColumnSizeCSVReader> csvReader;
+		if (!columnSizePath.empty()) {
+			// the optional column sizes avoid growing the buffers during the scan
+			csvReader = std::make_shared<ColumnSizeCSVReader>(columnSizePath);
+		}
         currBufferIdx = 0;
         nextBufferIdx = 1;
-		directIoLib = std::make_shared<DirectIoLib>(fsBlockSize);
+		if (directIoLib == nullptr) {
+			directIoLib = std::make_shared<DirectIoLib>(fsBlockSize);
+		}
 		for(int i = 0; i < colIds.size(); i++) {
 			uint32_t colId = colIds.at(i);
-            std::string columnName = columnNames[colId];
+			uint64_t byte = bytes.at(i);
+			if (csvReader != nullptr) {
+				byte = std::max(byte, (uint64_t) csvReader->get(columnNames[colId]));
+			}
             for(int idx = 0; idx < 2; idx++) {
-                std::shared_ptr<ByteBuffer> buffer;
-                if (columnSizePath.empty()) {
-                    buffer = BufferPool::directIoLib->allocateDirectBuffer(bytes.at(i) + EXTRA_POOL_SIZE);
-                } else {
-                    buffer = BufferPool::directIoLib->allocateDirectBuffer(csvReader->get(columnName));
-                }
-
-                BufferPool::nrBytes[colId] = buffer->size();
-                BufferPool::buffers[idx][colId] = buffer;
+                BufferPool::buffers[idx][colId] = AllocateBuffer(byte);
             }
 		}
 		BufferPool::colCount = colIds.size();
 		BufferPool::isInitialized = true;
 	} else {
-		// check if resize the buffer is needed
 		assert(colIds.size() == BufferPool::colCount);
 		for (int i = 0; i < colIds.size(); i++) {
 			uint32_t colId = colIds.at(i);
-			uint64_t byte = bytes.at(i);
-            std::string columnName = columnNames[colId];
-			if (BufferPool::nrBytes.find(colId) == BufferPool::nrBytes.end()) {
+			auto it = BufferPool::buffers[currBufferIdx].find(colId);
+			if (it == BufferPool::buffers[currBufferIdx].end()) {
 				throw InvalidArgumentException("BufferPool::Initialize: no such the column id.");
 			}
-			// Note: this code should never happen in the pixels scenario
-			if (BufferPool::nrBytes[colId] < byte) {
-				throw InvalidArgumentException("the new buffer byte cannot larger than the previous buffer byte. ");
+			// only the buffer of the current file is replaced, the other one may still be read into
+			if (it->second->size() < GetSizeClass(bytes.at(i))) {
+				it->second = AllocateBuffer(bytes.at(i));
 			}
 		}
 	}
 }
 
+uint64_t BufferPool::GetSizeClass(uint64_t bytes) {
+	uint64_t sizeClass = MIN_POOL_BUFFER_SIZE;
+	while (sizeClass < bytes) {
+		sizeClass <<= 1;
+	}
+	return sizeClass;
+}
+
+std::shared_ptr<ByteBuffer> BufferPool::AllocateBuffer(uint64_t bytes) {
+	uint64_t sizeClass = GetSizeClass(bytes);
+	// reuse an idle buffer of the same size class, a direct buffer is a little larger than its size class
+	auto it = BufferPool::idleBuffers.lower_bound(sizeClass);
+	if (it != BufferPool::idleBuffers.end() && it->first < 2 * sizeClass) {
+		auto buffer = it->second.buffer;
+		BufferPool::idleBytes -= it->first;
+		BufferPool::totalIdleBytes -= it->first;
+		BufferPool::idleBuffers.erase(it);
+		return buffer;
+	}
+	return BufferPool::directIoLib->allocateDirectBuffer(sizeClass);
+}
+
 int64_t BufferPool::GetBufferId(uint32_t index) {
     return index + currBufferIdx * colCount;
 }
@@ -71,15 +91,83 @@ std::shared_ptr<ByteBuffer> BufferPool::GetBuffer(uint32_t colId) {
 	return BufferPool::buffers[currBufferIdx][colId];
 }
 
+std::shared_ptr<ByteBuffer> BufferPool::GetDecompressBuffer(uint32_t colId, uint64_t size) {
+	auto & currBuffers = BufferPool::decompressBuffers[currBufferIdx];
+	auto it = currBuffers.find(colId);
+	if(it != currBuffers.end() && it->second->size() >= size) {
+		return it->second;
+	}
+	// the buffer is only grown, so that it is allocated once in most cases
+	auto buffer = AllocateBuffer(size);
+	currBuffers[colId] = buffer;
+	return buffer;
+}
+
 void BufferPool::Reset() {
 	BufferPool::isInitialized = false;
-	BufferPool::nrBytes.clear();
     for(int idx = 0; idx < 2; idx++) {
         BufferPool::buffers[idx].clear();
+        BufferPool::decompressBuffers[idx].clear();
     }
 	BufferPool::colCount = 0;
 }
 
+BufferPool::IdleBytesCloser::~IdleBytesCloser() {
+	BufferPool::totalIdleBytes -= BufferPool::idleBytes;
+	BufferPool::idleBytes = 0;
+}
+
+void BufferPool::ReleaseBuffer(const std::shared_ptr<ByteBuffer> & buffer, std::chrono::steady_clock::time_point now) {
+	static thread_local IdleBytesCloser idleBytesCloser;
+	BufferPool::idleBuffers.emplace(buffer->size(), IdleBuffer{buffer, now});
+	BufferPool::idleBytes += buffer->size();
+	BufferPool::totalIdleBytes += buffer->size();
+}
+
+bool BufferPool::Release() {
+	auto now = std::chrono::steady_clock::now();
+	for(int idx = 0; idx < 2; idx++) {
+		for (auto & entry : BufferPool::buffers[idx]) {
+			ReleaseBuffer(entry.second, now);
+		}
+		for (auto & entry : BufferPool::decompressBuffers[idx]) {
+			ReleaseBuffer(entry.second, now);
+		}
+	}
+	Reset();
+	return Trim();
+}
+
+bool BufferPool::Trim() {
+	auto now = std::chrono::steady_clock::now();
+	uint64_t maxIdleBytes = std::stoull(ConfigFactory::Instance().getProperty("buffer.pool.idle.bytes"));
+	std::chrono::seconds idleTimeout(std::stoll(ConfigFactory::Instance().getProperty("buffer.pool.idle.timeout")));
+	bool freed = false;
+	for (auto it = BufferPool::idleBuffers.begin(); it != BufferPool::idleBuffers.end();) {
+		if (now - it->second.since > idleTimeout) {
+			BufferPool::idleBytes -= it->first;
+			BufferPool::totalIdleBytes -= it->first;
+			it = BufferPool::idleBuffers.erase(it);
+			freed = true;
+		} else {
+			it++;
+		}
+	}
+	// free the largest buffers first, they are the least likely to be reused
+	while (!BufferPool::idleBuffers.empty() && BufferPool::totalIdleBytes > maxIdleBytes) {
+		auto it = std::prev(BufferPool::idleBuffers.end());
+		BufferPool::idleBytes -= it->first;
+		BufferPool::totalIdleBytes -= it->first;
+		BufferPool::idleBuffers.erase(it);
+		freed = true;
+	}
+	return freed;
+}
+
+uint64_t BufferPool::GetIdleBytes() {
+	return BufferPool::totalIdleBytes;
+}
+
 void BufferPool::Switch() {
     currBufferIdx = 1 - currBufferIdx;
     nextBufferIdx = 1 - nextBufferIdx;
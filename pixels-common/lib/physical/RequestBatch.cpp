@@ -10,11 +10,13 @@ RequestBatch::RequestBatch(int capacity) {
     }
     requests.reserve(capacity);
     size = 0;
+    priority = RequestPriority::INTERACTIVE;
 }
 
 RequestBatch::RequestBatch() {
     requests = std::vector<Request>();
     size = 0;
+    priority = RequestPriority::INTERACTIVE;
 }
 
 int RequestBatch::getSize() {
@@ -25,6 +27,14 @@ std::vector<Request> RequestBatch::getRequests() {
     return requests;
 }
 
+void RequestBatch::setPriority(RequestPriority priority) {
+    this->priority = priority;
+}
+
+RequestPriority RequestBatch::getPriority() const {
+    return priority;
+}
+
 //std::vector<std::future<ByteBuffer *>> * RequestBatch::getPromises() {}() {
 //    return &pro;
 //}
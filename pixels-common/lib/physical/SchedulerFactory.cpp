@@ -26,6 +26,8 @@ SchedulerFactory::SchedulerFactory() {
         scheduler = NoopScheduler::Instance();
     } else if(name == "sortmerge") {
         scheduler =  SortMergeScheduler::Instance();
+    } else if(name == "ratelimited") {
+        scheduler = RateLimitedScheduler::Instance();
     } else {
         throw std::runtime_error("the read request scheduler is not support. ");
     }
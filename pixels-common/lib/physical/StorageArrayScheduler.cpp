@@ -10,17 +10,7 @@ StorageArrayScheduler::StorageArrayScheduler(std::vector<std::string> &files, in
     filesVector.clear();
 
     for (auto& file: files) {
-        std::string deviceName;
-        std::string tmp = file.substr(1);
-        for(int i = 0; i < storageDepth; i++) {
-            if (tmp.find('/') != std::string::npos) {
-                auto loc = tmp.find('/');
-                deviceName += tmp.substr(0,loc);
-                tmp = tmp.substr(loc);
-            } else {
-                throw InvalidArgumentException("StorageArrayScheduler::initialize: wrong storage depth. ");
-            }
-        }
+        std::string deviceName = getDeviceName(file, storageDepth);
         // The following code makes sure that one thread can also process multiple devices
         if (!device2id.count(deviceName)) {
             device2id[deviceName] = (int)device2id.size() % threadNum;
@@ -33,18 +23,25 @@ StorageArrayScheduler::StorageArrayScheduler(std::vector<std::string> &files, in
     }
 
     devicesNum = (int)filesVector.size();
-    if (files.size() > threadNum && devicesNum % threadNum != 0 && threadNum % devicesNum != 0) {
-        throw InvalidArgumentException("StorageArrayScheduler::initialize: "
-                                       "if multiple devices are used, make sure "
-                                       "the thread count is divisible by device num or"
-                                       "the device num is divisible by the thread count. "
-                                       "Now the thread count is " + std::to_string(threadNum) +
-                                       " , and the storage device num is " + std::to_string(devicesNum) +
-                                       ". Otherwise the load balancing issue occurs. ");
-    }
+    scanUnitQueues.resize(devicesNum);
     currentDeviceID = 0;
 }
 
+std::string StorageArrayScheduler::getDeviceName(const std::string &file, int storageDepth) {
+    std::string deviceName;
+    std::string tmp = file.substr(1);
+    for(int i = 0; i < storageDepth; i++) {
+        if (tmp.find('/') != std::string::npos) {
+            auto loc = tmp.find('/');
+            deviceName += tmp.substr(0,loc);
+            tmp = tmp.substr(loc);
+        } else {
+            throw InvalidArgumentException("StorageArrayScheduler::initialize: wrong storage depth. ");
+        }
+    }
+    return deviceName;
+}
+
 int StorageArrayScheduler::acquireDeviceId() {
     m.lock();
     int deviceId = currentDeviceID;
@@ -56,28 +53,63 @@ int StorageArrayScheduler::acquireDeviceId() {
 int StorageArrayScheduler::getDeviceSum() {
     return devicesNum;
 }
-uint64_t StorageArrayScheduler::getFileSum(int deviceID) {
-    return filesVector[deviceID].size();
-}
 
-std::string StorageArrayScheduler::getFileName(int deviceID, int fileID) {
-    return filesVector.at(deviceID).at(fileID);
+void StorageArrayScheduler::initScanUnits(const std::unordered_map<std::string, int>& rowGroupNums,
+                                          int rowGroupsPerUnit) {
+    std::lock_guard<std::mutex> lock(m);
+    totalRowGroups = 0;
+    acquiredRowGroups = 0;
+    for (int deviceID = 0; deviceID < devicesNum; deviceID++) {
+        auto &queue = scanUnitQueues.at(deviceID);
+        queue.clear();
+        for (auto &file: filesVector.at(deviceID)) {
+            auto it = rowGroupNums.find(file);
+            if (it == rowGroupNums.end()) {
+                throw InvalidArgumentException("StorageArrayScheduler::initScanUnits: "
+                                               "no row group number for file " + file);
+            }
+            int rgNum = it->second;
+            int step = rowGroupsPerUnit > 0 ? rowGroupsPerUnit : std::max(rgNum, 1);
+            for (int rgStart = 0; rgStart < rgNum; rgStart += step) {
+                queue.push_back(ScanUnit{file, rgStart, std::min(step, rgNum - rgStart)});
+            }
+            totalRowGroups += rgNum;
+        }
+    }
 }
 
-int StorageArrayScheduler::getMaxFileSum() {
-    int result = 0;
-    for (auto &files: filesVector) {
-        result = std::max(result, (int)files.size());
+bool StorageArrayScheduler::acquireScanUnit(int deviceID, ScanUnit& unit) {
+    std::lock_guard<std::mutex> lock(m);
+    auto &localQueue = scanUnitQueues.at(deviceID);
+    if (!localQueue.empty()) {
+        unit = localQueue.front();
+        localQueue.pop_front();
+        acquiredRowGroups += unit.rgLen;
+        return true;
     }
-    return result;
+    // the local device is drained, steal from the device with the most remaining units.
+    // The units are taken from the tail so that the owner threads keep reading sequentially.
+    int victim = -1;
+    uint64_t maxRemaining = 0;
+    for (int i = 0; i < devicesNum; i++) {
+        if (scanUnitQueues[i].size() > maxRemaining) {
+            maxRemaining = scanUnitQueues[i].size();
+            victim = i;
+        }
+    }
+    if (victim < 0) {
+        return false;
+    }
+    unit = scanUnitQueues[victim].back();
+    scanUnitQueues[victim].pop_back();
+    acquiredRowGroups += unit.rgLen;
+    return true;
 }
 
-int StorageArrayScheduler::getBatchID(int deviceID, int fileID) {
-    int result = 0;
-    for(int i = 0; i < deviceID; i++) {
-        result += (int)filesVector[i].size();
+double StorageArrayScheduler::getProgress() {
+    std::lock_guard<std::mutex> lock(m);
+    if (totalRowGroups == 0) {
+        return 1.0;
     }
-    result += fileID;
-    return result;
+    return (double) acquiredRowGroups / totalRowGroups;
 }
-
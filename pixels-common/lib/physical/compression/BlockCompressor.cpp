@@ -0,0 +1,131 @@
+//
+// Block compression of column chunks.
+//
+
+#include "physical/compression/BlockCompressor.h"
+#include "exception/InvalidArgumentException.h"
+#include <algorithm>
+#include <cstring>
+#include <lz4.h>
+#include <zstd.h>
+
+namespace {
+
+// compress one block into output, return the compressed length or 0 if it can not fit
+uint64_t compressBlock(pixels::proto::CompressionKind kind, const uint8_t * data, uint64_t length,
+                       uint8_t * output, uint64_t capacity) {
+    switch(kind) {
+        case pixels::proto::CompressionKind::LZ4: {
+            int res = LZ4_compress_default((const char *) data, (char *) output, (int) length, (int) capacity);
+            return res > 0 ? (uint64_t) res : 0;
+        }
+        case pixels::proto::CompressionKind::ZSTD: {
+            size_t res = ZSTD_compress(output, capacity, data, length, ZSTD_CLEVEL_DEFAULT);
+            return ZSTD_isError(res) ? 0 : res;
+        }
+        default:
+            throw InvalidArgumentException("BlockCompressor: unsupported compression kind " +
+                                           pixels::proto::CompressionKind_Name(kind));
+    }
+}
+
+void readHeader(const uint8_t * data, uint32_t & storedLength, uint32_t & originalLength) {
+    std::memcpy(&storedLength, data, sizeof(uint32_t));
+    std::memcpy(&originalLength, data + sizeof(uint32_t), sizeof(uint32_t));
+}
+
+}
+
+std::vector<uint8_t> BlockCompressor::compress(pixels::proto::CompressionKind kind, const uint8_t * data,
+                                               uint64_t length, uint32_t blockSize) {
+    if(blockSize == 0) {
+        throw InvalidArgumentException("BlockCompressor::compress: the compression block size must be positive.");
+    }
+    std::vector<uint8_t> result;
+    result.reserve(length + (length / blockSize + 1) * BLOCK_HEADER_SIZE);
+    for(uint64_t offset = 0; offset < length; offset += blockSize) {
+        uint32_t originalLength = (uint32_t) std::min<uint64_t>(blockSize, length - offset);
+        uint64_t headerPos = result.size();
+        // the block is stored as is unless the compressed block is smaller
+        result.resize(headerPos + BLOCK_HEADER_SIZE + originalLength);
+        uint8_t * block = result.data() + headerPos + BLOCK_HEADER_SIZE;
+        uint64_t storedLength = compressBlock(kind, data + offset, originalLength, block, originalLength - 1);
+        if(storedLength == 0 || storedLength >= originalLength) {
+            std::memcpy(block, data + offset, originalLength);
+            storedLength = originalLength;
+        }
+        result.resize(headerPos + BLOCK_HEADER_SIZE + storedLength);
+        uint32_t stored = (uint32_t) storedLength;
+        std::memcpy(result.data() + headerPos, &stored, sizeof(uint32_t));
+        std::memcpy(result.data() + headerPos + sizeof(uint32_t), &originalLength, sizeof(uint32_t));
+    }
+    return result;
+}
+
+uint64_t BlockCompressor::getDecompressedLength(const uint8_t * data, uint64_t length) {
+    uint64_t decompressedLength = 0;
+    uint64_t offset = 0;
+    while(offset < length) {
+        if(offset + BLOCK_HEADER_SIZE > length) {
+            throw InvalidArgumentException("BlockCompressor: the compressed chunk is truncated.");
+        }
+        uint32_t storedLength, originalLength;
+        readHeader(data + offset, storedLength, originalLength);
+        decompressedLength += originalLength;
+        offset += BLOCK_HEADER_SIZE + storedLength;
+    }
+    return decompressedLength;
+}
+
+void BlockCompressor::decompress(pixels::proto::CompressionKind kind, const uint8_t * data, uint64_t length,
+                                 uint8_t * output, uint64_t outputLength) {
+    uint64_t offset = 0;
+    uint64_t outputOffset = 0;
+    while(offset < length) {
+        if(offset + BLOCK_HEADER_SIZE > length) {
+            throw InvalidArgumentException("BlockCompressor: the compressed chunk is truncated.");
+        }
+        uint32_t storedLength, originalLength;
+        readHeader(data + offset, storedLength, originalLength);
+        const uint8_t * block = data + offset + BLOCK_HEADER_SIZE;
+        if(offset + BLOCK_HEADER_SIZE + storedLength > length || outputOffset + originalLength > outputLength) {
+            throw InvalidArgumentException("BlockCompressor: the compressed chunk is corrupted.");
+        }
+        if(storedLength == originalLength) {
+            std::memcpy(output + outputOffset, block, originalLength);
+        } else if(kind == pixels::proto::CompressionKind::LZ4) {
+            int res = LZ4_decompress_safe((const char *) block, (char *) output + outputOffset,
+                                          (int) storedLength, (int) originalLength);
+            if(res != (int) originalLength) {
+                throw InvalidArgumentException("BlockCompressor: failed to decompress a LZ4 block.");
+            }
+        } else if(kind == pixels::proto::CompressionKind::ZSTD) {
+            size_t res = ZSTD_decompress(output + outputOffset, originalLength, block, storedLength);
+            if(ZSTD_isError(res) || res != originalLength) {
+                throw InvalidArgumentException("BlockCompressor: failed to decompress a ZSTD block.");
+            }
+        } else {
+            throw InvalidArgumentException("BlockCompressor: unsupported compression kind " +
+                                           pixels::proto::CompressionKind_Name(kind));
+        }
+        offset += BLOCK_HEADER_SIZE + storedLength;
+        outputOffset += originalLength;
+    }
+    if(outputOffset != outputLength) {
+        throw InvalidArgumentException("BlockCompressor: the compressed chunk is corrupted.");
+    }
+}
+
+pixels::proto::CompressionKind BlockCompressor::parseKind(const std::string & name) {
+    std::string upper = name;
+    std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+    pixels::proto::CompressionKind kind;
+    if(!pixels::proto::CompressionKind_Parse(upper, &kind)) {
+        throw InvalidArgumentException("BlockCompressor: unknown compression kind " + name);
+    }
+    if(kind != pixels::proto::CompressionKind::NONE && kind != pixels::proto::CompressionKind::LZ4 &&
+       kind != pixels::proto::CompressionKind::ZSTD) {
+        throw InvalidArgumentException("BlockCompressor: unsupported compression kind " + name);
+    }
+    return kind;
+}
@@ -5,7 +5,20 @@
 #include "physical/io/PhysicalLocalReader.h"
 
 #include <utility>
+#include <sys/stat.h>
 #include "profiler/TimeProfiler.h"
+#include "physical/natives/DirectAioRandomAccessFile.h"
+
+namespace {
+
+// the aio and pread libs are both served by DirectAioRandomAccessFile
+bool isAioLib() {
+	std::string lib = ConfigFactory::Instance().getProperty("localfs.async.lib");
+	return lib == "aio" || lib == "pread";
+}
+
+}
+
 PhysicalLocalReader::PhysicalLocalReader(std::shared_ptr<Storage> storage, std::string path_) {
     // TODO: should support async
     if(std::dynamic_pointer_cast<LocalFS>(storage).get() != nullptr) {
@@ -20,6 +33,7 @@ PhysicalLocalReader::PhysicalLocalReader(std::shared_ptr<Storage> storage, std::
     path = std::move(path_);
     raf = local->openRaf(path);
     // TODO: get fileid.
+    lastModified = -1;
     numRequests = 1;
 	asyncNumRequests = 0;
 }
@@ -68,13 +82,29 @@ std::string PhysicalLocalReader::getName() {
     return path.substr(path.find_last_of('/') + 1);
 }
 
+std::string PhysicalLocalReader::getPath() {
+    return path;
+}
+
+long PhysicalLocalReader::getLastModified() {
+    if(lastModified < 0) {
+        struct stat st;
+        if(stat(path.c_str(), &st) != 0) {
+            throw std::runtime_error("PhysicalLocalReader::getLastModified: failed to stat " + path);
+        }
+        lastModified = st.st_mtim.tv_sec * 1000000000L + st.st_mtim.tv_nsec;
+    }
+    return lastModified;
+}
+
 std::shared_ptr<ByteBuffer> PhysicalLocalReader::readAsync(int length, std::shared_ptr<ByteBuffer> buffer, int index) {
 	numRequests++;
 	if(ConfigFactory::Instance().getProperty("localfs.async.lib") == "iouring") {
 		auto directRaf = std::static_pointer_cast<DirectUringRandomAccessFile>(raf);
 		return directRaf->readAsync(length, std::move(buffer), index);
-	} else if(ConfigFactory::Instance().getProperty("localfs.async.lib") == "aio") {
-		throw InvalidArgumentException("PhysicalLocalReader::readAsync: We don't support aio for our async read yet.");
+	} else if(isAioLib()) {
+		auto aioRaf = std::static_pointer_cast<DirectAioRandomAccessFile>(raf);
+		return aioRaf->readAsync(length, std::move(buffer), index);
 	} else {
 		throw InvalidArgumentException("PhysicalLocalReader::readAsync: the async read method is unknown. ");
 	}
@@ -86,20 +116,39 @@ void PhysicalLocalReader::readAsyncSubmit(uint32_t size) {
 	if(ConfigFactory::Instance().getProperty("localfs.async.lib") == "iouring") {
 		auto directRaf = std::static_pointer_cast<DirectUringRandomAccessFile>(raf);
 		directRaf->readAsyncSubmit(size);
-	} else if(ConfigFactory::Instance().getProperty("localfs.async.lib") == "aio") {
-		throw InvalidArgumentException("PhysicalLocalReader::readAsync: We don't support aio for our async read yet.");
+	} else if(isAioLib()) {
+		auto aioRaf = std::static_pointer_cast<DirectAioRandomAccessFile>(raf);
+		aioRaf->readAsyncSubmit(size);
 	} else {
 		throw InvalidArgumentException("PhysicalLocalReader::readAsync: the async read method is unknown. ");
 	}
 }
 
 void PhysicalLocalReader::readAsyncComplete(uint32_t size) {
+	readAsyncComplete(size, [](int index) {});
+}
+
+void PhysicalLocalReader::readAsyncComplete(uint32_t size, const std::function<void(int)> & onComplete) {
 	numRequests++;
 	if(ConfigFactory::Instance().getProperty("localfs.async.lib") == "iouring") {
 		auto directRaf = std::static_pointer_cast<DirectUringRandomAccessFile>(raf);
-		directRaf->readAsyncComplete(size);
-	} else if(ConfigFactory::Instance().getProperty("localfs.async.lib") == "aio") {
-		throw InvalidArgumentException("PhysicalLocalReader::readAsync: We don't support aio for our async read yet.");
+		directRaf->readAsyncComplete(size, onComplete);
+	} else if(isAioLib()) {
+		auto aioRaf = std::static_pointer_cast<DirectAioRandomAccessFile>(raf);
+		aioRaf->readAsyncComplete(size, onComplete);
+	} else {
+		throw InvalidArgumentException("PhysicalLocalReader::readAsync: the async read method is unknown. ");
+	}
+}
+
+int PhysicalLocalReader::readAsyncCompleteNext(const std::function<bool(int)> & isWaited) {
+	numRequests++;
+	if(ConfigFactory::Instance().getProperty("localfs.async.lib") == "iouring") {
+		auto directRaf = std::static_pointer_cast<DirectUringRandomAccessFile>(raf);
+		return directRaf->readAsyncCompleteNext(isWaited);
+	} else if(isAioLib()) {
+		auto aioRaf = std::static_pointer_cast<DirectAioRandomAccessFile>(raf);
+		return aioRaf->readAsyncCompleteNext(isWaited);
 	} else {
 		throw InvalidArgumentException("PhysicalLocalReader::readAsync: the async read method is unknown. ");
 	}
@@ -113,8 +162,12 @@ void PhysicalLocalReader::readAsyncSubmitAndComplete(uint32_t size){
 		::TimeProfiler::Instance().Start("async wait");
 		directRaf->readAsyncComplete(size);
 		::TimeProfiler::Instance().End("async wait");
-	} else if(ConfigFactory::Instance().getProperty("localfs.async.lib") == "aio") {
-		throw InvalidArgumentException("PhysicalLocalReader::readAsync: We don't support aio for our async read yet.");
+	} else if(isAioLib()) {
+		auto aioRaf = std::static_pointer_cast<DirectAioRandomAccessFile>(raf);
+		aioRaf->readAsyncSubmit(size);
+		::TimeProfiler::Instance().Start("async wait");
+		aioRaf->readAsyncComplete(size);
+		::TimeProfiler::Instance().End("async wait");
 	} else {
 		throw InvalidArgumentException("PhysicalLocalReader::readAsync: the async read method is unknown. ");
 	}
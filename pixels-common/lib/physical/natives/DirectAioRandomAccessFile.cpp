@@ -0,0 +1,263 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "physical/natives/DirectAioRandomAccessFile.h"
+#include "utils/ConfigFactory.h"
+#include "utils/ThreadPool.h"
+#include <sys/syscall.h>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+namespace {
+
+// the native AIO system calls, glibc has no wrappers for them and libaio is not required
+long ioSetup(unsigned events, aio_context_t * context) {
+	return syscall(__NR_io_setup, events, context);
+}
+
+long ioDestroy(aio_context_t context) {
+	return syscall(__NR_io_destroy, context);
+}
+
+long ioSubmit(aio_context_t context, long size, struct iocb ** iocbs) {
+	return syscall(__NR_io_submit, context, size, iocbs);
+}
+
+long ioGetEvents(aio_context_t context, long minEvents, long maxEvents, struct io_event * events) {
+	return syscall(__NR_io_getevents, context, minEvents, maxEvents, events, nullptr);
+}
+
+// the pread workers are shared by all the scan threads
+ThreadPool & PreadPool() {
+	static ThreadPool pool(std::stoi(ConfigFactory::Instance().getProperty("localfs.pread.threads")));
+	return pool;
+}
+
+// @return the number of bytes read, which is less than length only at the end of the file, or -errno
+long preadFully(int fd, uint8_t * buffer, uint64_t length, uint64_t offset) {
+	uint64_t done = 0;
+	while(done < length) {
+		ssize_t ret = pread(fd, buffer + done, length - done, offset + done);
+		if(ret < 0) {
+			if(errno == EINTR) {
+				continue;
+			}
+			return -errno;
+		}
+		if(ret == 0) {
+			break;
+		}
+		done += ret;
+	}
+	return (long) done;
+}
+
+// destroys the AIO context of a worker thread when the thread exits
+struct AioContextCloser {
+	~AioContextCloser() {
+		DirectAioRandomAccessFile::Reset();
+	}
+};
+
+}
+
+thread_local aio_context_t DirectAioRandomAccessFile::context = 0;
+thread_local bool DirectAioRandomAccessFile::threadPoolFallback = false;
+thread_local bool DirectAioRandomAccessFile::isInitialized = false;
+thread_local std::vector<DirectAioRandomAccessFile::PendingRead> DirectAioRandomAccessFile::pendingReads;
+thread_local std::shared_ptr<DirectAioRandomAccessFile::Completions> DirectAioRandomAccessFile::completions;
+thread_local std::vector<int> DirectAioRandomAccessFile::completedBuffers;
+
+DirectAioRandomAccessFile::DirectAioRandomAccessFile(const std::string &file) : DirectRandomAccessFile(file) {
+
+}
+
+void DirectAioRandomAccessFile::Initialize() {
+	// the context is set up once for each thread, and kept across the scans
+	if(isInitialized) {
+		return;
+	}
+	threadPoolFallback = ConfigFactory::Instance().getProperty("localfs.async.lib") == "pread";
+	if(!threadPoolFallback) {
+		context = 0;
+		unsigned queueDepth = std::stoul(ConfigFactory::Instance().getProperty("localfs.aio.queue.depth"));
+		// ENOSYS if the kernel has no AIO, EPERM if seccomp blocks it, EAGAIN beyond fs.aio-max-nr
+		if(ioSetup(queueDepth, &context) != 0) {
+			context = 0;
+			threadPoolFallback = true;
+		}
+	}
+	completions = std::make_shared<Completions>();
+	isInitialized = true;
+	static thread_local AioContextCloser contextCloser;
+}
+
+void DirectAioRandomAccessFile::Reset() {
+	if(context != 0) {
+		// the reads in flight are cancelled or waited by io_destroy
+		ioDestroy(context);
+		context = 0;
+	}
+	// the reads in flight on the pread workers keep their buffers and completions alive
+	completions = nullptr;
+	pendingReads.clear();
+	completedBuffers.clear();
+	threadPoolFallback = false;
+	isInitialized = false;
+}
+
+void DirectAioRandomAccessFile::Release() {
+	completedBuffers.clear();
+}
+
+bool DirectAioRandomAccessFile::IsThreadPoolFallback() {
+	return threadPoolFallback;
+}
+
+std::shared_ptr<ByteBuffer> DirectAioRandomAccessFile::readAsync(int length, std::shared_ptr<ByteBuffer> buffer, int index) {
+	if(enableDirect) {
+		// the file will be read from blockStart(fileOffset), and the first fileDelta bytes should be ignored.
+		uint64_t fileOffsetAligned = directIoLib->blockStart(offset);
+		uint64_t toRead = directIoLib->blockEnd(offset + length) - directIoLib->blockStart(offset);
+		pendingReads.push_back(PendingRead{fd, buffer, toRead, fileOffsetAligned, index});
+		auto bb = std::make_shared<ByteBuffer>(*buffer,
+		                                       offset - fileOffsetAligned, length);
+		seek(offset + length);
+		return bb;
+	} else {
+		pendingReads.push_back(PendingRead{fd, buffer, (uint64_t) length, (uint64_t) offset, index});
+		seek(offset + length);
+		auto result = std::make_shared<ByteBuffer>(*buffer, 0, length);
+		return result;
+	}
+}
+
+void DirectAioRandomAccessFile::readAsyncSubmit(int size) {
+	if(!isInitialized || pendingReads.size() != size) {
+		throw InvalidArgumentException("DirectAioRandomAccessFile::readAsyncSubmit: submit fails");
+	}
+	if(threadPoolFallback) {
+		for(const PendingRead & read : pendingReads) {
+			std::shared_ptr<Completions> queue = completions;
+			PreadPool().submit([read, queue]() {
+				long result = preadFully(read.fd, read.buffer->getPointer(), read.length, read.offset);
+				{
+					std::lock_guard<std::mutex> lock(queue->lock);
+					queue->done.emplace_back(read.index, result);
+				}
+				queue->cv.notify_one();
+			});
+		}
+	} else {
+		std::vector<struct iocb> iocbs(size);
+		std::vector<struct iocb *> iocbPointers(size);
+		for(int i = 0; i < size; i++) {
+			const PendingRead & read = pendingReads.at(i);
+			memset(&iocbs[i], 0, sizeof(struct iocb));
+			iocbs[i].aio_data = (uint64_t) read.index;
+			iocbs[i].aio_lio_opcode = IOCB_CMD_PREAD;
+			iocbs[i].aio_fildes = read.fd;
+			iocbs[i].aio_buf = (uint64_t) (uintptr_t) read.buffer->getPointer();
+			iocbs[i].aio_nbytes = read.length;
+			iocbs[i].aio_offset = (int64_t) read.offset;
+			iocbPointers[i] = &iocbs[i];
+		}
+		// io_submit may accept a part of the reads if the context is almost full
+		int submitted = 0;
+		while(submitted < size) {
+			long ret = ioSubmit(context, size - submitted, iocbPointers.data() + submitted);
+			if(ret < 0 && errno == EINTR) {
+				continue;
+			}
+			if(ret <= 0) {
+				throw InvalidArgumentException("DirectAioRandomAccessFile::readAsyncSubmit: submit fails");
+			}
+			submitted += (int) ret;
+		}
+	}
+	pendingReads.clear();
+}
+
+int DirectAioRandomAccessFile::waitCompletion() {
+	int index;
+	long result;
+	if(threadPoolFallback) {
+		std::unique_lock<std::mutex> lock(completions->lock);
+		completions->cv.wait(lock, [] { return !completions->done.empty(); });
+		index = completions->done.front().first;
+		result = completions->done.front().second;
+		completions->done.pop_front();
+	} else {
+		struct io_event event;
+		long ret;
+		do {
+			ret = ioGetEvents(context, 1, 1, &event);
+		} while(ret < 0 && errno == EINTR);
+		if(ret != 1) {
+			throw InvalidArgumentException("DirectAioRandomAccessFile::waitCompletion: get events fails");
+		}
+		index = (int) event.data;
+		result = (long) event.res;
+	}
+	if(result < 0) {
+		throw InvalidArgumentException("DirectAioRandomAccessFile::waitCompletion: read fails: "
+		                               + std::string(strerror((int) -result)));
+	}
+	return index;
+}
+
+void DirectAioRandomAccessFile::readAsyncComplete(int size) {
+	readAsyncComplete(size, [](int index) {});
+}
+
+void DirectAioRandomAccessFile::readAsyncComplete(int size, const std::function<void(int)> & onComplete) {
+	for(int i = 0; i < size; i++) {
+		int index;
+		if(!completedBuffers.empty()) {
+			index = completedBuffers.front();
+			completedBuffers.erase(completedBuffers.begin());
+		} else {
+			index = waitCompletion();
+		}
+		onComplete(index);
+	}
+}
+
+int DirectAioRandomAccessFile::readAsyncCompleteNext(const std::function<bool(int)> & isWaited) {
+	for(auto it = completedBuffers.begin(); it != completedBuffers.end(); it++) {
+		if(isWaited(*it)) {
+			int index = *it;
+			completedBuffers.erase(it);
+			return index;
+		}
+	}
+	while(true) {
+		int index = waitCompletion();
+		if(isWaited(index)) {
+			return index;
+		}
+		completedBuffers.emplace_back(index);
+	}
+}
+
+DirectAioRandomAccessFile::~DirectAioRandomAccessFile() {
+
+}
@@ -2,51 +2,100 @@
 // Created by liyu on 5/28/23.
 //
 #include "physical/natives/DirectUringRandomAccessFile.h"
+#include "utils/ConfigFactory.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace {
+
+// the number of slots in the registered file table of a ring, the files opened after the table is full are not registered
+const unsigned FIXED_FILE_NUM = 64;
+
+std::atomic<uint64_t> nextRingId(1);
+
+}
 
 thread_local struct io_uring * DirectUringRandomAccessFile::ring = nullptr;
+thread_local uint64_t DirectUringRandomAccessFile::ringId = 0;
+thread_local UringOptions DirectUringRandomAccessFile::options;
+thread_local std::vector<int> DirectUringRandomAccessFile::fixedFiles;
+thread_local std::vector<int> DirectUringRandomAccessFile::completedBuffers;
+thread_local std::map<int, uint64_t> DirectUringRandomAccessFile::requestedBytes;
+thread_local int DirectUringRandomAccessFile::submittedSqes = 0;
 thread_local bool DirectUringRandomAccessFile::isRegistered = false;
 thread_local struct iovec * DirectUringRandomAccessFile::iovecs = nullptr;
 thread_local uint32_t DirectUringRandomAccessFile::iovecSize = 0;
 
+const UringOptions & UringOptions::FromConfig() {
+    static UringOptions configOptions = []() {
+        ConfigFactory & config = ConfigFactory::Instance();
+        UringOptions uringOptions;
+        uringOptions.queueDepth = std::stoul(config.getProperty("localfs.iouring.queue.depth"));
+        uringOptions.registerFiles = config.boolCheckProperty("localfs.iouring.register.files");
+        uringOptions.sqpoll = config.boolCheckProperty("localfs.iouring.sqpoll");
+        uringOptions.sqpollIdle = std::stoul(config.getProperty("localfs.iouring.sqpoll.idle"));
+        uringOptions.iopoll = config.boolCheckProperty("localfs.iouring.iopoll");
+        uringOptions.asyncHint = config.boolCheckProperty("localfs.iouring.async.hint");
+        return uringOptions;
+    }();
+    return configOptions;
+}
+
 DirectUringRandomAccessFile::DirectUringRandomAccessFile(const std::string &file) : DirectRandomAccessFile(file) {
 
 }
 
 void DirectUringRandomAccessFile::RegisterBufferFromPool(std::vector<uint32_t> colIds) {
-    std::vector<std::shared_ptr<ByteBuffer>> tmpBuffers;
     if(!isRegistered) {
+        // the buffer id of the i-th column in the idx-th buffers is i + idx * colIds.size(), see BufferPool::GetBufferId
+        std::vector<std::shared_ptr<ByteBuffer>> tmpBuffers;
         for(auto buffer : ::BufferPool::buffers) {
             for(auto colId : colIds) {
                 tmpBuffers.emplace_back(buffer[colId]);
             }
         }
-        iovecs = (iovec *)calloc(tmpBuffers.size() ,sizeof(struct iovec));
-        iovecSize = tmpBuffers.size();
-        for(auto i = 0; i < tmpBuffers.size(); i++) {
-            auto buffer = tmpBuffers.at(i);
-            iovecs[i].iov_base = buffer->getPointer();
-            iovecs[i].iov_len = buffer->size();
-            memset(iovecs[i].iov_base, 0, buffer->size());
-        }
-        int ret = io_uring_register_buffers(ring, iovecs, iovecSize);
-        if(ret != 0) {
-            throw InvalidArgumentException("DirectUringRandomAccessFile::RegisterBuffer: register buffer fails. ");
+        if(iovecs != nullptr && iovecSize >= tmpBuffers.size()) {
+            // the buffer table of the previous scan in this thread is large enough, and most of the
+            // buffers are reused from the buffer pool, so only the changed slots are updated
+            for(uint32_t i = 0; i < tmpBuffers.size(); i++) {
+                UpdateBuffer(i, tmpBuffers.at(i));
+            }
+        } else {
+            RegisterBuffer(tmpBuffers);
         }
         isRegistered = true;
+    } else {
+        // the buffer pool replaces the buffers of the current file that are too small, update their registration
+        int idx = ::BufferPool::currBufferIdx;
+        for(int i = 0; i < colIds.size(); i++) {
+            UpdateBuffer(i + idx * colIds.size(), ::BufferPool::buffers[idx][colIds.at(i)]);
+        }
     }
 }
 
-
+void DirectUringRandomAccessFile::UpdateBuffer(uint32_t bufferId, const std::shared_ptr<ByteBuffer> & buffer) {
+    if(iovecs[bufferId].iov_base == buffer->getPointer() && iovecs[bufferId].iov_len == buffer->size()) {
+        return;
+    }
+    iovecs[bufferId].iov_base = buffer->getPointer();
+    iovecs[bufferId].iov_len = buffer->size();
+    int ret = io_uring_register_buffers_update_tag(ring, bufferId, &iovecs[bufferId], nullptr, 1);
+    if(ret != 1) {
+        throw InvalidArgumentException("DirectUringRandomAccessFile::UpdateBuffer: update buffer fails. ");
+    }
+}
 
 void DirectUringRandomAccessFile::RegisterBuffer(std::vector<std::shared_ptr<ByteBuffer>> buffers) {
 	if(!isRegistered) {
+		// a ring has one buffer table, drop the one left by the previous scan
+		UnregisterBuffers();
 		iovecs = (iovec *)calloc(buffers.size() ,sizeof(struct iovec));
 		iovecSize = buffers.size();
 		for(auto i = 0; i < buffers.size(); i++) {
 			auto buffer = buffers.at(i);
 			iovecs[i].iov_base = buffer->getPointer();
 			iovecs[i].iov_len = buffer->size();
-			memset(iovecs[i].iov_base, 0, buffer->size());
 		}
 		int ret = io_uring_register_buffers(ring, iovecs, iovecSize);
 		if(ret != 0) {
@@ -56,13 +105,65 @@ void DirectUringRandomAccessFile::RegisterBuffer(std::vector<std::shared_ptr<Byt
 	}
 }
 
+void DirectUringRandomAccessFile::UnregisterBuffers() {
+    if(iovecs == nullptr) {
+        return;
+    }
+    if(io_uring_unregister_buffers(ring) != 0) {
+        throw InvalidArgumentException("DirectUringRandomAccessFile::UnregisterBuffers: unregister buffer fails. ");
+    }
+    free(iovecs);
+    iovecs = nullptr;
+    iovecSize = 0;
+}
+
+namespace {
+
+// closes the ring of a worker thread when the thread exits
+struct RingCloser {
+    ~RingCloser() {
+        DirectUringRandomAccessFile::Reset();
+    }
+};
+
+}
+
 void DirectUringRandomAccessFile::Initialize() {
-	// initialize io_uring ring
+	Initialize(UringOptions::FromConfig());
+}
+
+void DirectUringRandomAccessFile::Initialize(const UringOptions & uringOptions) {
+	// the ring is initialized once for each thread, and kept across the scans
 	if(ring == nullptr) {
+		struct io_uring_params params;
+		memset(&params, 0, sizeof(params));
+		if(uringOptions.sqpoll) {
+			params.flags |= IORING_SETUP_SQPOLL;
+			params.sq_thread_idle = uringOptions.sqpollIdle;
+		}
+		if(uringOptions.iopoll) {
+			// the reads of a polled ring fail with EOPNOTSUPP if they are not O_DIRECT
+			if(!ConfigFactory::Instance().boolCheckProperty("localfs.enable.direct.io")) {
+				throw InvalidArgumentException("DirectUringRandomAccessFile: localfs.iouring.iopoll requires localfs.enable.direct.io.");
+			}
+			params.flags |= IORING_SETUP_IOPOLL;
+		}
 		ring = new io_uring();
-		if(io_uring_queue_init(4096, ring, 0) < 0) {
+		if(io_uring_queue_init_params(uringOptions.queueDepth, ring, &params) < 0) {
+			delete ring;
+			ring = nullptr;
 			throw InvalidArgumentException("DirectRandomAccessFile: initialize io_uring fails.");
 		}
+		ringId = nextRingId++;
+		options = uringOptions;
+		if(options.registerFiles) {
+			// the files are registered into the free slots of a sparse table as they are read
+			fixedFiles.assign(FIXED_FILE_NUM, -1);
+			if(io_uring_register_files(ring, fixedFiles.data(), fixedFiles.size()) != 0) {
+				throw InvalidArgumentException("DirectUringRandomAccessFile: register files fails.");
+			}
+		}
+		static thread_local RingCloser ringCloser;
 	}
 }
 
@@ -79,38 +180,113 @@ void DirectUringRandomAccessFile::Reset() {
         delete(ring);
         ring = nullptr;
         isRegistered = false;
+        // the registered files and the completions are dropped with the ring
+        fixedFiles.clear();
+        completedBuffers.clear();
+        requestedBytes.clear();
+        submittedSqes = 0;
     }
     if(iovecs != nullptr) {
         free(iovecs);
         iovecs = nullptr;
+        iovecSize = 0;
     }
 }
 
-DirectUringRandomAccessFile::~DirectUringRandomAccessFile() {
+void DirectUringRandomAccessFile::Release(bool buffersFreed) {
+    isRegistered = false;
+    // the requests of the scan are done, the completions left are of the files that are not read to the end
+    completedBuffers.clear();
+    requestedBytes.clear();
+    if(buffersFreed && ring != nullptr) {
+        UnregisterBuffers();
+    }
+}
 
+int DirectUringRandomAccessFile::getSqeFd() {
+	if(fixedFileIndex >= 0 && fixedFileRingId == ringId) {
+		return fixedFileIndex;
+	}
+	if(!options.registerFiles) {
+		return fd;
+	}
+	// register the file lazily in the ring of the thread that reads it
+	auto slot = std::find(fixedFiles.begin(), fixedFiles.end(), -1);
+	if(slot == fixedFiles.end()) {
+		return fd;
+	}
+	int index = slot - fixedFiles.begin();
+	if(io_uring_register_files_update(ring, index, &fd, 1) != 1) {
+		throw InvalidArgumentException("DirectUringRandomAccessFile::getSqeFd: register file fails.");
+	}
+	fixedFiles[index] = fd;
+	fixedFileIndex = index;
+	fixedFileRingId = ringId;
+	return fixedFileIndex;
+}
+
+unsigned DirectUringRandomAccessFile::getSqeFlags() const {
+	unsigned flags = 0;
+	if(fixedFileIndex >= 0 && fixedFileRingId == ringId) {
+		flags |= IOSQE_FIXED_FILE;
+	}
+	if(options.asyncHint) {
+		flags |= IOSQE_ASYNC;
+	}
+	return flags;
+}
+
+void DirectUringRandomAccessFile::unregisterFile() {
+	// the file can only be unregistered from the ring of this thread, the slot in the ring of
+	// another thread is freed when that ring is reset
+	if(fixedFileIndex >= 0 && fixedFileRingId == ringId) {
+		int unregistered = -1;
+		if(io_uring_register_files_update(ring, fixedFileIndex, &unregistered, 1) != 1) {
+			throw InvalidArgumentException("DirectUringRandomAccessFile::unregisterFile: unregister file fails.");
+		}
+		fixedFiles[fixedFileIndex] = -1;
+	}
+	fixedFileIndex = -1;
+	fixedFileRingId = 0;
+}
+
+void DirectUringRandomAccessFile::close() {
+	unregisterFile();
+	DirectRandomAccessFile::close();
+}
+
+DirectUringRandomAccessFile::~DirectUringRandomAccessFile() {
+	unregisterFile();
 }
 
 std::shared_ptr<ByteBuffer> DirectUringRandomAccessFile::readAsync(int length, std::shared_ptr<ByteBuffer> buffer, int index) {
 	if(enableDirect) {
-		struct io_uring_sqe * sqe = io_uring_get_sqe(ring);
+		struct io_uring_sqe * sqe = GetSqe();
 //		if(length > iovecs[index].iov_len) {
 //			throw InvalidArgumentException("DirectUringRandomAccessFile::readAsync: the length is larger than buffer length.");
 //		}
 		// the file will be read from blockStart(fileOffset), and the first fileDelta bytes should be ignored.
 		uint64_t fileOffsetAligned = directIoLib->blockStart(offset);
 		uint64_t toRead = directIoLib->blockEnd(offset + length) - directIoLib->blockStart(offset);
-        io_uring_prep_read_fixed(sqe, fd, buffer->getPointer(), toRead,
+        io_uring_prep_read_fixed(sqe, getSqeFd(), buffer->getPointer(), toRead,
 		                         fileOffsetAligned, index);
+		io_uring_sqe_set_flags(sqe, getSqeFlags());
+		io_uring_sqe_set_data(sqe, (void *) (uintptr_t) index);
+		// the aligned read may end after the end of the file, only the requested bytes must be read
+		requestedBytes[index] = offset - fileOffsetAligned + length;
 		auto bb = std::make_shared<ByteBuffer>(*buffer,
 		                                       offset - fileOffsetAligned, length);
 		seek(offset + length);
 		return bb;
 	} else {
-		struct io_uring_sqe * sqe = io_uring_get_sqe(ring);
+		struct io_uring_sqe * sqe = GetSqe();
 //		if(length > iovecs[index].iov_len) {
 //			throw InvalidArgumentException("DirectUringRandomAccessFile::readAsync: the length is larger than buffer length.");
 //		}
-		io_uring_prep_read_fixed(sqe, fd, buffer->getPointer(), length, offset, index);
+		io_uring_prep_read_fixed(sqe, getSqeFd(), buffer->getPointer(), length, offset, index);
+		io_uring_sqe_set_flags(sqe, getSqeFlags());
+		io_uring_sqe_set_data(sqe, (void *) (uintptr_t) index);
+		requestedBytes[index] = length;
 		seek(offset + length);
 		auto result = std::make_shared<ByteBuffer>(*buffer, 0, length);
 		return result;
@@ -119,14 +295,61 @@ std::shared_ptr<ByteBuffer> DirectUringRandomAccessFile::readAsync(int length, s
 }
 
 
+struct io_uring_sqe * DirectUringRandomAccessFile::GetSqe() {
+	struct io_uring_sqe * sqe = io_uring_get_sqe(ring);
+	if(sqe == nullptr) {
+		// the batch is larger than the queue depth, submit the queued sqes to free the queue
+		int ret = io_uring_submit(ring);
+		if(ret < 0) {
+			throw InvalidArgumentException("DirectUringRandomAccessFile::GetSqe: submit fails: " +
+			                               std::string(strerror(-ret)));
+		}
+		submittedSqes += ret;
+		sqe = io_uring_get_sqe(ring);
+		if(sqe == nullptr) {
+			throw InvalidArgumentException("DirectUringRandomAccessFile::GetSqe: the submission queue is full");
+		}
+	}
+	return sqe;
+}
+
 void DirectUringRandomAccessFile::readAsyncSubmit(int size) {
 	int ret = io_uring_submit(ring);
-	if(ret != size) {
+	// the sqes submitted by GetSqe are part of this batch
+	int submitted = submittedSqes + ret;
+	submittedSqes = 0;
+	if(ret < 0 || submitted != size) {
 		throw InvalidArgumentException("DirectUringRandomAccessFile::readAsyncSubmit: submit fails");
 	}
 }
 
+int DirectUringRandomAccessFile::CompleteCqe(struct io_uring_cqe * cqe) {
+	int index = (int) (uintptr_t) io_uring_cqe_get_data(cqe);
+	int res = cqe->res;
+	io_uring_cqe_seen(ring, cqe);
+	uint64_t requested = 0;
+	auto it = requestedBytes.find(index);
+	if(it != requestedBytes.end()) {
+		requested = it->second;
+		requestedBytes.erase(it);
+	}
+	if(res < 0) {
+		throw InvalidArgumentException("DirectUringRandomAccessFile: the read of buffer " + std::to_string(index) +
+		                               " fails: " + std::string(strerror(-res)));
+	}
+	if((uint64_t) res < requested) {
+		throw InvalidArgumentException("DirectUringRandomAccessFile: the read of buffer " + std::to_string(index) +
+		                               " is short: " + std::to_string(res) + " of " + std::to_string(requested) +
+		                               " bytes");
+	}
+	return index;
+}
+
 void DirectUringRandomAccessFile::readAsyncComplete(int size) {
+	readAsyncComplete(size, [](int index) {});
+}
+
+void DirectUringRandomAccessFile::readAsyncComplete(int size, const std::function<void(int)> & onComplete) {
 	// Important! We cannot write the code as io_uring_wait_cqe_nr(ring, &cqe, iovecSize).
 	// The reason is unclear, but some random bugs would happen. It takes me nearly a week to find this bug
 	struct io_uring_cqe *cqe;
@@ -134,8 +357,27 @@ void DirectUringRandomAccessFile::readAsyncComplete(int size) {
 		if(io_uring_wait_cqe_nr(ring, &cqe, 1) != 0) {
 			throw InvalidArgumentException("DirectUringRandomAccessFile::readAsyncComplete: wait cqe fails");
 		}
-		io_uring_cqe_seen(ring, cqe);
+		onComplete(CompleteCqe(cqe));
 	}
 }
 
-
+int DirectUringRandomAccessFile::readAsyncCompleteNext(const std::function<bool(int)> & isWaited) {
+	for(auto it = completedBuffers.begin(); it != completedBuffers.end(); it++) {
+		if(isWaited(*it)) {
+			int index = *it;
+			completedBuffers.erase(it);
+			return index;
+		}
+	}
+	struct io_uring_cqe *cqe;
+	while(true) {
+		if(io_uring_wait_cqe_nr(ring, &cqe, 1) != 0) {
+			throw InvalidArgumentException("DirectUringRandomAccessFile::readAsyncCompleteNext: wait cqe fails");
+		}
+		int index = CompleteCqe(cqe);
+		if(isWaited(index)) {
+			return index;
+		}
+		completedBuffers.emplace_back(index);
+	}
+}
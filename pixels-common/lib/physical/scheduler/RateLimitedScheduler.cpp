@@ -0,0 +1,174 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+
+#include "physical/scheduler/RateLimitedScheduler.h"
+#include "physical/scheduler/NoopScheduler.h"
+#include "physical/StorageArrayScheduler.h"
+#include "exception/InvalidArgumentException.h"
+#include "profiler/CountProfiler.h"
+#include "utils/ConfigFactory.h"
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cctype>
+
+namespace {
+
+// see linux/ioprio.h, which is not shipped with the old kernel headers
+const int IOPRIO_CLASS_SHIFT = 13;
+const int IOPRIO_CLASS_BE = 2;
+const int IOPRIO_WHO_PROCESS = 1;
+
+}
+
+Scheduler * RateLimitedScheduler::instance = nullptr;
+thread_local int RateLimitedScheduler::ioPriority = -1;
+
+Scheduler * RateLimitedScheduler::Instance() {
+    if(instance == nullptr) {
+        instance = new RateLimitedScheduler();
+    }
+    return instance;
+}
+
+RateLimitedScheduler::RateLimitedScheduler() {
+    ConfigFactory & config = ConfigFactory::Instance();
+    bytesPerSecond = std::stod(config.getProperty("read.request.ratelimit.mbps")) * 1024 * 1024;
+    requestsPerSecond = std::stod(config.getProperty("read.request.ratelimit.iops"));
+    burstSeconds = std::stod(config.getProperty("read.request.ratelimit.burst.ms")) / 1000;
+    storageDepth = std::stoi(config.getProperty("storage.directory.depth"));
+    if(bytesPerSecond < 0 || requestsPerSecond < 0 || burstSeconds < 0) {
+        throw InvalidArgumentException("RateLimitedScheduler: the rates and the burst must not be negative. ");
+    }
+}
+
+RequestPriority RateLimitedScheduler::ParsePriority(const std::string & name) {
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c){ return std::tolower(c); });
+    if(lower == "interactive") {
+        return RequestPriority::INTERACTIVE;
+    } else if(lower == "batch") {
+        return RequestPriority::BATCH;
+    }
+    throw InvalidArgumentException("RateLimitedScheduler: the priority must be interactive or batch: " + name);
+}
+
+std::vector<std::shared_ptr<ByteBuffer>> RateLimitedScheduler::executeBatch(std::shared_ptr<PhysicalReader> reader,
+                                                                           RequestBatch batch, long queryId) {
+    return executeBatch(reader, batch, {}, queryId);
+}
+
+std::vector<std::shared_ptr<ByteBuffer>> RateLimitedScheduler::executeBatch(std::shared_ptr<PhysicalReader> reader, RequestBatch batch,
+                                                                           std::vector<std::shared_ptr<ByteBuffer>> reuseBuffers, long queryId) {
+    if(batch.getSize() <= 0) {
+        return std::vector<std::shared_ptr<ByteBuffer>>{};
+    }
+    setIoPriority(batch.getPriority());
+    if(bytesPerSecond > 0 || requestsPerSecond > 0) {
+        uint64_t bytes = 0;
+        for(const Request & request : batch.getRequests()) {
+            bytes += request.length;
+        }
+        acquire(getBucket(reader->getPath()), bytes, batch.getSize(), batch.getPriority());
+    }
+    return NoopScheduler::Instance()->executeBatch(reader, batch, reuseBuffers, queryId);
+}
+
+RateLimitedScheduler::TokenBucket & RateLimitedScheduler::getBucket(const std::string & path) {
+    std::string deviceName = StorageArrayScheduler::getDeviceName(path, storageDepth);
+    std::lock_guard<std::mutex> lock(bucketsLock);
+    auto & bucket = buckets[deviceName];
+    if(bucket == nullptr) {
+        bucket = std::make_unique<TokenBucket>();
+        bucket->bytes = bytesPerSecond * burstSeconds;
+        bucket->requests = requestsPerSecond * burstSeconds;
+        bucket->refillTime = std::chrono::steady_clock::now();
+    }
+    return *bucket;
+}
+
+void RateLimitedScheduler::refill(TokenBucket & bucket) {
+    auto now = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(now - bucket.refillTime).count();
+    bucket.refillTime = now;
+    bucket.bytes = std::min(bucket.bytes + elapsed * bytesPerSecond, bytesPerSecond * burstSeconds);
+    bucket.requests = std::min(bucket.requests + elapsed * requestsPerSecond, requestsPerSecond * burstSeconds);
+}
+
+void RateLimitedScheduler::acquire(TokenBucket & bucket, uint64_t bytes, uint64_t requests, RequestPriority priority) {
+    std::unique_lock<std::mutex> lock(bucket.lock);
+    bool interactive = priority == RequestPriority::INTERACTIVE;
+    if(interactive) {
+        bucket.interactiveWaiters++;
+    }
+    bool throttled = false;
+    while(true) {
+        refill(bucket);
+        // the time to pay off the debt of the bucket, the tokens of an unlimited rate are always 0
+        double wait = 0;
+        if(bucket.bytes < 0) {
+            wait = std::max(wait, -bucket.bytes / bytesPerSecond);
+        }
+        if(bucket.requests < 0) {
+            wait = std::max(wait, -bucket.requests / requestsPerSecond);
+        }
+        if(!interactive && bucket.interactiveWaiters > 0) {
+            // woken up when the last interactive batch is admitted
+            bucket.cv.wait(lock);
+        } else if(wait > 0) {
+            bucket.cv.wait_for(lock, std::chrono::duration<double>(wait));
+        } else {
+            break;
+        }
+        throttled = true;
+    }
+    if(interactive && --bucket.interactiveWaiters == 0) {
+        bucket.cv.notify_all();
+    }
+    if(bytesPerSecond > 0) {
+        bucket.bytes -= (double) bytes;
+    }
+    if(requestsPerSecond > 0) {
+        bucket.requests -= (double) requests;
+    }
+    if(throttled) {
+        ::CountProfiler::Instance().Count(interactive ? "throttled interactive requests" : "throttled batch requests", (int) requests);
+    }
+}
+
+void RateLimitedScheduler::setIoPriority(RequestPriority priority) {
+    // the highest and the lowest level of the best-effort class, the idle class may starve the batch queries
+    int value = (IOPRIO_CLASS_BE << IOPRIO_CLASS_SHIFT) | (priority == RequestPriority::INTERACTIVE ? 0 : 7);
+    if(ioPriority == value) {
+        return;
+    }
+    // the threads are shared by the queries, so the priority is set again once the thread serves another class.
+    // It takes effect on the reads issued by this thread, i.e., the sync reads, aio and io_uring without sqpoll,
+    // but not on the pread workers. It is ignored if the kernel does not allow it, e.g., in a container.
+    syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, value);
+    ioPriority = value;
+}
+
+RateLimitedScheduler::~RateLimitedScheduler() {
+    delete instance;
+    instance = nullptr;
+}
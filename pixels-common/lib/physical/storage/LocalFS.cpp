@@ -5,6 +5,8 @@
 #include "physical/storage/LocalFS.h"
 #include "physical/natives/DirectRandomAccessFile.h"
 #include "physical/natives/DirectUringRandomAccessFile.h"
+#include "physical/natives/DirectAioRandomAccessFile.h"
+#include "utils/ConfigFactory.h"
 #include "physical/FilePath.h"
 #include <filesystem>
 namespace fs = std::filesystem;
@@ -31,11 +33,13 @@ std::string LocalFS::ensureSchemePrefix(const std::string &path) const {
 }
 
 std::shared_ptr<PixelsRandomAccessFile> LocalFS::openRaf(const std::string& path) {
-    if(true) {
+    std::string asyncLib = ConfigFactory::Instance().getProperty("localfs.async.lib");
+    if(asyncLib == "aio" || asyncLib == "pread") {
+        // for the hosts where io_uring is not available
+        return std::make_shared<DirectAioRandomAccessFile>(path);
+    } else {
         // TODO: change this class to mmap class in the future.
         return std::make_shared<DirectUringRandomAccessFile>(path);
-    } else {
-        return std::make_shared<DirectRandomAccessFile>(path);
     }
 }
 
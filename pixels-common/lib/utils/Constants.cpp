@@ -17,6 +17,7 @@ int Constants::GCS_BUFFER_SIZE = 8 * 1024 * 1024;
 int Constants::MIN_REPEAT = 3;
 int Constants::MAX_SCOPE = 512;
 int Constants::MAX_SHORT_REPEAT_LENGTH = 10;
+long Constants::BASE_VALUE_LIMIT = 1L << 56;
 float Constants::DICT_KEY_SIZE_THRESHOLD = 0.1F;
 int Constants::INIT_DICT_SIZE = 4096;
 
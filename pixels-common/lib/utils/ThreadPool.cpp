@@ -0,0 +1,54 @@
+//
+// A fixed-size pool of worker threads.
+//
+
+#include "utils/ThreadPool.h"
+
+ThreadPool::ThreadPool(int threadNum) : stopped(false) {
+    if(threadNum <= 0) {
+        threadNum = std::max(1, (int) std::thread::hardware_concurrency());
+    }
+    workers.reserve(threadNum);
+    for(int i = 0; i < threadNum; i++) {
+        workers.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopped = true;
+    }
+    cv.notify_all();
+    for(auto & worker : workers) {
+        worker.join();
+    }
+}
+
+std::future<void> ThreadPool::submit(std::function<void()> task) {
+    std::packaged_task<void()> packagedTask(std::move(task));
+    std::future<void> future = packagedTask.get_future();
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        tasks.emplace(std::move(packagedTask));
+    }
+    cv.notify_one();
+    return future;
+}
+
+void ThreadPool::work() {
+    while(true) {
+        std::packaged_task<void()> task;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            cv.wait(guard, [this] { return stopped || !tasks.empty(); });
+            if(tasks.empty()) {
+                // stopped and drained
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PIXELS_PIXELINDEX_H
+#define PIXELS_PIXELINDEX_H
+
+#include "pixels-common/pixels.pb.h"
+#include "TypeDescription.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * The columnar pixel index of a column chunk, i.e., ColumnChunkIndex.pixelIndex. It stores the
+ * statistics of the pixels as flat little-endian arrays, so the reader copies them out instead
+ * of parsing a PixelStatistic message per pixel, and the pruning loops over them are vectorized.
+ * Only the types whose bounds are integers are supported, the other column chunks keep the pixel
+ * statistics.
+ *
+ * The layout is: uint32 pixelNum, uint32 flags, int64 minimums[pixelNum] and int64 maximums[pixelNum]
+ * (only if flags has HAS_MIN_MAX), uint32 numberOfValues[pixelNum], uint8 hasNull[pixelNum].
+ */
+class PixelIndex {
+public:
+    static const uint32_t HAS_MIN_MAX = 1;
+
+    /**
+     * Build the columnar pixel index from the statistics of the pixels. The minimum and maximum
+     * are taken from the integer, date or timestamp statistic, a pixel without them gets the
+     * full int64 range so that it is never pruned by them.
+     */
+    class Builder {
+    public:
+        void add(const pixels::proto::ColumnStatistic & statistic);
+        std::string build() const;
+        void reset();
+    private:
+        std::vector<int64_t> minimums;
+        std::vector<int64_t> maximums;
+        std::vector<uint32_t> numberOfValues;
+        std::vector<uint8_t> hasNull;
+        bool hasMinMax = false;
+    };
+
+    /**
+     * @param chunkIndex the column chunk index, it must have the pixelIndex and outlive this object
+     */
+    explicit PixelIndex(const pixels::proto::ColumnChunkIndex & chunkIndex);
+
+    /**
+     * @return whether the statistics of the columns of the category can be stored in the columnar
+     * pixel index without losing the bounds, i.e., short, int, long, date and timestamp
+     */
+    static bool isSupported(TypeDescription::Category category);
+
+    /**
+     * @return whether the pixel may contain nulls, by the columnar pixel index if it is present,
+     * otherwise by the pixel statistics
+     */
+    static bool hasNull(const pixels::proto::ColumnChunkIndex & chunkIndex, int pixelId);
+
+    int getPixelNum() const { return pixelNum; }
+    bool hasMinMax() const { return !minimums.empty(); }
+    const int64_t * getMinimums() const { return minimums.data(); }
+    const int64_t * getMaximums() const { return maximums.data(); }
+    const uint32_t * getNumberOfValues() const { return numberOfValues.data(); }
+    const uint8_t * getHasNull() const { return hasNulls; }
+private:
+    int pixelNum;
+    // the string storage of the index is not aligned for the arrays, so they are copied out
+    std::vector<int64_t> minimums;
+    std::vector<int64_t> maximums;
+    std::vector<uint32_t> numberOfValues;
+    const uint8_t * hasNulls;
+};
+
+#endif //PIXELS_PIXELINDEX_H
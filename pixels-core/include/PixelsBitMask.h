@@ -30,9 +30,15 @@ public:
     void And(long index, uint8_t value);
     bool isNone();
     void set();
+    void clear();
     void set(long index, uint8_t value);
     void setByteAligned(long index, uint8_t value);
+    // set (or clear) all the bits in [from, to)
+    void setRange(long from, long to, uint8_t value);
     uint8_t get(long index);
+    // the index of the first set (clear) bit in [from, to), or to if there is no such bit
+    long nextSetBit(long from, long to);
+    long nextClearBit(long from, long to);
 };
 
 #endif //DUCKDB_PIXELSBITMASK_H
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PIXELS_PIXELSCHUNKCACHE_H
+#define PIXELS_PIXELSCHUNKCACHE_H
+
+#include "physical/natives/ByteBuffer.h"
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * The cache of the column chunks read by the record readers, shared by the threads and the
+ * queries. A chunk is identified by its file id (see PixelsFooterCache::getFileId), row group
+ * id and column id, and it is cached as the decompressed content that the column readers read.
+ *
+ * Like PixelsFooterCache, the entries are split into locked shards that evict their least recently
+ * used entries. A new chunk only replaces the eviction victims if it has been accessed more often
+ * than they have, so the hot chunks are not flushed out by a single large scan. The access
+ * frequencies are counted approximately in a count-min sketch per shard that is aged periodically.
+ */
+class PixelsChunkCache {
+public:
+    PixelsChunkCache(uint64_t capacity, int shardNum);
+    /**
+     * @return the chunk cache shared by all the queries in this process, its capacity and shard
+     * number are chunk.cache.capacity and chunk.cache.shards, or nullptr if the capacity is 0.
+     */
+    static std::shared_ptr<PixelsChunkCache> Instance();
+    static std::string getChunkId(const std::string & fileId, int rowGroupId, int columnId);
+    /**
+     * Record an access of the chunk and look it up.
+     * @return the cached chunk, or nullptr if it is not in the cache. The returned buffer is a view
+     * of the cached chunk, so that each reader has its own read position.
+     */
+    std::shared_ptr<ByteBuffer> find(const std::string & id);
+    /**
+     * Copy the chunk into the cache if it is admitted.
+     * @return whether the chunk is cached
+     */
+    bool put(const std::string & id, const uint8_t * data, uint64_t length);
+    // @return the number of bytes of the cached chunks
+    uint64_t getSize();
+private:
+    static const int SKETCH_DEPTH = 4;
+    static const uint8_t MAX_FREQUENCY = 15;
+
+    struct Entry {
+        std::shared_ptr<ByteBuffer> chunk;
+        std::list<std::string>::iterator lruPosition;
+    };
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<std::string, Entry> entries;
+        // the most recently used id is at the front
+        std::list<std::string> lru;
+        uint64_t bytes = 0;
+        // the count-min sketch of the access frequencies, SKETCH_DEPTH rows of sketchWidth counters
+        std::vector<uint8_t> sketch;
+        uint64_t accesses = 0;
+    };
+
+    Shard & getShard(uint64_t hash);
+    void recordAccess(Shard & shard, uint64_t hash);
+    uint8_t getFrequency(Shard & shard, uint64_t hash) const;
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    uint64_t shardCapacity;
+    uint64_t sketchWidth;
+};
+
+#endif //PIXELS_PIXELSCHUNKCACHE_H
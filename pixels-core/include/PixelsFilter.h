@@ -15,6 +15,9 @@
 #include "PixelsBitMask.h"
 #include "vector/ColumnVector.h"
 #include "TypeDescription.h"
+#include "pixels-common/pixels.pb.h"
+#include "PixelIndex.h"
+#include <string>
 #include <immintrin.h>
 #include <avxintrin.h>
 
@@ -34,6 +37,58 @@ public:
                             const duckdb::Value &constant, PixelsBitMask &filter_mask,
                             std::shared_ptr<TypeDescription> type);
 
+    /**
+     * Check whether the values described by the column statistic may satisfy the filter.
+     * It is used to prune row groups (and pixels) by their min/max statistics before
+     * reading or decoding them.
+     *
+     * @return false only if no value can satisfy the filter. If the statistic
+     * is absent or the filter is not supported, true is returned.
+     */
+    static bool CheckStatistics(const pixels::proto::ColumnStatistic &stats, duckdb::TableFilter &filter,
+                                const std::shared_ptr<TypeDescription> &type);
+
+    /**
+     * The counterpart of CheckStatistics for all the pixels in a columnar pixel index.
+     * matches[i] is cleared if no value in the i-th pixel can satisfy the filter, it is
+     * left unchanged otherwise.
+     */
+    static void CheckPixelIndex(const PixelIndex &index, duckdb::TableFilter &filter,
+                                const std::shared_ptr<TypeDescription> &type, uint8_t *matches);
+
+    template <class T>
+    static bool CheckRange(duckdb::ExpressionType comparison, const T &min, const T &max, const T &constant);
+
+    // whether every value in [min, max] satisfies the comparison
+    template <class T>
+    static bool CheckRangeAll(duckdb::ExpressionType comparison, const T &min, const T &max, const T &constant);
+
+    enum BoundsMatch {
+        NONE_MATCH, SOME_MATCH, ALL_MATCH
+    };
+
+    /**
+     * Evaluate the filter once for a set of values that are known to be in [min, max],
+     * such as a run of run-length encoded integers or a single dictionary entry.
+     * T is int64_t for integer, date and timestamp columns, and std::string for strings.
+     * The values are not null, the null rows are decided by MatchesNull.
+     *
+     * @return ALL_MATCH (NONE_MATCH) if every (no) value in [min, max] satisfies the filter,
+     * otherwise SOME_MATCH and the values have to be checked one by one.
+     */
+    template <class T>
+    static BoundsMatch CheckBounds(duckdb::TableFilter &filter, const T &min, const T &max,
+                                   const std::shared_ptr<TypeDescription> &type);
+
+    // whether a null value satisfies the filter
+    static bool MatchesNull(duckdb::TableFilter &filter);
+
+    /**
+     * Set (or clear) the bits of the null rows in the filter mask by whether a null value
+     * satisfies the filter. The null rows are the clear bits of vector->isValid.
+     */
+    static void ApplyNulls(const std::shared_ptr<ColumnVector> &vector, PixelsBitMask &filterMask, bool match);
+
     template <class OP>
     static void FilterOperationSwitch(std::shared_ptr<ColumnVector> vector, duckdb::Value &constant,
                                       PixelsBitMask &filter_mask, std::shared_ptr<TypeDescription> type);
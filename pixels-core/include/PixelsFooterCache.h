@@ -7,25 +7,69 @@
 
 #include <iostream>
 #include <string>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
 #include "pixels-common/pixels.pb.h"
+#include "physical/PhysicalReader.h"
 #include <unordered_map>
 
 using namespace pixels::proto;
-typedef std::unordered_map<std::string, std::shared_ptr<FileTail>> FileTailTable;
-typedef std::unordered_map<std::string, std::shared_ptr<RowGroupFooter>> RGFooterTable;
 
+/**
+ * The cache of the FileTails and RowGroupFooters. It is safe to be shared by
+ * the threads and the queries: the entries are split into shards by id, each
+ * shard has its own lock and evicts its least recently used entries once the
+ * shard exceeds its share of the capacity.
+ *
+ * A file is identified by its path, length and last modification time (see getFileId),
+ * so the entries of a rewritten file are never hit again and age out of the cache.
+ */
 class PixelsFooterCache {
 public:
-    PixelsFooterCache();
+    explicit PixelsFooterCache(uint64_t capacity = DEFAULT_CAPACITY, int shardNum = DEFAULT_SHARD_NUM);
+    /**
+     * @return the footer cache shared by all the queries in this process,
+     * its capacity and shard number are footer.cache.capacity and footer.cache.shards.
+     */
+    static std::shared_ptr<PixelsFooterCache> Instance();
+    static std::string getFileId(const std::shared_ptr<PhysicalReader> & reader);
+    static std::string getFileId(const std::string & path, uint64_t fileLength, int64_t lastModified);
     void putFileTail(const std::string& id, std::shared_ptr<FileTail> fileTail);
     bool containsFileTail(const std::string& id);
 	std::shared_ptr<FileTail> getFileTail(const std::string& id);
+    // @return the cached FileTail, or nullptr if it is not in the cache
+    std::shared_ptr<FileTail> findFileTail(const std::string& id);
     void putRGFooter(const std::string& id, std::shared_ptr<RowGroupFooter> footer);
     bool containsRGFooter(const std::string& id);
 	std::shared_ptr<RowGroupFooter> getRGFooter(const std::string& id);
+    // @return the cached RowGroupFooter, or nullptr if it is not in the cache
+    std::shared_ptr<RowGroupFooter> findRGFooter(const std::string& id);
+    // @return the estimated memory usage of the cached entries in bytes
+    uint64_t getSize();
 private:
-    FileTailTable fileTailCacheMap;
-    RGFooterTable rowGroupFooterCacheMap;
+    static const uint64_t DEFAULT_CAPACITY = 256L * 1024 * 1024;
+    static const int DEFAULT_SHARD_NUM = 16;
 
+    struct Entry {
+        std::shared_ptr<google::protobuf::Message> value;
+        uint64_t bytes;
+        std::list<std::string>::iterator lruPosition;
+    };
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<std::string, Entry> entries;
+        // the most recently used id is at the front
+        std::list<std::string> lru;
+        uint64_t bytes = 0;
+    };
+
+    Shard & getShard(const std::string& id);
+    void put(const std::string& id, std::shared_ptr<google::protobuf::Message> value);
+    std::shared_ptr<google::protobuf::Message> find(const std::string& id);
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    uint64_t shardCapacity;
 };
 #endif //PIXELS_PIXELSFOOTERCACHE_H
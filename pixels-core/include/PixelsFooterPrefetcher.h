@@ -0,0 +1,50 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PIXELS_PIXELSFOOTERPREFETCHER_H
+#define PIXELS_PIXELSFOOTERPREFETCHER_H
+
+#include "PixelsFooterCache.h"
+#include <string>
+#include <vector>
+
+/**
+ * Prefetch the FileTails of many files into the footer cache before they are scanned.
+ *
+ * The last footer.prefetch.size bytes of each file are read with batched io_uring reads,
+ * so the tail offset and the FileTail of a file usually arrive in a single I/O. The tails are
+ * parsed by worker threads while the next batch is being read. A tail larger than the prefetched
+ * bytes is read again by the worker that parses it. The workers are shared by all the prefetches.
+ *
+ * With localfs.async.lib=aio or pread, or if the ring can not be set up, the tails are read by
+ * pread on the worker threads instead. The tails are read without O_DIRECT, and the native AIO
+ * reads such files synchronously in io_submit, so the workers are the async path for both.
+ */
+class PixelsFooterPrefetcher {
+public:
+    /**
+     * The files whose tails are already in the cache are not read again.
+     * @return the FileTail of each file, or nullptr if it failed to be prefetched
+     */
+    static std::vector<std::shared_ptr<pixels::proto::FileTail>> prefetch(
+            const std::vector<std::string> & files, const std::shared_ptr<PixelsFooterCache> & footerCache);
+};
+
+#endif //PIXELS_PIXELSFOOTERPREFETCHER_H
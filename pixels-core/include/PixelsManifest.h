@@ -0,0 +1,77 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PIXELS_PIXELSMANIFEST_H
+#define PIXELS_PIXELSMANIFEST_H
+
+#include "pixels-common/pixels.pb.h"
+#include "PixelsFooterCache.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * The sidecar manifest (.pxl-manifest) of a directory of pixels files. It caches the
+ * FileTail of each file, i.e., the schema, the row counts, the row group layout and the
+ * column statistics, so that a scan over many files can be planned without opening them.
+ *
+ * An entry is only used while the length and the modification time of its file are unchanged.
+ * refresh() rebuilds the manifest incrementally, it only reads the tails of new or changed files.
+ */
+class PixelsManifest {
+public:
+    static const std::string FILE_NAME;
+
+    /**
+     * Memory-map and parse the manifest of the directory.
+     * @return nullptr if the directory has no valid manifest
+     */
+    static std::shared_ptr<PixelsManifest> open(const std::string & directory);
+    /**
+     * Update the manifest of the directory for the current .pxl files in it and write it back.
+     * @return the updated manifest
+     */
+    static std::shared_ptr<PixelsManifest> refresh(const std::string & directory);
+    /**
+     * Look up the FileTails of the files in the manifests of their directories. The tails found
+     * are also put into the footer cache if it is not null, so that the readers of these files
+     * do not read their tails again.
+     * @return the FileTail of each file, or nullptr if the file is not in a manifest or has changed
+     */
+    static std::vector<std::shared_ptr<pixels::proto::FileTail>> getFileTails(
+            const std::vector<std::string> & files, const std::shared_ptr<PixelsFooterCache> & footerCache);
+
+    /**
+     * @param path the path of a file in the directory of this manifest
+     * @return the FileTail of the file, or nullptr if it is not in this manifest or has changed
+     */
+    std::shared_ptr<pixels::proto::FileTail> getFileTail(const std::string & path);
+    int getFileNum() const;
+private:
+    explicit PixelsManifest(std::shared_ptr<pixels::proto::Manifest> manifest);
+    const pixels::proto::ManifestEntry * findValidEntry(const std::string & path) const;
+
+    std::shared_ptr<pixels::proto::Manifest> manifest;
+    // the index of the entry of each file name
+    std::unordered_map<std::string, int> entryIndex;
+};
+
+#endif //PIXELS_PIXELSMANIFEST_H
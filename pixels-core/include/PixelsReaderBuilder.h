@@ -24,6 +24,10 @@ public:
 	PixelsReaderBuilder * setPath(const std::string & path);
 	PixelsReaderBuilder * setPixelsFooterCache(std::shared_ptr<PixelsFooterCache> pixelsFooterCache);
 	std::shared_ptr<PixelsReader> build();
+	// read and parse the FileTail at the end of the file
+	static std::shared_ptr<pixels::proto::FileTail> readFileTail(const std::shared_ptr<PhysicalReader> & fsReader);
+	// the start offset of the FileTail from the last eight bytes of the file, which may be in either byte order
+	static long getFileTailOffset(long lastLong);
 
 private:
     std::shared_ptr<Storage> builderStorage;
@@ -45,8 +45,10 @@ private:
 	std::shared_ptr<TypeDescription> fileSchema;
     std::shared_ptr<PhysicalReader> physicalReader;
 	std::shared_ptr<PixelsFooterCache> pixelsFooterCache;
-    pixels::proto::PostScript postScript;
-    pixels::proto::Footer footer;
+    // the footer and postScript are views of the file tail, which may be shared with the footer cache
+    std::shared_ptr<pixels::proto::FileTail> fileTail;
+    const pixels::proto::PostScript& postScript;
+    const pixels::proto::Footer& footer;
 	bool closed;
 };
 
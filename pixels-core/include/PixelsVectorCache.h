@@ -0,0 +1,133 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PIXELS_PIXELSVECTORCACHE_H
+#define PIXELS_PIXELSVECTORCACHE_H
+
+#include "TypeDescription.h"
+#include "vector/ColumnVector.h"
+#include "vector/BinaryColumnVector.h"
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * The decoded values of a column vector kept in the vector cache. The values are the fixed width
+ * values in the layout of the column vector, or the dictionary ids of a dictionary encoded string
+ * column. The dictionary is a copy that owns its strings, so that it does not refer to the column chunk.
+ */
+struct DecodedVector {
+    std::unique_ptr<uint8_t[]> values;
+    std::vector<uint64_t> valid;
+    std::shared_ptr<BinaryDictionary> dictionary;
+    // the memory usage of this vector, including the dictionary
+    uint64_t bytes;
+
+    /**
+     * Copy the first size values of a column vector that is decoded from the start.
+     * @param copiedDictionary the last dictionary copied for the column and its copy, it is reused
+     * if the vector has the same dictionary and updated otherwise.
+     * @return the copy, or nullptr if the vector can not be cached, e.g., the strings are not dictionary encoded.
+     */
+    static std::shared_ptr<DecodedVector> copyOf(
+            const std::shared_ptr<ColumnVector> & vector, TypeDescription::Category category, int size,
+            std::pair<std::shared_ptr<BinaryDictionary>, std::shared_ptr<BinaryDictionary>> & copiedDictionary);
+};
+
+/**
+ * The cache of the decoded column vectors, shared by the threads and the queries. A vector is identified
+ * by the file id (see PixelsFooterCache::getFileId), the row group id, the column id and the range of rows
+ * it holds. The record readers reference the cached values from the result column vectors (see
+ * ColumnVector::cachedVector) instead of decoding the chunk again, so the run-length and dictionary
+ * encoded columns that are scanned repeatedly are decoded once.
+ *
+ * The columns are selected by vector.cache.columns, and the vectors of the columns in
+ * vector.cache.pinned.columns are pinned, i.e., they are never evicted, e.g., for the small dimension
+ * tables. The other vectors are evicted in the least recently used order when the capacity is exceeded.
+ */
+class PixelsVectorCache {
+public:
+    PixelsVectorCache(uint64_t capacity, int shardNum, const std::string & cachedColumns,
+                      const std::string & pinnedColumns);
+    /**
+     * @return the vector cache shared by all the queries in this process configured by the vector.cache.*
+     * properties, or nullptr if vector.cache.capacity is 0.
+     */
+    static std::shared_ptr<PixelsVectorCache> Instance();
+    static std::string getVectorId(const std::string & fileId, int rowGroupId, int columnId,
+                                   int startRow, int size);
+    // @return the cached vector, or nullptr if it is not in the cache
+    std::shared_ptr<DecodedVector> find(const std::string & id);
+    /**
+     * Put the vector into the cache, evicting the least recently used vectors that are not pinned.
+     * @return whether the vector is cached
+     */
+    bool put(const std::string & id, std::shared_ptr<DecodedVector> vector, bool pinned);
+    /**
+     * The columns are given as a comma separated list of column names or table.column, where the table
+     * matches the files under a directory with the name of the table, e.g., /data/nation/v-0-order/.
+     * @param filePath the path of the file
+     * @param columnName the name of the column in the file
+     * @return whether the vectors of the column are cached
+     */
+    bool isCached(const std::string & filePath, const std::string & columnName) const;
+    // @return whether the vectors of the column are pinned, they are always cached
+    bool isPinned(const std::string & filePath, const std::string & columnName) const;
+    // @return the number of bytes of the cached vectors
+    uint64_t getSize();
+private:
+    struct Entry {
+        std::shared_ptr<DecodedVector> vector;
+        bool pinned;
+        // only valid if the entry is not pinned
+        std::list<std::string>::iterator lruPosition;
+    };
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<std::string, Entry> entries;
+        // the ids of the vectors that are not pinned, the most recently used id is at the front
+        std::list<std::string> lru;
+        uint64_t bytes = 0;
+        uint64_t pinnedBytes = 0;
+    };
+    // a column in vector.cache.columns or vector.cache.pinned.columns, the table is empty if it is not given
+    struct ColumnPattern {
+        std::string table;
+        std::string column;
+    };
+
+    static std::vector<ColumnPattern> parseColumns(const std::string & columns);
+    static bool matches(const std::vector<ColumnPattern> & patterns, const std::string & filePath,
+                        const std::string & columnName);
+    Shard & getShard(const std::string & id);
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    uint64_t shardCapacity;
+    // empty if all the columns are cached
+    std::vector<ColumnPattern> cachedColumns;
+    std::vector<ColumnPattern> pinnedColumns;
+};
+
+#endif //PIXELS_PIXELSVECTORCACHE_H
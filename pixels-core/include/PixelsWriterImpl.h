@@ -65,9 +65,9 @@ private:
     // std::unique_ptr<icu::TimeZone> timeZone;
     std::shared_ptr<PixelsWriterOption> columnWriterOption;
     std::vector<std::shared_ptr<ColumnWriter>> columnWriters;
-    std::vector<StatsRecorder> fileColStatRecorders;
-    std::int64_t fileContentLength;
-    int fileRowNum;
+    std::vector<std::unique_ptr<StatsRecorder>> fileColStatRecorders;
+    std::int64_t fileContentLength = 0;
+    int fileRowNum = 0;
     std::int64_t writtenBytes = 0;
     std::int64_t curRowGroupOffset = 0;
     std::int64_t curRowGroupFooterOffset = 0;
@@ -77,6 +77,10 @@ private:
     int currHashValue = 0;
     bool partitioned;
     std::vector<pixels::proto::RowGroupInformation> rowGroupInfoList;
+    // whether the RowGroupFooters are also written contiguously before the file tail
+    bool rowGroupFootersConsolidated;
+    // the serialized RowGroupFooters to be written before the file tail
+    std::vector<std::string> rowGroupFooterContents;
     std::vector<pixels::proto::RowGroupStatistic> rowGroupStatisticList;
     std::shared_ptr<PhysicalWriter> physicalWriter;
     std::vector<std::shared_ptr<TypeDescription>> children;
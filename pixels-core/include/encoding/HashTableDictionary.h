@@ -0,0 +1,63 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PIXELS_HASHTABLEDICTIONARY_H
+#define PIXELS_HASHTABLEDICTIONARY_H
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * The dictionary of a string column chunk. Keys are copied into a single
+ * arena in the order they are added, so the id of a key is its position in
+ * the arena and the arena can be written out as the dictionary content directly.
+ * Lookups go through an open addressing hash table on top of the arena.
+ */
+class HashTableDictionary {
+public:
+    explicit HashTableDictionary(int initialCapacity = DEFAULT_CAPACITY);
+
+    /**
+     * Add the key if it is not in the dictionary yet.
+     * @return the id of the key
+     */
+    int add(const uint8_t * key, int length);
+    int size() const;
+    const uint8_t * getKey(int id) const;
+    int getKeyLength(int id) const;
+    // the concatenated keys in the order of their ids
+    const std::vector<uint8_t> & getContent() const;
+    // the start offsets of the keys in the content, with the end of the content appended
+    const std::vector<int> & getStarts() const;
+    void clear();
+private:
+    static const int DEFAULT_CAPACITY = 1024;
+
+    static uint64_t hash(const uint8_t * key, int length);
+    void grow();
+
+    std::vector<uint8_t> content;
+    std::vector<int> starts;
+    std::vector<uint64_t> hashes;   // hash of each key, indexed by id
+    std::vector<int> slots;         // id in each slot, -1 for empty
+    uint64_t mask;
+};
+
+#endif //PIXELS_HASHTABLEDICTIONARY_H
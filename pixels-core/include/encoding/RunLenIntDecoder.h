@@ -18,13 +18,51 @@ public:
     void close() override;
     long next() override;
 	bool hasNext() override;
+    /**
+     * Skip the next n values without decoding them. Whole SHORT_REPEAT and DELTA runs
+     * are skipped arithmetically, and whole DIRECT runs by their bit-packed length.
+     *
+     * @param n the number of values to skip
+     */
+    void skip(long n);
+    /**
+     * Decode the next n values into the output buffer. Whole runs are expanded
+     * straight into the output: SHORT_REPEAT by broadcast, DELTA by prefix sum and
+     * DIRECT by bulk bit-unpacking, without staging the values in literals.
+     *
+     * @param out the output buffer, it must have at least n elements
+     * @param n the number of values to decode
+     */
+    void decode(int64_t * out, int n);
+    void decode(int32_t * out, int n);
+    /**
+     * Decode the next values but stop at the end of the current run.
+     *
+     * @param out the output buffer, it must have at least n elements
+     * @param n the max number of values to decode
+     * @param monotonic set to true if the decoded values are monotonic (SHORT_REPEAT and
+     * DELTA runs), so that they are bounded by the first and the last value
+     * @return the number of decoded values
+     */
+    int readRun(int64_t * out, int n, bool & monotonic);
+    int readRun(int32_t * out, int n, bool & monotonic);
     ~RunLenIntDecoder();
 private:
 
     void readValues();
+    long skipRun(long n);
+    template <class T>
+    void bulkDecode(T * out, int n);
+    template <class T>
+    int decodeRun(T * out, int n);
+    template <class T>
+    int readRunValues(T * out, int n, bool & monotonic);
+    void skipVulong(const std::shared_ptr<ByteBuffer>& input);
 	void readShortRepeatValues(int firstByte);
     void readDirectValues(int firstByte);
 	void readDeltaValues(int firstByte);
+    void readPatchedBaseValues(int firstByte);
+    void unpackPatchedBase(int firstByte, long * buffer, int len);
 	long readVulong(const std::shared_ptr<ByteBuffer>& input);
 	long readVslong(const std::shared_ptr<ByteBuffer>& input);
 	long bytesToLongBE(const std::shared_ptr<ByteBuffer>& input, int n);
@@ -38,5 +76,7 @@ private:
     std::shared_ptr<ByteBuffer> inputStream;
     EncodingUtils encodingUtils;
 	bool isRepeating;
+    // whether the values in literals are monotonic
+    bool isMonotonic;
 };
 #endif //PIXELS_RUNLENINTDECODER_H
@@ -59,6 +59,8 @@ public:
     // -----------------------------------------------------------
     // PATCH_BASE
     void preparePatchedBlob();
+    int getPatchedBaseSize();
+    int getDirectSize();
     // -----------------------------------------------------------
     // zigzag 
     void computeZigZagLiterals();
@@ -12,6 +12,8 @@
 #include "duckdb.h"
 #include "duckdb/common/types/vector.hpp"
 #include "PixelsFilter.h"
+#include "PixelIndex.h"
+#include "encoding/RunLenIntDecoder.h"
 
 class ColumnReader {
 public:
@@ -44,9 +46,68 @@ public:
                       pixels::proto::ColumnChunkIndex & chunkIndex,
                       std::shared_ptr<PixelsBitMask> filterMask);
 
+    /**
+     * Skip values in the input buffer without decoding them. The reader state
+     * (element index, isNull offset and the position in the input buffer) is advanced
+     * as if read() was invoked, but the values in the vector are undefined.
+     * By default, the values are simply read.
+     *
+     * @param input    input buffer
+     * @param encoding encoding type
+     * @param offset   starting offset of the values to skip
+     * @param size     number of values to skip
+     * @param pixelStride the stride (number of rows) in a pixels.
+     * @param vectorIndex the index from where we would read values into the vector
+     * @param vector   vector that the values would be read into
+     * @param chunkIndex the metadata of the column chunk to read.
+     */
+    virtual void skip(std::shared_ptr<ByteBuffer> input,
+                      pixels::proto::ColumnEncoding & encoding,
+                      int offset, int size, int pixelStride,
+                      int vectorIndex, std::shared_ptr<ColumnVector> vector,
+                      pixels::proto::ColumnChunkIndex & chunkIndex);
+
+    /**
+     * Read values like read(), and evaluate the filter on the encoded data at the same time,
+     * e.g., once per run of run-length encoded values or once per dictionary entry.
+     * The rows that do not satisfy the filter are cleared in the filter mask.
+     *
+     * @param filter the filter on this column
+     * @return false if the encoding of the column chunk does not support it. In this case,
+     * nothing is read, and the caller should use read() and PixelsFilter::ApplyFilter instead.
+     */
+    virtual bool readAndFilter(std::shared_ptr<ByteBuffer> input,
+                               pixels::proto::ColumnEncoding & encoding,
+                               int offset, int size, int pixelStride,
+                               int vectorIndex, std::shared_ptr<ColumnVector> vector,
+                               pixels::proto::ColumnChunkIndex & chunkIndex,
+                               std::shared_ptr<PixelsBitMask> filterMask,
+                               duckdb::TableFilter & filter);
+
     void setValid(const std::shared_ptr<ByteBuffer>& input, int pixelStride, const std::shared_ptr<ColumnVector>& columnVector, int pixelId, bool hasNull);
+    // advance the isNull offset in the same way as setValid, without filling the valid mask
+    void skipValid(int pixelStride, int size, bool hasNull);
+    /**
+     * If the values to skip cover the whole current pixel, seek the input to the start
+     * of the next pixel using the pixel positions in the chunk index. Each pixel is encoded
+     * separately, so this also fast-forwards run-length encoded streams.
+     *
+     * @return true if the input is positioned at the start of the next pixel
+     */
+    bool seekToNextPixel(const std::shared_ptr<ByteBuffer>& input, int pixelStride, int size,
+                         pixels::proto::ColumnChunkIndex & chunkIndex);
 
 protected:
+    /**
+     * Decode size run-length encoded values into values run by run. The filter is evaluated
+     * once for each monotonic run by its first and last value. Only if some run is not decided
+     * by its bounds, the filter is applied to the decoded values in the vector.
+     */
+    template <class T>
+    void readRunsAndFilter(RunLenIntDecoder & decoder, T * values, int size,
+                           const std::shared_ptr<ColumnVector> & vector,
+                           PixelsBitMask & filterMask, duckdb::TableFilter & filter);
+
     int elementIndex;
 	std::shared_ptr<TypeDescription> type;
     uint32_t isNullOffset;
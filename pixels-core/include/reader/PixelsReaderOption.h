@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 #include "duckdb/planner/table_filter.hpp"
+#include "physical/Request.h"
 
 class PixelsReaderOption {
 public:
@@ -32,6 +33,8 @@ public:
     bool isTolerantSchemaEvolution();
     void setEnableEncodedColumnVector(bool enabled);
     bool isEnableEncodedColumnVector();
+    void setPriority(RequestPriority priority);
+    RequestPriority getPriority();
 private:
     std::vector<std::string> includedCols;
     duckdb::TableFilterSet * filter;
@@ -41,6 +44,7 @@ private:
     bool enableEncodedColumnVector;   // whether read encoded column vectors directly when possible
     bool enableFilterPushDown;        // if filter pushDown is enabled
     long queryId;
+    RequestPriority priority;         // the priority class of the read requests of the query
     int batchSize;
     int rgStart;
     int rgLen;
@@ -12,6 +12,8 @@
 #include "physical/SchedulerFactory.h"
 #include "pixels-common/pixels.pb.h"
 #include "PixelsFooterCache.h"
+#include "PixelsChunkCache.h"
+#include "PixelsVectorCache.h"
 #include "reader/PixelsReaderOption.h"
 #include "utils/String.h"
 #include "TypeDescription.h"
@@ -21,6 +23,7 @@
 #include "physical/BufferPool.h"
 #include "physical/natives/DirectUringRandomAccessFile.h"
 #include "PixelsFilter.h"
+#include <future>
 
 class ChunkId {
 public:
@@ -40,8 +43,8 @@ public:
 class PixelsRecordReaderImpl: public PixelsRecordReader {
 public:
     explicit PixelsRecordReaderImpl(std::shared_ptr<PhysicalReader> reader,
-                                    const pixels::proto::PostScript& pixelsPostScript,
-                                    const pixels::proto::Footer& pixelsFooter,
+                                    std::shared_ptr<TypeDescription> fileSchema,
+                                    std::shared_ptr<pixels::proto::FileTail> fileTail,
                                     const PixelsReaderOption& opt,
                                     std::shared_ptr<PixelsFooterCache> pixelsFooterCache
                                     );
@@ -58,12 +61,44 @@ private:
     std::vector<int64_t> bufferIds;
     void prepareRead();
     void checkBeforeRead();
+    bool checkRowGroupStatistics(int rgId);
+    void updatePixelMatches();
+    bool checkPixelStatistics(int pixelId);
 	std::shared_ptr<VectorizedRowBatch> createEmptyEOFRowBatch(int size);
 	void UpdateRowGroupInfo();
+    void readConsolidatedRGFooters(const std::vector<int> & missedTargets,
+                                   const std::vector<std::string> & rgCacheIds, const std::string & fileCacheId);
+    void decompressChunk(uint32_t colId);
+    void waitDecompression();
+    void completeAsyncRead();
+    bool isChunkReady(uint32_t colId);
+    size_t waitAnyChunk(const std::vector<int> & columns);
+    void filterColumn(int i, duckdb::TableFilter & tableFilter, int size,
+                      std::vector<std::shared_ptr<ColumnVector>> & columnVectors);
+    void readColumn(int i, int size, bool skipBatch, bool decodedAll,
+                    std::vector<std::shared_ptr<ColumnVector>> & columnVectors);
+    void cacheReadChunks();
+    std::string getVectorId(int i, int size);
+    void cacheVector(int i, const std::string & vectorId, int size);
     std::shared_ptr<PhysicalReader> physicalReader;
-    pixels::proto::Footer footer;
-    pixels::proto::PostScript postScript;
+    // the footer and postScript are views of the file tail, which may be shared with the footer cache
+    std::shared_ptr<pixels::proto::FileTail> fileTail;
+    const pixels::proto::Footer& footer;
+    const pixels::proto::PostScript& postScript;
 	std::shared_ptr<PixelsFooterCache> footerCache;
+    // nullptr if the chunk cache is disabled
+    std::shared_ptr<PixelsChunkCache> chunkCache;
+    // the file id in the chunk and vector cache ids
+    std::string cacheFileId;
+    // the column id and chunk cache id of the chunks that are read from the disk and not cached yet
+    std::vector<std::pair<uint32_t, std::string>> chunksToCache;
+    // nullptr if the vector cache is disabled
+    std::shared_ptr<PixelsVectorCache> vectorCache;
+    // whether the vectors of each result column are cached and pinned in the vector cache
+    std::vector<bool> vectorsCached;
+    std::vector<bool> vectorsPinned;
+    // the last dictionary copied into the vector cache for each result column and its copy
+    std::vector<std::pair<std::shared_ptr<BinaryDictionary>, std::shared_ptr<BinaryDictionary>>> copiedDictionaries;
     PixelsReaderOption option;
     duckdb::TableFilterSet * filter;
     long queryId;
@@ -81,6 +116,8 @@ private:
 	int curRGRowCount;
     bool enabledFilterPushDown;
     std::shared_ptr<PixelsBitMask> filterMask;
+    // whether each pixel of the current row group may contain rows satisfying the filters
+    std::vector<uint8_t> pixelMatches;
 	std::shared_ptr<pixels::proto::RowGroupFooter> curRGFooter;
 	std::vector<std::shared_ptr<pixels::proto::ColumnEncoding>> curEncoding;
 	std::vector<int> curChunkBufferIndex;
@@ -97,6 +134,10 @@ private:
 
     // buffers of each chunk in this file, arranged by chunk's row group id and column id
     std::vector<std::shared_ptr<ByteBuffer>> chunkBuffers;
+    // column id of the chunk being read by each async request, keyed by its buffer id
+    std::map<int64_t, uint32_t> asyncChunks;
+    // the chunks being decompressed by the decompression workers, keyed by their column ids
+    std::map<uint32_t, std::future<void>> decompressTasks;
     // column readers for each target columns
     std::vector<std::shared_ptr<ColumnReader>> readers;
     std::vector<uint32_t> targetColumns;
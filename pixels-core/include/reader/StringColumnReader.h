@@ -19,6 +19,18 @@ public:
               int vectorIndex, std::shared_ptr<ColumnVector> vector,
               pixels::proto::ColumnChunkIndex & chunkIndex,
 			  std::shared_ptr<PixelsBitMask> filterMask) override;
+    void skip(std::shared_ptr<ByteBuffer> input,
+              pixels::proto::ColumnEncoding & encoding,
+              int offset, int size, int pixelStride,
+              int vectorIndex, std::shared_ptr<ColumnVector> vector,
+              pixels::proto::ColumnChunkIndex & chunkIndex) override;
+    bool readAndFilter(std::shared_ptr<ByteBuffer> input,
+                       pixels::proto::ColumnEncoding & encoding,
+                       int offset, int size, int pixelStride,
+                       int vectorIndex, std::shared_ptr<ColumnVector> vector,
+                       pixels::proto::ColumnChunkIndex & chunkIndex,
+                       std::shared_ptr<PixelsBitMask> filterMask,
+                       duckdb::TableFilter & filter) override;
 
 private:
     /**
@@ -45,10 +57,20 @@ private:
 
 	int * dictStarts;
     int startsLength;
+    // the dictionary ids of the rows in the current batch
+    std::vector<int> dictIds;
+    // whether each dictionary entry of the current chunk satisfies dictFilter
+    std::vector<uint8_t> dictMatches;
+    duckdb::TableFilter * dictFilter;
+    // the dictionary of the current chunk for encoded column vectors, built on demand
+    std::shared_ptr<BinaryDictionary> dictionary;
     /**
      * In this method, we have reduced most of significant memory copies.
      */
     void readContent(std::shared_ptr<ByteBuffer> input,
                       uint32_t inputLength, pixels::proto::ColumnEncoding & encoding);
+    // decode the dictionary ids of the next size elements (including nulls) into dictIds
+    void readDictIds(pixels::proto::ColumnEncoding & encoding, int size);
+    std::shared_ptr<BinaryDictionary> getDictionary();
 };
 #endif //PIXELS_STRINGCOLUMNREADER_H
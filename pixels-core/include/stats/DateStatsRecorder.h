@@ -0,0 +1,48 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PIXELS_DATESTATSRECORDER_H
+#define PIXELS_DATESTATSRECORDER_H
+
+#include "stats/StatsRecorder.h"
+
+/**
+ * The statistics of date columns, the minimum and maximum are the days since the epoch.
+ */
+class DateStatsRecorder : public StatsRecorder {
+public:
+    DateStatsRecorder();
+    explicit DateStatsRecorder(const pixels::proto::ColumnStatistic& statistic);
+
+    void updateDate(int value) override;
+    void merge(const StatsRecorder& stats) override;
+    void reset() override;
+
+    int getMinimum() const;
+    int getMaximum() const;
+
+    pixels::proto::ColumnStatistic serialize() const override;
+
+private:
+    int minimum;
+    int maximum;
+    bool hasMinimum;
+};
+#endif // PIXELS_DATESTATSRECORDER_H
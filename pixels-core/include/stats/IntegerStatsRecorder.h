@@ -0,0 +1,52 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PIXELS_INTEGERSTATSRECORDER_H
+#define PIXELS_INTEGERSTATSRECORDER_H
+
+#include "stats/StatsRecorder.h"
+
+/**
+ * The statistics of short, int and long columns. The sum is not serialized once it overflows.
+ */
+class IntegerStatsRecorder : public StatsRecorder {
+public:
+    IntegerStatsRecorder();
+    explicit IntegerStatsRecorder(const pixels::proto::ColumnStatistic& statistic);
+
+    void updateInteger(long value, int repetitions) override;
+    void merge(const StatsRecorder& stats) override;
+    void reset() override;
+
+    long getMinimum() const;
+    long getMaximum() const;
+
+    pixels::proto::ColumnStatistic serialize() const override;
+
+private:
+    void addToSum(long value);
+
+    long minimum;
+    long maximum;
+    bool hasMinimum;
+    long sum;
+    bool overflow;
+};
+#endif // PIXELS_INTEGERSTATSRECORDER_H
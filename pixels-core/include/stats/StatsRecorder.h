@@ -48,6 +48,7 @@ public:
     virtual void updateFloat(float value);
     virtual void updateDouble(double value);
     virtual void updateString(const std::string& value, int repetitions);
+    virtual void updateString(const uint8_t* bytes, int length, int repetitions);
     virtual void updateBinary(const std::string& bytes, int repetitions);
     virtual void updateDate(int value);
     virtual void updateTime(int value);
@@ -55,8 +56,8 @@ public:
     virtual void updateVector();
 
     bool isStatsExists() const;
-    void merge(const StatsRecorder& stats);
-    void reset();
+    virtual void merge(const StatsRecorder& stats);
+    virtual void reset();
 
     long getNumberOfValues() const;
     bool hasNullValue() const;
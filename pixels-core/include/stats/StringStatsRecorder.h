@@ -0,0 +1,52 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PIXELS_STRINGSTATSRECORDER_H
+#define PIXELS_STRINGSTATSRECORDER_H
+
+#include "stats/StatsRecorder.h"
+#include <string>
+
+/**
+ * The statistics of string, varchar and char columns. The minimum and maximum are compared
+ * byte-wise, and the sum is the total length of the values.
+ */
+class StringStatsRecorder : public StatsRecorder {
+public:
+    StringStatsRecorder();
+    explicit StringStatsRecorder(const pixels::proto::ColumnStatistic& statistic);
+
+    void updateString(const std::string& value, int repetitions) override;
+    void updateString(const uint8_t* bytes, int length, int repetitions) override;
+    void merge(const StatsRecorder& stats) override;
+    void reset() override;
+
+    const std::string& getMinimum() const;
+    const std::string& getMaximum() const;
+
+    pixels::proto::ColumnStatistic serialize() const override;
+
+private:
+    std::string minimum;
+    std::string maximum;
+    bool hasMinimum;
+    long sum;
+};
+#endif // PIXELS_STRINGSTATSRECORDER_H
@@ -49,6 +49,12 @@ public:
 	                      const std::shared_ptr<ByteBuffer> &input);
 	void unrolledUnPack64(long *buffer, int offset, int len,
 	                      const std::shared_ptr<ByteBuffer> &input);
+    /**
+     * Unpack len big-endian bit-packed values of any width in [1, 64]. The kernel
+     * (BMI2, AVX2 or scalar) is chosen once by the features of the running CPU.
+     */
+    void unPack(long *buffer, int offset, int len, int bitSize,
+                const std::shared_ptr<ByteBuffer> &input);
     // -----------------------------------------------------------
     // encoding utils
     int encodeBitWidth(int n);
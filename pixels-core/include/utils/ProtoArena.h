@@ -0,0 +1,51 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PIXELS_PROTOARENA_H
+#define PIXELS_PROTOARENA_H
+
+#include <google/protobuf/arena.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+/**
+ * Parse a message on its own protobuf arena. The sub-messages, strings and repeated fields
+ * of the message are carved from a few arena blocks instead of a heap allocation each, and
+ * they are all freed at once when the last reference to the message is released.
+ *
+ * @return the parsed message, or nullptr if the data is not a valid message
+ */
+template <class T>
+std::shared_ptr<T> parseOnArena(const void * data, int length) {
+    google::protobuf::ArenaOptions options;
+    // the parsed message takes a few times the bytes of its serialized form
+    options.start_block_size = std::max<size_t>(options.start_block_size, 4 * (size_t) length);
+    options.max_block_size = std::max(options.max_block_size, options.start_block_size);
+    auto arena = std::make_shared<google::protobuf::Arena>(options);
+    T * message = google::protobuf::Arena::CreateMessage<T>(arena.get());
+    if(!message->ParseFromArray(data, length)) {
+        return nullptr;
+    }
+    // the message is owned by the arena, share the ownership of the arena instead
+    return std::shared_ptr<T>(arena, message);
+}
+
+#endif //PIXELS_PROTOARENA_H
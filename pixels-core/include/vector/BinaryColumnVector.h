@@ -9,6 +9,7 @@
 #include "vector/VectorizedRowBatch.h"
 #include "duckdb.h"
 #include "duckdb/common/types/vector.hpp"
+#include <vector>
 
 /**
  * BinaryColumnVector derived from org.apache.hadoop.hive.ql.exec.vector.
@@ -28,10 +29,30 @@
  * though that use is probably not typical.
  */
 
+/**
+ * The dictionary of a dictionary encoded column chunk. The last entry is reserved for null,
+ * and valid is the validity bitmap of the entries in the layout of duckdb.
+ */
+struct BinaryDictionary {
+    std::vector<duckdb::string_t> values;
+    std::vector<uint64_t> valid;
+    // the bytes of the values if the dictionary owns them, e.g., the copies in PixelsVectorCache
+    std::string content;
+};
+
 class BinaryColumnVector: public ColumnVector {
 public:
     duckdb::string_t * vector;
 
+    /**
+     * If isDictionary is true, the values are not materialized in vector. Instead,
+     * the value of element i is dictionary->values[dictIds[i]]. This is only used if
+     * the column vector is created with encoding = true.
+     */
+    bool isDictionary;
+    std::shared_ptr<BinaryDictionary> dictionary;
+    uint32_t * dictIds;
+
     /**
     * Use this constructor by default. All column vectors
     * should normally be the default size.
@@ -48,6 +69,8 @@ public:
      * @param length     length of source byte sequence
      */
     void setRef(int elementNum, uint8_t * const & sourceBuf, int start, int length);
+    void setDictionary(const std::shared_ptr<BinaryDictionary> & dictionary);
+    void setDictId(int elementNum, uint32_t id);
     void * current() override;
     void close() override;
     void print(int rowCount) override;
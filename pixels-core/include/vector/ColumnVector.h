@@ -35,6 +35,8 @@
  * structure that is used in the inner loop of query execution.
  */
 
+struct DecodedVector;
+
 class ColumnVector {
 public:
     /**
@@ -60,6 +62,12 @@ public:
 
     // DuckDB requires that the type of the valid mask should be uint64
     uint64_t * isValid;
+
+    /**
+     * If it is not nullptr, the values of this vector are not decoded into it. They are
+     * referenced from the decoded vector in PixelsVectorCache instead, starting from readIndex.
+     */
+    std::shared_ptr<DecodedVector> cachedVector;
     explicit ColumnVector(uint64_t len, bool encoding);
     void increment(uint64_t size);              // increment the readIndex
     bool isFull();                         // if the readIndex reaches length
@@ -35,6 +35,7 @@
 #include "PixelsFilter.h"
 #include "writer/PixelsWriterOption.h"
 #include "stats/StatsRecorder.h"
+#include "PixelIndex.h"
 
 
 class ColumnWriter{
@@ -54,6 +55,8 @@ public:
     virtual pixels::proto::ColumnChunkIndex getColumnChunkIndex();
     virtual std::shared_ptr<pixels::proto::ColumnChunkIndex> getColumnChunkIndexPtr();
     virtual pixels::proto::ColumnEncoding getColumnChunkEncoding();
+    // the statistics of the pixels written since the last reset
+    const StatsRecorder & getColumnChunkStatRecorder() const;
     virtual void reset();
     virtual void flush() ;
     virtual void close() ;
@@ -63,6 +66,8 @@ public:
 private:
     static const int ISNULL_ALIGNMENT;
     static const std::vector<uint8_t> ISNULL_PADDING_BUFFER;
+    // whether the pixel statistics are written as the columnar pixel index, see pixel.index.columnar
+    static const bool COLUMNAR_PIXEL_INDEX;
 
     std::shared_ptr<pixels::proto::ColumnChunkIndex> columnChunkIndex{};
     std::shared_ptr<pixels::proto::ColumnStatistic> columnChunkStat{};
@@ -71,6 +76,9 @@ private:
     int curPixelPosition = 0;
 
     std::shared_ptr<ByteBuffer> isNullStream;
+    // whether this column chunk uses the columnar pixel index, the other types keep the pixel statistics
+    bool columnarPixelIndex;
+    PixelIndex::Builder pixelIndexBuilder;
 protected:
     const int pixelStride;
     const EncodingLevel encodingLevel;
@@ -78,8 +86,8 @@ protected:
     std::shared_ptr<ByteBuffer> outputStream;
     int curPixelEleIndex = 0;
 //std::unique_ptr<Encoder> encoder;
-    StatsRecorder pixelStatRecorder;
-    StatsRecorder columnChunkStatRecorder;
+    std::unique_ptr<StatsRecorder> pixelStatRecorder;
+    std::unique_ptr<StatsRecorder> columnChunkStatRecorder;
 bool hasNull = false;
     const bool nullsPadding;
     int curPixelVectorIndex = 0;
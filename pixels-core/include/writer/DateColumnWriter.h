@@ -29,6 +29,7 @@
 #include "encoding/RunLenIntEncoder.h"
 
 class DateColumnWriter : public ColumnWriter{
+public:
     DateColumnWriter(std::shared_ptr<TypeDescription> type, std::shared_ptr<PixelsWriterOption> writerOption);
 
     int write(std::shared_ptr<ColumnVector> vector, int length) override;
@@ -36,7 +37,7 @@ class DateColumnWriter : public ColumnWriter{
     void newPixel() override;
     void writeCurPartTime(std::shared_ptr<ColumnVector> columnVector, int* values, int curPartLength, int curPartOffset);
     bool decideNullsPadding(std::shared_ptr<PixelsWriterOption> writerOption) override;
-    pixels::proto::ColumnEncoding getColumnChunkEncoding() const;
+    pixels::proto::ColumnEncoding getColumnChunkEncoding() override;
 
 private:
     bool runlengthEncoding;
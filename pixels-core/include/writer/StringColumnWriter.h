@@ -29,31 +29,49 @@
 #include "utils/DynamicIntArray.h"
 #include "utils/EncodingUtils.h"
 #include "encoding/RunLenIntEncoder.h"
+#include "encoding/HashTableDictionary.h"
+#include "vector/BinaryColumnVector.h"
 
 class StringColumnWriter : public ColumnWriter {
+public:
   StringColumnWriter(std::shared_ptr<TypeDescription> type,std::shared_ptr<PixelsWriterOption> writerOption);
 
   // vector should be converted to BinaryColumnVector
   int write(std::shared_ptr<ColumnVector> vector,int length) override;
   void close() override;
-  void newPixels() ;
+  void newPixel() override;
 
   bool decideNullsPadding(std::shared_ptr<PixelsWriterOption> writerOption) override;
 
-  void writeCurPartWithoutDict(std::shared_ptr<PixelsWriterOption> writerOption,uint8_t ** values,
-                               int* vLens,int* vOffsets,int curPartLength,int curPartOffset);
+  void writeCurPartWithDict(std::shared_ptr<BinaryColumnVector> columnVector,int curPartLength,int curPartOffset);
+
+  void writeCurPartWithoutDict(std::shared_ptr<BinaryColumnVector> columnVector,int curPartLength,int curPartOffset);
 
   void flush() override;
 
-  pixels::proto::ColumnEncoding getColumnChunkEncoding();
+  pixels::proto::ColumnEncoding getColumnChunkEncoding() override;
 
   void flushStarts();
 
+  void flushDictionary();
 
   private:
-    std::vector<long> curPixelVector;
+    /**
+     * Dictionary encoding is given up for a column chunk if the ratio of distinct
+     * values to non-null values in its first pixel exceeds this threshold.
+     */
+    static const double DICTIONARY_DISTINCT_RATIO_THRESHOLD;
+
+    // decide whether to keep dictionary encoding by the first pixel of the column chunk
+    void checkDictionaryEncoding();
+    void writeInts(long * values, int length);
+
+    std::vector<long> curPixelVector; // dictionary ids of the current pixel
+    int curPixelValueNum = 0;        // non-null values in the current pixel
     bool runlengthEncoding;
     bool dictionaryEncoding;
+    bool doneDictionaryEncodingCheck = false;
+    std::unique_ptr<HashTableDictionary> dictionary;
     std::shared_ptr<DynamicIntArray> startsArray;
     std::shared_ptr<EncodingUtils>  encodingUtils;
   std::unique_ptr<RunLenIntEncoder> encoder;
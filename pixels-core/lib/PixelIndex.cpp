@@ -0,0 +1,137 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "PixelIndex.h"
+#include "exception/InvalidArgumentException.h"
+#include <cstring>
+#include <limits>
+
+namespace {
+
+const size_t HEADER_SIZE = 2 * sizeof(uint32_t);
+
+template <class T>
+void appendArray(std::string & out, const std::vector<T> & values) {
+    out.append((const char *) values.data(), values.size() * sizeof(T));
+}
+
+}
+
+void PixelIndex::Builder::add(const pixels::proto::ColumnStatistic & statistic) {
+    int64_t minimum = std::numeric_limits<int64_t>::min();
+    int64_t maximum = std::numeric_limits<int64_t>::max();
+    if(statistic.has_intstatistics() && statistic.intstatistics().has_minimum()
+       && statistic.intstatistics().has_maximum()) {
+        minimum = statistic.intstatistics().minimum();
+        maximum = statistic.intstatistics().maximum();
+        hasMinMax = true;
+    } else if(statistic.has_datestatistics() && statistic.datestatistics().has_minimum()
+              && statistic.datestatistics().has_maximum()) {
+        minimum = statistic.datestatistics().minimum();
+        maximum = statistic.datestatistics().maximum();
+        hasMinMax = true;
+    } else if(statistic.has_timestampstatistics() && statistic.timestampstatistics().has_minimum()
+              && statistic.timestampstatistics().has_maximum()) {
+        minimum = statistic.timestampstatistics().minimum();
+        maximum = statistic.timestampstatistics().maximum();
+        hasMinMax = true;
+    }
+    minimums.push_back(minimum);
+    maximums.push_back(maximum);
+    numberOfValues.push_back((uint32_t) statistic.numberofvalues());
+    // the same default as the readers of the pixel statistics, a pixel without hasNull may contain nulls
+    hasNull.push_back(!statistic.has_hasnull() || statistic.hasnull());
+}
+
+std::string PixelIndex::Builder::build() const {
+    uint32_t header[2] = {(uint32_t) numberOfValues.size(), hasMinMax ? HAS_MIN_MAX : 0};
+    std::string out;
+    out.reserve(HEADER_SIZE + numberOfValues.size() * (2 * sizeof(int64_t) + sizeof(uint32_t) + 1));
+    out.append((const char *) header, HEADER_SIZE);
+    if(hasMinMax) {
+        appendArray(out, minimums);
+        appendArray(out, maximums);
+    }
+    appendArray(out, numberOfValues);
+    appendArray(out, hasNull);
+    return out;
+}
+
+void PixelIndex::Builder::reset() {
+    minimums.clear();
+    maximums.clear();
+    numberOfValues.clear();
+    hasNull.clear();
+    hasMinMax = false;
+}
+
+PixelIndex::PixelIndex(const pixels::proto::ColumnChunkIndex & chunkIndex) {
+    const std::string & index = chunkIndex.pixelindex();
+    if(index.size() < HEADER_SIZE) {
+        throw InvalidArgumentException("PixelIndex: the pixel index is truncated.");
+    }
+    const char * data = index.data();
+    uint32_t header[2];
+    std::memcpy(header, data, HEADER_SIZE);
+    pixelNum = (int) header[0];
+    size_t expected = HEADER_SIZE + pixelNum * (sizeof(uint32_t) + 1);
+    if(header[1] & HAS_MIN_MAX) {
+        expected += pixelNum * 2 * sizeof(int64_t);
+    }
+    if(index.size() != expected) {
+        throw InvalidArgumentException("PixelIndex: the pixel index is truncated.");
+    }
+    data += HEADER_SIZE;
+    if(header[1] & HAS_MIN_MAX) {
+        minimums.resize(pixelNum);
+        maximums.resize(pixelNum);
+        std::memcpy(minimums.data(), data, pixelNum * sizeof(int64_t));
+        data += pixelNum * sizeof(int64_t);
+        std::memcpy(maximums.data(), data, pixelNum * sizeof(int64_t));
+        data += pixelNum * sizeof(int64_t);
+    }
+    numberOfValues.resize(pixelNum);
+    std::memcpy(numberOfValues.data(), data, pixelNum * sizeof(uint32_t));
+    hasNulls = (const uint8_t *) data + pixelNum * sizeof(uint32_t);
+}
+
+bool PixelIndex::isSupported(TypeDescription::Category category) {
+    switch(category) {
+        case TypeDescription::SHORT:
+        case TypeDescription::INT:
+        case TypeDescription::LONG:
+        case TypeDescription::DATE:
+        case TypeDescription::TIMESTAMP:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool PixelIndex::hasNull(const pixels::proto::ColumnChunkIndex & chunkIndex, int pixelId) {
+    if(!chunkIndex.has_pixelindex()) {
+        return chunkIndex.pixelstatistics(pixelId).statistic().hasnull();
+    }
+    // hasNull is the last array, so it is addressed from the end without checking the header
+    const std::string & index = chunkIndex.pixelindex();
+    uint32_t pixelNum;
+    std::memcpy(&pixelNum, index.data(), sizeof(uint32_t));
+    return index[index.size() - pixelNum + pixelId] != 0;
+}
@@ -55,6 +55,10 @@ void PixelsBitMask::set() {
     memset(mask, 255, arrayLength);
 }
 
+void PixelsBitMask::clear() {
+    memset(mask, 0, arrayLength);
+}
+
 void PixelsBitMask::set(long index, uint8_t value) {
     assert(index < maskLength);
     uint8_t & byteMask = mask[index / 8];
@@ -74,6 +78,38 @@ uint8_t PixelsBitMask::get(long index) {
     return bool(byteMask & shiftMask);
 }
 
+long PixelsBitMask::nextSetBit(long from, long to) {
+    long index = from;
+    while (index < to) {
+        // skip the whole byte if none of its bits is set
+        if (index % 8 == 0 && mask[index / 8] == 0) {
+            index += 8;
+            continue;
+        }
+        if (get(index)) {
+            return index;
+        }
+        index++;
+    }
+    return to;
+}
+
+long PixelsBitMask::nextClearBit(long from, long to) {
+    long index = from;
+    while (index < to) {
+        // skip the whole byte if all of its bits are set
+        if (index % 8 == 0 && mask[index / 8] == 0xFF) {
+            index += 8;
+            continue;
+        }
+        if (!get(index)) {
+            return index;
+        }
+        index++;
+    }
+    return to;
+}
+
 void PixelsBitMask::Or(long index, uint8_t value) {
     if(value == 1) {
         assert(index < maskLength);
@@ -96,4 +132,21 @@ void PixelsBitMask::setByteAligned(long index, uint8_t value) {
     mask[index / 8] = value;
 }
 
+void PixelsBitMask::setRange(long from, long to, uint8_t value) {
+    assert(to <= maskLength);
+    long index = from;
+    for (; index < to && index % 8 != 0; index++) {
+        set(index, value);
+    }
+    // fill the whole bytes in the middle
+    long bytes = (to - index) / 8;
+    if (bytes > 0) {
+        memset(mask + index / 8, value == 0 ? 0 : 255, bytes);
+        index += bytes * 8;
+    }
+    for (; index < to; index++) {
+        set(index, value);
+    }
+}
+
 
@@ -0,0 +1,181 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "PixelsChunkCache.h"
+#include "exception/InvalidArgumentException.h"
+#include "utils/ConfigFactory.h"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+namespace {
+
+// the expected size of a chunk to size the frequency sketch by the capacity
+const uint64_t EXPECTED_CHUNK_SIZE = 16 * 1024;
+
+uint64_t hashOf(const std::string & id) {
+    // mix the bits, as the shard and the sketch counters are picked by different bits of the hash
+    uint64_t hash = std::hash<std::string>()(id);
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+}
+
+PixelsChunkCache::PixelsChunkCache(uint64_t capacity, int shardNum) {
+    if(shardNum <= 0) {
+        throw InvalidArgumentException("PixelsChunkCache: the number of shards must be positive.");
+    }
+    shardCapacity = capacity / shardNum;
+    sketchWidth = 256;
+    while(sketchWidth < shardCapacity / EXPECTED_CHUNK_SIZE) {
+        sketchWidth <<= 1;
+    }
+    for(int i = 0; i < shardNum; i++) {
+        shards.emplace_back(std::make_unique<Shard>());
+        shards.back()->sketch.assign(SKETCH_DEPTH * sketchWidth, 0);
+    }
+}
+
+std::shared_ptr<PixelsChunkCache> PixelsChunkCache::Instance() {
+    static std::shared_ptr<PixelsChunkCache> instance = []() -> std::shared_ptr<PixelsChunkCache> {
+        uint64_t capacity = std::stoull(ConfigFactory::Instance().getProperty("chunk.cache.capacity"));
+        if(capacity == 0) {
+            return nullptr;
+        }
+        return std::make_shared<PixelsChunkCache>(
+                capacity, std::stoi(ConfigFactory::Instance().getProperty("chunk.cache.shards")));
+    }();
+    return instance;
+}
+
+std::string PixelsChunkCache::getChunkId(const std::string & fileId, int rowGroupId, int columnId) {
+    return fileId + "-" + std::to_string(rowGroupId) + "-" + std::to_string(columnId);
+}
+
+PixelsChunkCache::Shard & PixelsChunkCache::getShard(uint64_t hash) {
+    return *shards[(hash >> 48) % shards.size()];
+}
+
+void PixelsChunkCache::recordAccess(Shard & shard, uint64_t hash) {
+    uint64_t step = (hash >> 32) | 1;
+    for(int i = 0; i < SKETCH_DEPTH; i++) {
+        uint8_t & counter = shard.sketch[i * sketchWidth + ((hash + i * step) & (sketchWidth - 1))];
+        if(counter < MAX_FREQUENCY) {
+            counter++;
+        }
+    }
+    // age the frequencies, so that the chunks that were hot long ago can be evicted
+    if(++shard.accesses >= 10 * sketchWidth) {
+        for(auto & counter : shard.sketch) {
+            counter >>= 1;
+        }
+        shard.accesses /= 2;
+    }
+}
+
+uint8_t PixelsChunkCache::getFrequency(Shard & shard, uint64_t hash) const {
+    uint64_t step = (hash >> 32) | 1;
+    uint8_t frequency = MAX_FREQUENCY;
+    for(int i = 0; i < SKETCH_DEPTH; i++) {
+        frequency = std::min(frequency, shard.sketch[i * sketchWidth + ((hash + i * step) & (sketchWidth - 1))]);
+    }
+    return frequency;
+}
+
+std::shared_ptr<ByteBuffer> PixelsChunkCache::find(const std::string & id) {
+    uint64_t hash = hashOf(id);
+    Shard & shard = getShard(hash);
+    std::shared_ptr<ByteBuffer> chunk;
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        recordAccess(shard, hash);
+        auto it = shard.entries.find(id);
+        if(it == shard.entries.end()) {
+            return nullptr;
+        }
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lruPosition);
+        chunk = it->second.chunk;
+    }
+    // the view keeps the cached chunk alive even if it is evicted meanwhile
+    return std::shared_ptr<ByteBuffer>(new ByteBuffer(*chunk, 0, chunk->size()),
+                                       [chunk](ByteBuffer * view) { delete view; });
+}
+
+bool PixelsChunkCache::put(const std::string & id, const uint8_t * data, uint64_t length) {
+    if(length == 0 || length > shardCapacity) {
+        return false;
+    }
+    uint64_t hash = hashOf(id);
+    Shard & shard = getShard(hash);
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if(shard.entries.count(id) > 0) {
+            return true;
+        }
+        // admit the chunk only if it is accessed more often than each chunk it evicts
+        uint8_t frequency = getFrequency(shard, hash);
+        uint64_t freed = 0;
+        auto victim = shard.lru.rbegin();
+        while(shard.bytes - freed + length > shardCapacity) {
+            if(getFrequency(shard, hashOf(*victim)) >= frequency) {
+                return false;
+            }
+            freed += shard.entries.at(*victim).chunk->size();
+            victim++;
+        }
+        while(freed > 0) {
+            auto it = shard.entries.find(shard.lru.back());
+            freed -= it->second.chunk->size();
+            shard.bytes -= it->second.chunk->size();
+            shard.entries.erase(it);
+            shard.lru.pop_back();
+        }
+    }
+    // copy outside of the lock, another thread may cache the same chunk meanwhile
+    auto chunk = std::make_shared<ByteBuffer>((uint32_t) length);
+    std::memcpy(chunk->getPointer(), data, length);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if(shard.entries.count(id) > 0) {
+        return true;
+    }
+    shard.lru.push_front(id);
+    shard.entries[id] = Entry{std::move(chunk), shard.lru.begin()};
+    shard.bytes += length;
+    // the other threads may have filled the shard while copying
+    while(shard.bytes > shardCapacity && shard.lru.size() > 1) {
+        auto it = shard.entries.find(shard.lru.back());
+        shard.bytes -= it->second.chunk->size();
+        shard.entries.erase(it);
+        shard.lru.pop_back();
+    }
+    return true;
+}
+
+uint64_t PixelsChunkCache::getSize() {
+    uint64_t size = 0;
+    for(auto & shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        size += shard->bytes;
+    }
+    return size;
+}
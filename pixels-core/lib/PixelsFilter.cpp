@@ -16,6 +16,9 @@ int PixelsFilter::CompareAvx2(void * data, T constant) {
         if constexpr(std::is_same<OP, duckdb::Equals>()) {
             mask = _mm256_cmpeq_epi32(vector, constants);
             return _mm256_movemask_ps((__m256)mask);
+        } else if constexpr(std::is_same<OP, duckdb::NotEquals>()) {
+            mask = _mm256_cmpeq_epi32(vector, constants);
+            return ~_mm256_movemask_ps((__m256)mask);
         } else if constexpr(std::is_same<OP, duckdb::LessThan>()) {
             mask = _mm256_cmpgt_epi32(constants, vector);
             return _mm256_movemask_ps((__m256)mask);
@@ -40,6 +43,12 @@ int PixelsFilter::CompareAvx2(void * data, T constant) {
             mask = _mm256_cmpeq_epi64(vector_next, constants);
             result += _mm256_movemask_pd((__m256d)mask) << 4;
             return result;
+        } else if constexpr(std::is_same<OP, duckdb::NotEquals>()) {
+            mask = _mm256_cmpeq_epi64(vector, constants);
+            result = _mm256_movemask_pd((__m256d)mask);
+            mask = _mm256_cmpeq_epi64(vector_next, constants);
+            result += _mm256_movemask_pd((__m256d)mask) << 4;
+            return ~result;
         } else if constexpr(std::is_same<OP, duckdb::LessThan>()) {
             mask = _mm256_cmpgt_epi64(constants, vector);
             result = _mm256_movemask_pd((__m256d)mask);
@@ -123,6 +132,21 @@ void PixelsFilter::TemplatedFilterOperation(std::shared_ptr<ColumnVector> vector
             }
             break;
         }
+        case TypeDescription::TIMESTAMP: {
+            auto timestampColumnVector = std::static_pointer_cast<TimestampColumnVector>(vector);
+            int i = 0;
+#ifdef ENABLE_SIMD_FILTER
+            for (; i < vector->length - vector->length % 8; i += 8) {
+                uint8_t mask = CompareAvx2<T, OP>(timestampColumnVector->times + i, constant_value);
+                filter_mask.setByteAligned(i, mask);
+            }
+#endif
+            for (; i < vector->length; i++) {
+                filter_mask.set(i, OP::Operation((T)timestampColumnVector->times[i],
+                                                                 constant_value));
+            }
+            break;
+        }
         case TypeDescription::DECIMAL: {
             auto decimalColumnVector = std::static_pointer_cast<DecimalColumnVector>(vector);
             int i = 0;
@@ -145,6 +169,11 @@ void PixelsFilter::TemplatedFilterOperation(std::shared_ptr<ColumnVector> vector
         case TypeDescription::VARCHAR: {
             auto binaryColumnVector = std::static_pointer_cast<BinaryColumnVector>(vector);
             for (int i = 0; i < vector->length; i++) {
+                // the strings of the null rows and the rows cleared in the mask are not decoded
+                if (!filter_mask.get(i) || !vector->checkValid(i)) {
+                    filter_mask.set(i, false);
+                    continue;
+                }
                 filter_mask.set(i, OP::Operation((duckdb::string_t)binaryColumnVector->vector[i],
                                                                  (duckdb::string_t)constant_value));
             }
@@ -167,6 +196,7 @@ void PixelsFilter::FilterOperationSwitch(std::shared_ptr<ColumnVector> vector, d
             TemplatedFilterOperation<int32_t, OP>(vector, constant, filter_mask, type);
             break;
         case TypeDescription::LONG:
+        case TypeDescription::TIMESTAMP:
             TemplatedFilterOperation<int64_t, OP>(vector, constant, filter_mask, type);
             break;
         case TypeDescription::DECIMAL:
@@ -184,6 +214,376 @@ void PixelsFilter::FilterOperationSwitch(std::shared_ptr<ColumnVector> vector, d
     }
 }
 
+template <class T>
+bool PixelsFilter::CheckRange(duckdb::ExpressionType comparison, const T &min, const T &max, const T &constant) {
+    switch (comparison) {
+        case duckdb::ExpressionType::COMPARE_EQUAL:
+            return !(constant < min) && !(max < constant);
+        case duckdb::ExpressionType::COMPARE_NOTEQUAL:
+            return !(min == constant && max == constant);
+        case duckdb::ExpressionType::COMPARE_LESSTHAN:
+            return min < constant;
+        case duckdb::ExpressionType::COMPARE_LESSTHANOREQUALTO:
+            return !(constant < min);
+        case duckdb::ExpressionType::COMPARE_GREATERTHAN:
+            return constant < max;
+        case duckdb::ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+            return !(max < constant);
+        default:
+            return true;
+    }
+}
+
+template <class T>
+bool PixelsFilter::CheckRangeAll(duckdb::ExpressionType comparison, const T &min, const T &max, const T &constant) {
+    switch (comparison) {
+        case duckdb::ExpressionType::COMPARE_EQUAL:
+            return min == constant && max == constant;
+        case duckdb::ExpressionType::COMPARE_NOTEQUAL:
+            return constant < min || max < constant;
+        case duckdb::ExpressionType::COMPARE_LESSTHAN:
+            return max < constant;
+        case duckdb::ExpressionType::COMPARE_LESSTHANOREQUALTO:
+            return !(constant < max);
+        case duckdb::ExpressionType::COMPARE_GREATERTHAN:
+            return constant < min;
+        case duckdb::ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+            return !(min < constant);
+        default:
+            return false;
+    }
+}
+
+// the constant of a comparison filter in the representation of the bounds
+static void GetConstant(const duckdb::Value &constant, const std::shared_ptr<TypeDescription> &type, int64_t &value) {
+    switch (type->getCategory()) {
+        case TypeDescription::DATE:
+            value = constant.GetValueUnsafe<int32_t>();
+            break;
+        case TypeDescription::TIMESTAMP:
+            value = constant.GetValueUnsafe<int64_t>();
+            break;
+        default:
+            value = constant.GetValue<int64_t>();
+            break;
+    }
+}
+
+static void GetConstant(const duckdb::Value &constant, const std::shared_ptr<TypeDescription> &type, std::string &value) {
+    value = duckdb::StringValue::Get(constant);
+}
+
+template <class T>
+PixelsFilter::BoundsMatch PixelsFilter::CheckBounds(duckdb::TableFilter &filter, const T &min, const T &max,
+                                                    const std::shared_ptr<TypeDescription> &type) {
+    switch (filter.filter_type) {
+        case duckdb::TableFilterType::CONJUNCTION_AND: {
+            auto &conjunction = (duckdb::ConjunctionAndFilter &)filter;
+            BoundsMatch result = ALL_MATCH;
+            for (auto &childFilter : conjunction.child_filters) {
+                BoundsMatch childResult = CheckBounds<T>(*childFilter, min, max, type);
+                if (childResult == NONE_MATCH) {
+                    return NONE_MATCH;
+                }
+                if (childResult == SOME_MATCH) {
+                    result = SOME_MATCH;
+                }
+            }
+            return result;
+        }
+        case duckdb::TableFilterType::CONJUNCTION_OR: {
+            auto &conjunction = (duckdb::ConjunctionOrFilter &)filter;
+            BoundsMatch result = NONE_MATCH;
+            for (auto &childFilter : conjunction.child_filters) {
+                BoundsMatch childResult = CheckBounds<T>(*childFilter, min, max, type);
+                if (childResult == ALL_MATCH) {
+                    return ALL_MATCH;
+                }
+                if (childResult == SOME_MATCH) {
+                    result = SOME_MATCH;
+                }
+            }
+            return result;
+        }
+        case duckdb::TableFilterType::CONSTANT_COMPARISON: {
+            auto &constantFilter = (duckdb::ConstantFilter &)filter;
+            auto comparison = constantFilter.comparison_type;
+            T constant;
+            GetConstant(constantFilter.constant, type, constant);
+            if (!CheckRange<T>(comparison, min, max, constant)) {
+                return NONE_MATCH;
+            }
+            return CheckRangeAll<T>(comparison, min, max, constant) ? ALL_MATCH : SOME_MATCH;
+        }
+        case duckdb::TableFilterType::IS_NULL:
+            return NONE_MATCH;
+        case duckdb::TableFilterType::IS_NOT_NULL:
+            return ALL_MATCH;
+        default:
+            // the values are checked one by one by ApplyFilter
+            return SOME_MATCH;
+    }
+}
+
+bool PixelsFilter::MatchesNull(duckdb::TableFilter &filter) {
+    switch (filter.filter_type) {
+        case duckdb::TableFilterType::CONJUNCTION_AND: {
+            auto &conjunction = (duckdb::ConjunctionAndFilter &)filter;
+            for (auto &childFilter : conjunction.child_filters) {
+                if (!MatchesNull(*childFilter)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case duckdb::TableFilterType::CONJUNCTION_OR: {
+            auto &conjunction = (duckdb::ConjunctionOrFilter &)filter;
+            for (auto &childFilter : conjunction.child_filters) {
+                if (MatchesNull(*childFilter)) {
+                    return true;
+                }
+            }
+            return conjunction.child_filters.empty();
+        }
+        case duckdb::TableFilterType::CONSTANT_COMPARISON:
+            // a comparison with null is never true
+        case duckdb::TableFilterType::IS_NOT_NULL:
+            return false;
+        default:
+            return true;
+    }
+}
+
+void PixelsFilter::ApplyNulls(const std::shared_ptr<ColumnVector> &vector, PixelsBitMask &filterMask, bool match) {
+    auto *isValid = (const uint8_t *) vector->isValid;
+    long length = std::min<long>(filterMask.maskLength, vector->length);
+    for (long i = 0; i < (length + 7) / 8; i++) {
+        uint8_t nulls = ~isValid[i];
+        if (i == length / 8) {
+            // the bits after the last row are not touched
+            nulls &= (uint8_t) ((1 << (length % 8)) - 1);
+        }
+        if (match) {
+            filterMask.mask[i] |= nulls;
+        } else {
+            filterMask.mask[i] &= ~nulls;
+        }
+    }
+}
+
+template PixelsFilter::BoundsMatch PixelsFilter::CheckBounds<int64_t>(
+        duckdb::TableFilter &filter, const int64_t &min, const int64_t &max,
+        const std::shared_ptr<TypeDescription> &type);
+template PixelsFilter::BoundsMatch PixelsFilter::CheckBounds<std::string>(
+        duckdb::TableFilter &filter, const std::string &min, const std::string &max,
+        const std::shared_ptr<TypeDescription> &type);
+
+bool PixelsFilter::CheckStatistics(const pixels::proto::ColumnStatistic &stats, duckdb::TableFilter &filter,
+                                   const std::shared_ptr<TypeDescription> &type) {
+    // numberOfValues only counts the non-null values, it is only trusted when hasNull agrees with it,
+    // as files written before the writers recorded the statistics have numberOfValues = 0 everywhere
+    bool allNull = stats.has_numberofvalues() && stats.numberofvalues() == 0 &&
+                   stats.has_hasnull() && stats.hasnull();
+    switch (filter.filter_type) {
+        case duckdb::TableFilterType::CONJUNCTION_AND: {
+            auto &conjunction = (duckdb::ConjunctionAndFilter &)filter;
+            for (auto &childFilter : conjunction.child_filters) {
+                if (!CheckStatistics(stats, *childFilter, type)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case duckdb::TableFilterType::CONJUNCTION_OR: {
+            auto &conjunction = (duckdb::ConjunctionOrFilter &)filter;
+            for (auto &childFilter : conjunction.child_filters) {
+                if (CheckStatistics(stats, *childFilter, type)) {
+                    return true;
+                }
+            }
+            return conjunction.child_filters.empty();
+        }
+        case duckdb::TableFilterType::IS_NULL:
+            return !stats.has_hasnull() || stats.hasnull();
+        case duckdb::TableFilterType::IS_NOT_NULL:
+            return !allNull;
+        case duckdb::TableFilterType::CONSTANT_COMPARISON: {
+            if (allNull) {
+                // a comparison with null is never true
+                return false;
+            }
+            auto &constantFilter = (duckdb::ConstantFilter &)filter;
+            auto &constant = constantFilter.constant;
+            auto comparison = constantFilter.comparison_type;
+            switch (type->getCategory()) {
+                case TypeDescription::SHORT:
+                case TypeDescription::INT:
+                case TypeDescription::LONG: {
+                    if (!stats.has_intstatistics()) {
+                        return true;
+                    }
+                    auto &intStats = stats.intstatistics();
+                    return CheckRange<int64_t>(comparison, intStats.minimum(), intStats.maximum(),
+                                               constant.GetValue<int64_t>());
+                }
+                case TypeDescription::DATE: {
+                    if (!stats.has_datestatistics()) {
+                        return true;
+                    }
+                    // both the statistic and duckdb date are the days from 1970-1-1
+                    auto &dateStats = stats.datestatistics();
+                    return CheckRange<int32_t>(comparison, dateStats.minimum(), dateStats.maximum(),
+                                               constant.GetValueUnsafe<int32_t>());
+                }
+                case TypeDescription::TIMESTAMP: {
+                    if (!stats.has_timestampstatistics()) {
+                        return true;
+                    }
+                    // the statistic is in the same unit as the values in the column chunk
+                    auto &tsStats = stats.timestampstatistics();
+                    return CheckRange<int64_t>(comparison, tsStats.minimum(), tsStats.maximum(),
+                                               constant.GetValueUnsafe<int64_t>());
+                }
+                case TypeDescription::STRING:
+                case TypeDescription::VARCHAR:
+                case TypeDescription::CHAR: {
+                    if (!stats.has_stringstatistics()) {
+                        return true;
+                    }
+                    auto &stringStats = stats.stringstatistics();
+                    if (!stringStats.has_minimum() || !stringStats.has_maximum()) {
+                        return true;
+                    }
+                    // std::string compares byte-wise, which is consistent with duckdb string_t
+                    return CheckRange<std::string>(comparison, stringStats.minimum(), stringStats.maximum(),
+                                                   duckdb::StringValue::Get(constant));
+                }
+                default:
+                    return true;
+            }
+        }
+        default:
+            return true;
+    }
+}
+
+// the same checks as CheckRange, branch-free over the pixels so that the compiler vectorizes them
+static void CheckPixelRanges(duckdb::ExpressionType comparison, const int64_t *mins, const int64_t *maxs,
+                             int64_t constant, uint8_t *matches, int pixelNum) {
+    switch (comparison) {
+        case duckdb::ExpressionType::COMPARE_EQUAL:
+            for (int i = 0; i < pixelNum; i++) {
+                matches[i] &= (mins[i] <= constant) & (constant <= maxs[i]);
+            }
+            break;
+        case duckdb::ExpressionType::COMPARE_NOTEQUAL:
+            for (int i = 0; i < pixelNum; i++) {
+                matches[i] &= (mins[i] != constant) | (maxs[i] != constant);
+            }
+            break;
+        case duckdb::ExpressionType::COMPARE_LESSTHAN:
+            for (int i = 0; i < pixelNum; i++) {
+                matches[i] &= mins[i] < constant;
+            }
+            break;
+        case duckdb::ExpressionType::COMPARE_LESSTHANOREQUALTO:
+            for (int i = 0; i < pixelNum; i++) {
+                matches[i] &= mins[i] <= constant;
+            }
+            break;
+        case duckdb::ExpressionType::COMPARE_GREATERTHAN:
+            for (int i = 0; i < pixelNum; i++) {
+                matches[i] &= constant < maxs[i];
+            }
+            break;
+        case duckdb::ExpressionType::COMPARE_GREATERTHANOREQUALTO:
+            for (int i = 0; i < pixelNum; i++) {
+                matches[i] &= constant <= maxs[i];
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void PixelsFilter::CheckPixelIndex(const PixelIndex &index, duckdb::TableFilter &filter,
+                                   const std::shared_ptr<TypeDescription> &type, uint8_t *matches) {
+    int pixelNum = index.getPixelNum();
+    const uint32_t *numberOfValues = index.getNumberOfValues();
+    const uint8_t *hasNull = index.getHasNull();
+    switch (filter.filter_type) {
+        case duckdb::TableFilterType::CONJUNCTION_AND: {
+            auto &conjunction = (duckdb::ConjunctionAndFilter &)filter;
+            for (auto &childFilter : conjunction.child_filters) {
+                CheckPixelIndex(index, *childFilter, type, matches);
+            }
+            return;
+        }
+        case duckdb::TableFilterType::CONJUNCTION_OR: {
+            auto &conjunction = (duckdb::ConjunctionOrFilter &)filter;
+            if (conjunction.child_filters.empty()) {
+                return;
+            }
+            std::vector<uint8_t> anyMatches(pixelNum, 0);
+            std::vector<uint8_t> childMatches(pixelNum);
+            for (auto &childFilter : conjunction.child_filters) {
+                std::fill(childMatches.begin(), childMatches.end(), 1);
+                CheckPixelIndex(index, *childFilter, type, childMatches.data());
+                for (int i = 0; i < pixelNum; i++) {
+                    anyMatches[i] |= childMatches[i];
+                }
+            }
+            for (int i = 0; i < pixelNum; i++) {
+                matches[i] &= anyMatches[i];
+            }
+            return;
+        }
+        case duckdb::TableFilterType::IS_NULL:
+            for (int i = 0; i < pixelNum; i++) {
+                matches[i] &= hasNull[i];
+            }
+            return;
+        case duckdb::TableFilterType::IS_NOT_NULL:
+            // a pixel is all-null only if hasNull agrees with numberOfValues, see CheckStatistics
+            for (int i = 0; i < pixelNum; i++) {
+                matches[i] &= (numberOfValues[i] != 0) | (hasNull[i] == 0);
+            }
+            return;
+        case duckdb::TableFilterType::CONSTANT_COMPARISON: {
+            // a comparison with null is never true
+            for (int i = 0; i < pixelNum; i++) {
+                matches[i] &= (numberOfValues[i] != 0) | (hasNull[i] == 0);
+            }
+            if (!index.hasMinMax()) {
+                return;
+            }
+            auto &constantFilter = (duckdb::ConstantFilter &)filter;
+            auto &constant = constantFilter.constant;
+            int64_t value;
+            switch (type->getCategory()) {
+                case TypeDescription::SHORT:
+                case TypeDescription::INT:
+                case TypeDescription::LONG:
+                    value = constant.GetValue<int64_t>();
+                    break;
+                case TypeDescription::DATE:
+                    value = constant.GetValueUnsafe<int32_t>();
+                    break;
+                case TypeDescription::TIMESTAMP:
+                    value = constant.GetValueUnsafe<int64_t>();
+                    break;
+                default:
+                    return;
+            }
+            CheckPixelRanges(constantFilter.comparison_type, index.getMinimums(), index.getMaximums(),
+                             value, matches, pixelNum);
+            return;
+        }
+        default:
+            return;
+    }
+}
+
 void PixelsFilter::ApplyFilter(std::shared_ptr<ColumnVector> vector, duckdb::TableFilter &filter,
                                PixelsBitMask& filterMask,
                                std::shared_ptr<TypeDescription> type) {
@@ -215,6 +615,10 @@ void PixelsFilter::ApplyFilter(std::shared_ptr<ColumnVector> vector, duckdb::Tab
                     FilterOperationSwitch<duckdb::Equals>(
                             vector, constant_filter.constant, filterMask, type);
                     break;
+                case duckdb::ExpressionType::COMPARE_NOTEQUAL:
+                    FilterOperationSwitch<duckdb::NotEquals>(
+                            vector, constant_filter.constant, filterMask, type);
+                    break;
                 case duckdb::ExpressionType::COMPARE_LESSTHAN:
                     FilterOperationSwitch<duckdb::LessThan>(
                             vector, constant_filter.constant, filterMask, type);
@@ -232,19 +636,28 @@ void PixelsFilter::ApplyFilter(std::shared_ptr<ColumnVector> vector, duckdb::Tab
                             vector, constant_filter.constant, filterMask, type);
                     break;
                 default:
-                    D_ASSERT(0);
+                    // the filter is pushed down, so it must not be dropped silently
+                    throw InvalidArgumentException("PixelsFilter: unsupported comparison " +
+                                                   std::to_string((int) constant_filter.comparison_type));
             }
+            // the values of the null rows are padding, and a comparison with null is never true
+            ApplyNulls(vector, filterMask, false);
             break;
         }
         case duckdb::TableFilterType::IS_NOT_NULL:
-            // TODO: support is null
+            ApplyNulls(vector, filterMask, false);
             break;
-        case duckdb::TableFilterType::IS_NULL:
-            // TODO: support is null
+        case duckdb::TableFilterType::IS_NULL: {
+            auto *isValid = (const uint8_t *) vector->isValid;
+            long length = std::min<long>(filterMask.maskLength, vector->length);
+            for (long i = 0; i < (length + 7) / 8; i++) {
+                filterMask.mask[i] &= ~isValid[i];
+            }
             break;
+        }
         default:
-            D_ASSERT(0);
-            break;
+            throw InvalidArgumentException("PixelsFilter: unsupported filter type " +
+                                           std::to_string((int) filter.filter_type));
     }
 }
 
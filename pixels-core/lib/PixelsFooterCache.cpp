@@ -3,40 +3,119 @@
 //
 #include "PixelsFooterCache.h"
 #include "exception/InvalidArgumentException.h"
+#include "utils/ConfigFactory.h"
+#include <functional>
 
-PixelsFooterCache::PixelsFooterCache() {
+PixelsFooterCache::PixelsFooterCache(uint64_t capacity, int shardNum) {
+    if(shardNum <= 0) {
+        throw InvalidArgumentException("PixelsFooterCache: the number of shards must be positive.");
+    }
+    for(int i = 0; i < shardNum; i++) {
+        shards.emplace_back(std::make_unique<Shard>());
+    }
+    shardCapacity = capacity / shardNum;
+}
+
+std::shared_ptr<PixelsFooterCache> PixelsFooterCache::Instance() {
+    static std::shared_ptr<PixelsFooterCache> instance = std::make_shared<PixelsFooterCache>(
+            std::stoull(ConfigFactory::Instance().getProperty("footer.cache.capacity")),
+            std::stoi(ConfigFactory::Instance().getProperty("footer.cache.shards")));
+    return instance;
+}
+
+std::string PixelsFooterCache::getFileId(const std::shared_ptr<PhysicalReader> & reader) {
+    return getFileId(reader->getPath(), reader->getFileLength(), reader->getLastModified());
+}
+
+std::string PixelsFooterCache::getFileId(const std::string & path, uint64_t fileLength, int64_t lastModified) {
+    return path + "@" + std::to_string(fileLength) + "@" + std::to_string(lastModified);
+}
+
+PixelsFooterCache::Shard & PixelsFooterCache::getShard(const std::string& id) {
+    return *shards[std::hash<std::string>()(id) % shards.size()];
+}
+
+void PixelsFooterCache::put(const std::string& id, std::shared_ptr<google::protobuf::Message> value) {
+    // the memory of the parsed message, the key and the bookkeeping of the entry
+    uint64_t bytes = value->SpaceUsedLong() + 2 * id.size() + sizeof(Entry);
+    Shard & shard = getShard(id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.entries.find(id);
+    if(it != shard.entries.end()) {
+        shard.bytes -= it->second.bytes;
+        shard.lru.erase(it->second.lruPosition);
+        shard.entries.erase(it);
+    }
+    shard.lru.push_front(id);
+    shard.entries[id] = Entry{std::move(value), bytes, shard.lru.begin()};
+    shard.bytes += bytes;
+    // evict the least recently used entries, but always keep the new one
+    while(shard.bytes > shardCapacity && shard.lru.size() > 1) {
+        auto victim = shard.entries.find(shard.lru.back());
+        shard.bytes -= victim->second.bytes;
+        shard.entries.erase(victim);
+        shard.lru.pop_back();
+    }
+}
+
+std::shared_ptr<google::protobuf::Message> PixelsFooterCache::find(const std::string& id) {
+    Shard & shard = getShard(id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.entries.find(id);
+    if(it == shard.entries.end()) {
+        return nullptr;
+    }
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lruPosition);
+    return it->second.value;
 }
 
 void PixelsFooterCache::putFileTail(const std::string& id, std::shared_ptr<FileTail> fileTail) {
-    fileTailCacheMap[id] = fileTail;
+    put(id, std::move(fileTail));
+}
+
+std::shared_ptr<FileTail> PixelsFooterCache::findFileTail(const std::string& id) {
+    return std::static_pointer_cast<FileTail>(find(id));
 }
 
 std::shared_ptr<FileTail> PixelsFooterCache::getFileTail(const std::string& id) {
-    if(fileTailCacheMap.find(id) != fileTailCacheMap.end()) {
-        return fileTailCacheMap[id];
+    std::shared_ptr<FileTail> fileTail = findFileTail(id);
+    if(fileTail != nullptr) {
+        return fileTail;
     } else {
         throw InvalidArgumentException("No such a FileTail id.");
     }
 }
 
 void PixelsFooterCache::putRGFooter(const std::string& id, std::shared_ptr<RowGroupFooter> footer) {
-    rowGroupFooterCacheMap[id] = footer;
+    put(id, std::move(footer));
 }
 
 bool PixelsFooterCache::containsFileTail(const std::string &id) {
-    return fileTailCacheMap.find(id) != fileTailCacheMap.end();
+    return findFileTail(id) != nullptr;
+}
+
+std::shared_ptr<RowGroupFooter> PixelsFooterCache::findRGFooter(const std::string& id) {
+    return std::static_pointer_cast<RowGroupFooter>(find(id));
 }
 
 std::shared_ptr<RowGroupFooter> PixelsFooterCache::getRGFooter(const std::string& id) {
-    if(rowGroupFooterCacheMap.find(id) != rowGroupFooterCacheMap.end()) {
-        return rowGroupFooterCacheMap[id];
+    std::shared_ptr<RowGroupFooter> footer = findRGFooter(id);
+    if(footer != nullptr) {
+        return footer;
     } else {
         throw InvalidArgumentException("No such a RGFooter id.");
     }
 }
 
 bool PixelsFooterCache::containsRGFooter(const std::string &id) {
-    return rowGroupFooterCacheMap.find(id) != rowGroupFooterCacheMap.end();
+    return findRGFooter(id) != nullptr;
 }
 
-
+uint64_t PixelsFooterCache::getSize() {
+    uint64_t size = 0;
+    for(auto & shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        size += shard->bytes;
+    }
+    return size;
+}
@@ -0,0 +1,258 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "PixelsFooterPrefetcher.h"
+#include "PixelsReaderBuilder.h"
+#include "utils/ConfigFactory.h"
+#include "utils/ThreadPool.h"
+#include "utils/ProtoArena.h"
+#include "liburing.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <future>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+struct TailRead {
+    int fileIndex;
+    std::string path;
+    int fd;
+    uint64_t fileLength;
+    int64_t lastModified;
+    // the number of bytes read from the end of the file
+    uint64_t readLength;
+};
+
+// parse the FileTail from the last readLength bytes of the file in buffer
+std::shared_ptr<pixels::proto::FileTail> parseFileTail(const TailRead & read, const uint8_t * buffer) {
+    long lastLong;
+    std::memcpy(&lastLong, buffer + read.readLength - sizeof(long), sizeof(long));
+    long fileTailOffset = PixelsReaderBuilder::getFileTailOffset(lastLong);
+    if(fileTailOffset < 0 || fileTailOffset + sizeof(long) >= read.fileLength) {
+        return nullptr;
+    }
+    uint64_t fileTailLength = read.fileLength - fileTailOffset - sizeof(long);
+    const uint8_t * fileTailData = buffer + read.readLength - sizeof(long) - fileTailLength;
+    std::vector<uint8_t> fileTailBuffer;
+    if(fileTailLength + sizeof(long) > read.readLength) {
+        // the tail is larger than the prefetched bytes, read the whole tail
+        fileTailBuffer.resize(fileTailLength);
+        if(pread(read.fd, fileTailBuffer.data(), fileTailLength, fileTailOffset) != (ssize_t) fileTailLength) {
+            return nullptr;
+        }
+        fileTailData = fileTailBuffer.data();
+    }
+    return parseOnArena<pixels::proto::FileTail>(fileTailData, (int) fileTailLength);
+}
+
+// parse the tail read into buffer, and put it into the cache
+void storeFileTail(const TailRead & read, const uint8_t * buffer,
+                   std::vector<std::shared_ptr<pixels::proto::FileTail>> & fileTails,
+                   const std::shared_ptr<PixelsFooterCache> & footerCache) {
+    std::shared_ptr<pixels::proto::FileTail> fileTail = parseFileTail(read, buffer);
+    if(fileTail != nullptr && footerCache != nullptr) {
+        footerCache->putFileTail(PixelsFooterCache::getFileId(
+                read.path, read.fileLength, read.lastModified), fileTail);
+    }
+    fileTails[read.fileIndex] = fileTail;
+}
+
+// @return whether the last readLength bytes of the file are read into buffer
+bool preadTail(const TailRead & read, uint8_t * buffer) {
+    uint64_t done = 0;
+    while(done < read.readLength) {
+        ssize_t ret = pread(read.fd, buffer + done, read.readLength - done,
+                            read.fileLength - read.readLength + done);
+        if(ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if(ret <= 0) {
+            return false;
+        }
+        done += ret;
+    }
+    return true;
+}
+
+// the parsers are shared by the prefetches of all the scans
+ThreadPool & ParserPool() {
+    static ThreadPool pool(0);
+    return pool;
+}
+
+// the files of the tails to read, closed when the prefetch returns or throws
+struct TailReads {
+    std::vector<TailRead> reads;
+    ~TailReads() {
+        for(auto & read : reads) {
+            ::close(read.fd);
+        }
+    }
+};
+
+// the ring is exited when the prefetch returns or throws
+struct Ring {
+    struct io_uring ring;
+    bool initialized = false;
+    ~Ring() {
+        if(initialized) {
+            io_uring_queue_exit(&ring);
+        }
+    }
+};
+
+// the tasks submitted to the parsers, which use the buffers and the files of the prefetch,
+// so they are waited before those are freed even if the prefetch throws
+struct ParserTasks {
+    std::vector<std::future<void>> tasks;
+    // rethrow the exception of a task
+    void getAll() {
+        for(auto & task : tasks) {
+            task.get();
+        }
+        tasks.clear();
+    }
+    ~ParserTasks() {
+        for(auto & task : tasks) {
+            if(task.valid()) {
+                task.wait();
+            }
+        }
+    }
+};
+
+// read and parse the tails by pread on the parsers, when io_uring is not used or not available
+void prefetchByPread(const std::vector<TailRead> & reads,
+                     std::vector<std::shared_ptr<pixels::proto::FileTail>> & fileTails,
+                     const std::shared_ptr<PixelsFooterCache> & footerCache) {
+    ParserTasks reading;
+    for(const TailRead & read : reads) {
+        reading.tasks.emplace_back(ParserPool().submit([&read, &fileTails, &footerCache]() {
+            std::vector<uint8_t> buffer(read.readLength);
+            // leave it to the reader, which reports the error if the file is really corrupt
+            if(preadTail(read, buffer.data())) {
+                storeFileTail(read, buffer.data(), fileTails, footerCache);
+            }
+        }));
+    }
+    reading.getAll();
+}
+
+}
+
+std::vector<std::shared_ptr<pixels::proto::FileTail>> PixelsFooterPrefetcher::prefetch(
+        const std::vector<std::string> & files, const std::shared_ptr<PixelsFooterCache> & footerCache) {
+    std::vector<std::shared_ptr<pixels::proto::FileTail>> fileTails(files.size());
+    uint64_t prefetchSize = std::stoull(ConfigFactory::Instance().getProperty("footer.prefetch.size"));
+    int depth = std::stoi(ConfigFactory::Instance().getProperty("footer.prefetch.depth"));
+    if(prefetchSize < sizeof(long) || depth <= 0) {
+        throw InvalidArgumentException("PixelsFooterPrefetcher: footer.prefetch.size must be at least 8 "
+                                       "and footer.prefetch.depth must be positive.");
+    }
+
+    TailReads tailReads;
+    std::vector<TailRead> & reads = tailReads.reads;
+    for(int i = 0; i < files.size(); i++) {
+        std::string path = files[i];
+        if(path.rfind("file://", 0) == 0) {
+            path.erase(0, 7);
+        }
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0) {
+            continue;
+        }
+        struct stat st;
+        if(fstat(fd, &st) != 0 || st.st_size < (off_t) sizeof(long)) {
+            ::close(fd);
+            continue;
+        }
+        reads.push_back(TailRead{i, path, fd, (uint64_t) st.st_size,
+                                 st.st_mtim.tv_sec * 1000000000L + st.st_mtim.tv_nsec,
+                                 std::min<uint64_t>(prefetchSize, st.st_size)});
+        const TailRead & read = reads.back();
+        if(footerCache != nullptr) {
+            fileTails[i] = footerCache->findFileTail(
+                    PixelsFooterCache::getFileId(read.path, read.fileLength, read.lastModified));
+        }
+        if(fileTails[i] != nullptr) {
+            ::close(fd);
+            reads.pop_back();
+        }
+    }
+    if(reads.empty()) {
+        return fileTails;
+    }
+
+    // double buffered, the tails of a batch are parsed while the next batch is being read
+    std::vector<std::vector<uint8_t>> buffers[2];
+    // declared after the buffers, so the ring is exited before the buffers are freed
+    Ring ring;
+    // the kernel may have no io_uring, or seccomp may block it
+    if(ConfigFactory::Instance().getProperty("localfs.async.lib") != "iouring" ||
+       io_uring_queue_init(depth, &ring.ring, 0) < 0) {
+        prefetchByPread(reads, fileTails, footerCache);
+        return fileTails;
+    }
+    ring.initialized = true;
+    ParserTasks parsing[2];
+    int batch = 0;
+    for(int batchStart = 0; batchStart < reads.size(); batchStart += depth, batch ^= 1) {
+        parsing[batch].getAll();
+        int batchSize = std::min<int>(depth, (int) reads.size() - batchStart);
+        buffers[batch].resize(batchSize);
+        for(int i = 0; i < batchSize; i++) {
+            const TailRead & read = reads[batchStart + i];
+            buffers[batch][i].resize(read.readLength);
+            struct io_uring_sqe * sqe = io_uring_get_sqe(&ring.ring);
+            io_uring_prep_read(sqe, read.fd, buffers[batch][i].data(), read.readLength,
+                               read.fileLength - read.readLength);
+            io_uring_sqe_set_data(sqe, (void *) (uintptr_t) i);
+        }
+        if(io_uring_submit(&ring.ring) != batchSize) {
+            throw std::runtime_error("PixelsFooterPrefetcher: failed to submit the reads.");
+        }
+        for(int i = 0; i < batchSize; i++) {
+            struct io_uring_cqe * cqe;
+            if(io_uring_wait_cqe(&ring.ring, &cqe) < 0) {
+                throw std::runtime_error("PixelsFooterPrefetcher: failed to wait for the reads.");
+            }
+            int index = (int) (uintptr_t) io_uring_cqe_get_data(cqe);
+            int res = cqe->res;
+            io_uring_cqe_seen(&ring.ring, cqe);
+            const TailRead & read = reads[batchStart + index];
+            if(res != (int) read.readLength) {
+                // leave it to the reader, which reports the error if the file is really corrupt
+                continue;
+            }
+            const uint8_t * buffer = buffers[batch][index].data();
+            parsing[batch].tasks.emplace_back(ParserPool().submit([&read, buffer, &fileTails, &footerCache]() {
+                storeFileTail(read, buffer, fileTails, footerCache);
+            }));
+        }
+    }
+    for(auto & tasks : parsing) {
+        tasks.getAll();
+    }
+    return fileTails;
+}
@@ -0,0 +1,234 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "PixelsManifest.h"
+#include "PixelsReaderBuilder.h"
+#include "physical/StorageFactory.h"
+#include "physical/PhysicalReaderUtil.h"
+#include "utils/ProtoArena.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const std::string PixelsManifest::FILE_NAME = ".pxl-manifest";
+
+namespace {
+
+std::string removeScheme(const std::string & path) {
+    if(path.rfind("file://", 0) == 0) {
+        return path.substr(7);
+    }
+    return path;
+}
+
+// the same length and modification time as reported by PhysicalLocalReader
+bool statFile(const std::string & path, uint64_t & fileLength, int64_t & lastModified) {
+    struct stat st;
+    if(stat(path.c_str(), &st) != 0) {
+        return false;
+    }
+    fileLength = st.st_size;
+    lastModified = st.st_mtim.tv_sec * 1000000000L + st.st_mtim.tv_nsec;
+    return true;
+}
+
+std::string joinPath(const std::string & directory, const std::string & fileName) {
+    if(!directory.empty() && directory.back() == '/') {
+        return directory + fileName;
+    }
+    return directory + "/" + fileName;
+}
+
+// the directory of the path, empty if the path has no directory
+std::string getParentPath(const std::string & path) {
+    size_t slash = path.rfind('/');
+    if(slash == std::string::npos) {
+        return "";
+    }
+    return slash == 0 ? "/" : path.substr(0, slash);
+}
+
+std::string getFileName(const std::string & path) {
+    size_t slash = path.rfind('/');
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+std::string getManifestPath(const std::string & directory) {
+    return joinPath(removeScheme(directory), PixelsManifest::FILE_NAME);
+}
+
+}
+
+PixelsManifest::PixelsManifest(std::shared_ptr<pixels::proto::Manifest> manifest) {
+    this->manifest = std::move(manifest);
+    for(int i = 0; i < this->manifest->entries_size(); i++) {
+        entryIndex[this->manifest->entries(i).filename()] = i;
+    }
+}
+
+std::shared_ptr<PixelsManifest> PixelsManifest::open(const std::string & directory) {
+    std::string path = getManifestPath(directory);
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0) {
+        return nullptr;
+    }
+    struct stat st;
+    if(fstat(fd, &st) != 0 || st.st_size == 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    void * data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if(data == MAP_FAILED) {
+        return nullptr;
+    }
+    auto manifest = parseOnArena<pixels::proto::Manifest>(data, (int) st.st_size);
+    munmap(data, st.st_size);
+    if(manifest == nullptr) {
+        std::cerr << "PixelsManifest: ignore the corrupt manifest " << path << std::endl;
+        return nullptr;
+    }
+    return std::shared_ptr<PixelsManifest>(new PixelsManifest(manifest));
+}
+
+std::shared_ptr<PixelsManifest> PixelsManifest::refresh(const std::string & directory) {
+    std::string dir = removeScheme(directory);
+    std::vector<std::string> fileNames;
+    DIR * dirp = opendir(dir.c_str());
+    if(dirp == nullptr) {
+        throw std::runtime_error("PixelsManifest: failed to open " + dir + ": " + strerror(errno));
+    }
+    const std::string suffix = ".pxl";
+    while(struct dirent * entry = readdir(dirp)) {
+        std::string fileName = entry->d_name;
+        if(fileName.size() <= suffix.size() ||
+           fileName.compare(fileName.size() - suffix.size(), suffix.size(), suffix) != 0) {
+            continue;
+        }
+        // d_type is DT_UNKNOWN on some file systems
+        struct stat st;
+        if(stat(joinPath(dir, fileName).c_str(), &st) == 0 && S_ISREG(st.st_mode)) {
+            fileNames.push_back(fileName);
+        }
+    }
+    closedir(dirp);
+    std::sort(fileNames.begin(), fileNames.end());
+
+    std::shared_ptr<PixelsManifest> old = open(dir);
+    auto manifest = std::make_shared<pixels::proto::Manifest>();
+    auto storage = StorageFactory::getInstance()->getStorage(::Storage::file);
+    int reused = 0;
+    for(const auto & fileName : fileNames) {
+        std::string path = joinPath(dir, fileName);
+        const pixels::proto::ManifestEntry * oldEntry = old != nullptr ? old->findValidEntry(path) : nullptr;
+        if(oldEntry != nullptr) {
+            *manifest->add_entries() = *oldEntry;
+            reused++;
+            continue;
+        }
+        std::shared_ptr<PhysicalReader> reader = PhysicalReaderUtil::newPhysicalReader(storage, path);
+        pixels::proto::ManifestEntry * entry = manifest->add_entries();
+        entry->set_filename(fileName);
+        entry->set_filelength(reader->getFileLength());
+        entry->set_lastmodified(reader->getLastModified());
+        *entry->mutable_filetail() = *PixelsReaderBuilder::readFileTail(reader);
+        reader->close();
+    }
+
+    // write to a temporary file first, so that the readers never see a partial manifest
+    std::string path = getManifestPath(dir);
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if(!out.is_open() || !manifest->SerializeToOstream(&out)) {
+            throw std::runtime_error("PixelsManifest: failed to write " + tmpPath);
+        }
+    }
+    if(::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("PixelsManifest: failed to rename " + tmpPath + ": " + strerror(errno));
+    }
+    std::cout << "PixelsManifest: " << fileNames.size() << " files in " << path
+              << ", " << (fileNames.size() - reused) << " of them are updated" << std::endl;
+    return std::shared_ptr<PixelsManifest>(new PixelsManifest(manifest));
+}
+
+std::vector<std::shared_ptr<pixels::proto::FileTail>> PixelsManifest::getFileTails(
+        const std::vector<std::string> & files, const std::shared_ptr<PixelsFooterCache> & footerCache) {
+    std::vector<std::shared_ptr<pixels::proto::FileTail>> fileTails(files.size());
+    std::unordered_map<std::string, std::shared_ptr<PixelsManifest>> manifests;
+    for(int i = 0; i < files.size(); i++) {
+        std::string path = removeScheme(files[i]);
+        std::string directory = getParentPath(path);
+        auto it = manifests.find(directory);
+        if(it == manifests.end()) {
+            it = manifests.emplace(directory, open(directory.empty() ? "." : directory)).first;
+        }
+        if(it->second == nullptr) {
+            continue;
+        }
+        const pixels::proto::ManifestEntry * entry = it->second->findValidEntry(path);
+        if(entry == nullptr) {
+            continue;
+        }
+        // share the tail with the manifest instead of copying it
+        fileTails[i] = std::shared_ptr<pixels::proto::FileTail>(
+                it->second->manifest, const_cast<pixels::proto::FileTail *>(&entry->filetail()));
+        if(footerCache != nullptr) {
+            footerCache->putFileTail(PixelsFooterCache::getFileId(
+                    path, entry->filelength(), entry->lastmodified()), fileTails[i]);
+        }
+    }
+    return fileTails;
+}
+
+const pixels::proto::ManifestEntry * PixelsManifest::findValidEntry(const std::string & path) const {
+    auto it = entryIndex.find(getFileName(path));
+    if(it == entryIndex.end()) {
+        return nullptr;
+    }
+    const pixels::proto::ManifestEntry & entry = manifest->entries(it->second);
+    uint64_t fileLength;
+    int64_t lastModified;
+    if(!statFile(path, fileLength, lastModified) ||
+       fileLength != entry.filelength() || lastModified != entry.lastmodified()) {
+        return nullptr;
+    }
+    return &entry;
+}
+
+std::shared_ptr<pixels::proto::FileTail> PixelsManifest::getFileTail(const std::string & path) {
+    const pixels::proto::ManifestEntry * entry = findValidEntry(removeScheme(path));
+    if(entry == nullptr) {
+        return nullptr;
+    }
+    return std::shared_ptr<pixels::proto::FileTail>(
+            manifest, const_cast<pixels::proto::FileTail *>(&entry->filetail()));
+}
+
+int PixelsManifest::getFileNum() const {
+    return manifest->entries_size();
+}
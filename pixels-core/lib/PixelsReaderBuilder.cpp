@@ -3,6 +3,7 @@
 //
 
 #include "PixelsReaderBuilder.h"
+#include "utils/ProtoArena.h"
 
 PixelsReaderBuilder::PixelsReaderBuilder() {
     builderPath = "";
@@ -32,39 +33,21 @@ std::shared_ptr<PixelsReader> PixelsReaderBuilder::build() {
     // get PhysicalReader
     std::shared_ptr<PhysicalReader> fsReader =
 	    PhysicalReaderUtil::newPhysicalReader(builderStorage, builderPath);
+    if(fsReader.get() == nullptr) {
+        throw PixelsReaderException(
+                "Failed to create PixelsReader due to error of creating PhysicalReader");
+    }
     // try to get file tail from cache
-    std::string fileName = fsReader->getName();
     std::shared_ptr<pixels::proto::FileTail> fileTail;
-    if(builderPixelsFooterCache != nullptr && builderPixelsFooterCache->containsFileTail(fileName)) {
-        fileTail = builderPixelsFooterCache->getFileTail(fileName);
-    } else {
-        if(fsReader.get() == nullptr) {
-            throw PixelsReaderException(
-                    "Failed to create PixelsReader due to error of creating PhysicalReader");
-        }
-        // get FileTail
-        long fileLen = fsReader->getFileLength();
-        std::cout<<"filelen: "<<fsReader->getFileLength()<<std::endl;
-        fsReader->seek(fileLen - (long)sizeof(long));
-		long SmallEndianFileTailOffset = fsReader->readLong();
-        long BigEndianFileTailOffset=(long)__builtin_bswap64(SmallEndianFileTailOffset);
-        long fileTailOffset=0;
-        if(SmallEndianFileTailOffset<0){
-            fileTailOffset=BigEndianFileTailOffset;
-        }else{
-            fileTailOffset=SmallEndianFileTailOffset;
-        }
-        std::cout<<"fileTailOffset: "<<fileTailOffset<<std::endl;
-        int fileTailLength = (int) (fileLen - fileTailOffset - sizeof(long));
-        fsReader->seek(fileTailOffset);
-        std::shared_ptr<ByteBuffer> fileTailBuffer = fsReader->readFully(fileTailLength);
-		fileTail = std::make_shared<pixels::proto::FileTail>();
-        if(!fileTail->ParseFromArray(fileTailBuffer->getPointer(),
-                                    fileTailLength)) {
-            throw InvalidArgumentException("PixelsReaderBuilder::build: paring FileTail error!");
-        }
+    std::string fileId;
+    if(builderPixelsFooterCache != nullptr) {
+        fileId = PixelsFooterCache::getFileId(fsReader);
+        fileTail = builderPixelsFooterCache->findFileTail(fileId);
+    }
+    if(fileTail == nullptr) {
+        fileTail = readFileTail(fsReader);
 		if(builderPixelsFooterCache != nullptr) {
-			builderPixelsFooterCache->putFileTail(fileName, fileTail);
+			builderPixelsFooterCache->putFileTail(fileId, fileTail);
 		}
     }
 
@@ -82,7 +65,8 @@ std::shared_ptr<PixelsReader> PixelsReaderBuilder::build() {
 
 	auto fileColTypes = std::vector<std::shared_ptr<pixels::proto::Type>>{};
 	for(const auto& type : fileTail->footer().types()) {
-		fileColTypes.emplace_back(std::make_shared<pixels::proto::Type>(type));
+		// share the types with the file tail instead of copying them
+		fileColTypes.emplace_back(fileTail, const_cast<pixels::proto::Type *>(&type));
 	}
 	builderSchema = TypeDescription::createSchema(fileColTypes);
 
@@ -92,4 +76,31 @@ std::shared_ptr<PixelsReader> PixelsReaderBuilder::build() {
 	                                         builderPixelsFooterCache);
 }
 
+std::shared_ptr<pixels::proto::FileTail> PixelsReaderBuilder::readFileTail(const std::shared_ptr<PhysicalReader> & fsReader) {
+    long fileLen = fsReader->getFileLength();
+    std::cout<<"filelen: "<<fsReader->getFileLength()<<std::endl;
+    fsReader->seek(fileLen - (long)sizeof(long));
+    long fileTailOffset = getFileTailOffset(fsReader->readLong());
+    std::cout<<"fileTailOffset: "<<fileTailOffset<<std::endl;
+    int fileTailLength = (int) (fileLen - fileTailOffset - sizeof(long));
+    fsReader->seek(fileTailOffset);
+    std::shared_ptr<ByteBuffer> fileTailBuffer = fsReader->readFully(fileTailLength);
+	std::shared_ptr<pixels::proto::FileTail> fileTail =
+	        parseOnArena<pixels::proto::FileTail>(fileTailBuffer->getPointer(), fileTailLength);
+    if(fileTail == nullptr) {
+        throw InvalidArgumentException("PixelsReaderBuilder::build: paring FileTail error!");
+    }
+    return fileTail;
+}
 
+long PixelsReaderBuilder::getFileTailOffset(long lastLong) {
+    long SmallEndianFileTailOffset = lastLong;
+    long BigEndianFileTailOffset=(long)__builtin_bswap64(SmallEndianFileTailOffset);
+    long fileTailOffset=0;
+    if(SmallEndianFileTailOffset<0){
+        fileTailOffset=BigEndianFileTailOffset;
+    }else{
+        fileTailOffset=SmallEndianFileTailOffset;
+    }
+    return fileTailOffset;
+}
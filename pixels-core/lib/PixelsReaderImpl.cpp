@@ -7,11 +7,10 @@
 PixelsReaderImpl::PixelsReaderImpl(std::shared_ptr<TypeDescription> fileSchema,
                                    std::shared_ptr<PhysicalReader> reader,
                                    std::shared_ptr<pixels::proto::FileTail> fileTail,
-                                   std::shared_ptr<PixelsFooterCache> footerCache) {
+                                   std::shared_ptr<PixelsFooterCache> footerCache)
+        : fileTail(fileTail), postScript(fileTail->postscript()), footer(fileTail->footer()) {
 	this->fileSchema = fileSchema;
 	this->physicalReader = reader;
-	this->footer = fileTail->footer();
-	this->postScript = fileTail->postscript();
 	this->pixelsFooterCache = footerCache;
 	this->closed = false;
 }
@@ -27,8 +26,7 @@ std::shared_ptr<PixelsRecordReader> PixelsReaderImpl::read(PixelsReaderOption op
     // TODO: add a function parameter, and the code before creating PixelsRecordReaderImpl
 	std::shared_ptr<PixelsRecordReader> recordReader =
 	    std::make_shared<PixelsRecordReaderImpl>(
-            physicalReader, postScript,
-            footer, option, pixelsFooterCache);
+            physicalReader, fileSchema, fileTail, option, pixelsFooterCache);
     recordReaders.emplace_back(recordReader);
     return recordReader;
 }
@@ -88,14 +86,14 @@ RowGroupInfoList PixelsReaderImpl::getRowGroupInfos() {
 }
 
 pixels::proto::RowGroupInformation PixelsReaderImpl::getRowGroupInfo(int rowGroupId) {
-	if(rowGroupId < 0 || rowGroupId >= footer.columnstats_size()) {
+	if(rowGroupId < 0 || rowGroupId >= footer.rowgroupinfos_size()) {
 		throw InvalidArgumentException("row group id is out of bound.");
 	}
 	return footer.rowgroupinfos().Get(rowGroupId);
 }
 
 pixels::proto::RowGroupStatistic PixelsReaderImpl::getRowGroupStat(int rowGroupId) {
-	if(rowGroupId < 0 || rowGroupId >= footer.columnstats_size()) {
+	if(rowGroupId < 0 || rowGroupId >= footer.rowgroupstats_size()) {
 		throw InvalidArgumentException("row group id is out of bound.");
 	}
 	return footer.rowgroupstats().Get(rowGroupId);
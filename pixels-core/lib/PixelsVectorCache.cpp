@@ -0,0 +1,258 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "PixelsVectorCache.h"
+#include "exception/InvalidArgumentException.h"
+#include "utils/ConfigFactory.h"
+#include "utils/String.h"
+#include "vector/DateColumnVector.h"
+#include "vector/DecimalColumnVector.h"
+#include "vector/LongColumnVector.h"
+#include "vector/TimestampColumnVector.h"
+#include <cstring>
+#include <functional>
+#include <sstream>
+
+namespace {
+
+std::shared_ptr<BinaryDictionary> copyDictionary(const BinaryDictionary & dictionary) {
+    auto copy = std::make_shared<BinaryDictionary>();
+    size_t length = 0;
+    for(const auto & value : dictionary.values) {
+        length += value.GetSize();
+    }
+    // the strings are copied as a whole before they are referenced, so the content is not reallocated
+    copy->content.resize(length);
+    copy->values.reserve(dictionary.values.size());
+    size_t position = 0;
+    for(const auto & value : dictionary.values) {
+        std::memcpy(&copy->content[position], value.GetData(), value.GetSize());
+        copy->values.emplace_back(copy->content.data() + position, value.GetSize());
+        position += value.GetSize();
+    }
+    copy->valid = dictionary.valid;
+    return copy;
+}
+
+std::string trim(const std::string & value) {
+    size_t start = value.find_first_not_of(" \t");
+    if(start == std::string::npos) {
+        return "";
+    }
+    return value.substr(start, value.find_last_not_of(" \t") - start + 1);
+}
+
+}
+
+std::shared_ptr<DecodedVector> DecodedVector::copyOf(
+        const std::shared_ptr<ColumnVector> & vector, TypeDescription::Category category, int size,
+        std::pair<std::shared_ptr<BinaryDictionary>, std::shared_ptr<BinaryDictionary>> & copiedDictionary) {
+    const void * values;
+    size_t width;
+    std::shared_ptr<BinaryDictionary> dictionary;
+    switch(category) {
+        case TypeDescription::SHORT:
+        case TypeDescription::INT:
+        case TypeDescription::LONG: {
+            auto longVector = std::static_pointer_cast<LongColumnVector>(vector);
+            // the integers are stored as int32 by the integer column reader
+            values = longVector->isLongVectore() ? (void *) longVector->longVector : (void *) longVector->intVector;
+            width = longVector->isLongVectore() ? sizeof(int64_t) : sizeof(int32_t);
+            break;
+        }
+        case TypeDescription::DATE:
+            values = std::static_pointer_cast<DateColumnVector>(vector)->dates;
+            width = sizeof(int32_t);
+            break;
+        case TypeDescription::DECIMAL:
+            values = std::static_pointer_cast<DecimalColumnVector>(vector)->vector;
+            width = sizeof(int64_t);
+            break;
+        case TypeDescription::TIMESTAMP:
+            values = std::static_pointer_cast<TimestampColumnVector>(vector)->times;
+            width = sizeof(int64_t);
+            break;
+        case TypeDescription::STRING:
+        case TypeDescription::CHAR:
+        case TypeDescription::VARCHAR: {
+            // the materialized strings refer to the column chunk, which is reused for the next row group
+            auto binaryVector = std::static_pointer_cast<BinaryColumnVector>(vector);
+            if(!binaryVector->isDictionary) {
+                return nullptr;
+            }
+            if(copiedDictionary.first != binaryVector->dictionary) {
+                copiedDictionary = {binaryVector->dictionary, copyDictionary(*binaryVector->dictionary)};
+            }
+            values = binaryVector->dictIds;
+            width = sizeof(uint32_t);
+            dictionary = copiedDictionary.second;
+            break;
+        }
+        default:
+            return nullptr;
+    }
+    if(values == nullptr) {
+        return nullptr;
+    }
+    auto decoded = std::make_shared<DecodedVector>();
+    decoded->values = std::unique_ptr<uint8_t[]>(new uint8_t[size * width]);
+    std::memcpy(decoded->values.get(), values, size * width);
+    decoded->valid.assign(vector->isValid, vector->isValid + (size + 63) / 64);
+    decoded->dictionary = dictionary;
+    decoded->bytes = size * width + decoded->valid.size() * sizeof(uint64_t);
+    if(dictionary != nullptr) {
+        // the dictionary is shared by the vectors of the chunk, but it is counted in each of them
+        decoded->bytes += dictionary->content.size() + dictionary->values.size() * sizeof(duckdb::string_t)
+                + dictionary->valid.size() * sizeof(uint64_t);
+    }
+    return decoded;
+}
+
+PixelsVectorCache::PixelsVectorCache(uint64_t capacity, int shardNum, const std::string & cachedColumns,
+                                     const std::string & pinnedColumns) {
+    if(shardNum <= 0) {
+        throw InvalidArgumentException("PixelsVectorCache: the number of shards must be positive.");
+    }
+    shardCapacity = capacity / shardNum;
+    for(int i = 0; i < shardNum; i++) {
+        shards.emplace_back(std::make_unique<Shard>());
+    }
+    this->cachedColumns = parseColumns(cachedColumns);
+    this->pinnedColumns = parseColumns(pinnedColumns);
+}
+
+std::shared_ptr<PixelsVectorCache> PixelsVectorCache::Instance() {
+    static std::shared_ptr<PixelsVectorCache> instance = []() -> std::shared_ptr<PixelsVectorCache> {
+        ConfigFactory & config = ConfigFactory::Instance();
+        uint64_t capacity = std::stoull(config.getProperty("vector.cache.capacity"));
+        if(capacity == 0) {
+            return nullptr;
+        }
+        return std::make_shared<PixelsVectorCache>(
+                capacity, std::stoi(config.getProperty("vector.cache.shards")),
+                config.getProperty("vector.cache.columns"), config.getProperty("vector.cache.pinned.columns"));
+    }();
+    return instance;
+}
+
+std::string PixelsVectorCache::getVectorId(const std::string & fileId, int rowGroupId, int columnId,
+                                           int startRow, int size) {
+    return fileId + "-" + std::to_string(rowGroupId) + "-" + std::to_string(columnId) + "-"
+           + std::to_string(startRow) + "-" + std::to_string(size);
+}
+
+std::vector<PixelsVectorCache::ColumnPattern> PixelsVectorCache::parseColumns(const std::string & columns) {
+    std::vector<ColumnPattern> patterns;
+    std::stringstream stream(columns);
+    std::string item;
+    while(std::getline(stream, item, ',')) {
+        item = trim(item);
+        if(item.empty()) {
+            continue;
+        }
+        size_t dot = item.find('.');
+        if(dot == std::string::npos) {
+            patterns.push_back(ColumnPattern{"", item});
+        } else {
+            patterns.push_back(ColumnPattern{item.substr(0, dot), item.substr(dot + 1)});
+        }
+    }
+    return patterns;
+}
+
+bool PixelsVectorCache::matches(const std::vector<ColumnPattern> & patterns, const std::string & filePath,
+                                const std::string & columnName) {
+    for(const auto & pattern : patterns) {
+        if(!icompare(pattern.column, columnName)) {
+            continue;
+        }
+        if(pattern.table.empty() || filePath.find("/" + pattern.table + "/") != std::string::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool PixelsVectorCache::isCached(const std::string & filePath, const std::string & columnName) const {
+    return cachedColumns.empty() || matches(cachedColumns, filePath, columnName)
+           || isPinned(filePath, columnName);
+}
+
+bool PixelsVectorCache::isPinned(const std::string & filePath, const std::string & columnName) const {
+    return matches(pinnedColumns, filePath, columnName);
+}
+
+PixelsVectorCache::Shard & PixelsVectorCache::getShard(const std::string & id) {
+    return *shards[std::hash<std::string>()(id) % shards.size()];
+}
+
+std::shared_ptr<DecodedVector> PixelsVectorCache::find(const std::string & id) {
+    Shard & shard = getShard(id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.entries.find(id);
+    if(it == shard.entries.end()) {
+        return nullptr;
+    }
+    if(!it->second.pinned) {
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lruPosition);
+    }
+    return it->second.vector;
+}
+
+bool PixelsVectorCache::put(const std::string & id, std::shared_ptr<DecodedVector> vector, bool pinned) {
+    if(vector->bytes > shardCapacity) {
+        return false;
+    }
+    Shard & shard = getShard(id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if(shard.entries.count(id) > 0) {
+        return true;
+    }
+    // the pinned vectors can not be evicted, so the other vectors must make room for the new one
+    if(shard.pinnedBytes + vector->bytes > shardCapacity) {
+        return false;
+    }
+    while(shard.bytes + vector->bytes > shardCapacity) {
+        auto it = shard.entries.find(shard.lru.back());
+        shard.bytes -= it->second.vector->bytes;
+        shard.entries.erase(it);
+        shard.lru.pop_back();
+    }
+    shard.bytes += vector->bytes;
+    if(pinned) {
+        shard.pinnedBytes += vector->bytes;
+    }
+    Entry entry{std::move(vector), pinned, shard.lru.end()};
+    if(!pinned) {
+        shard.lru.push_front(id);
+        entry.lruPosition = shard.lru.begin();
+    }
+    shard.entries[id] = std::move(entry);
+    return true;
+}
+
+uint64_t PixelsVectorCache::getSize() {
+    uint64_t size = 0;
+    for(auto & shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        size += shard->bytes;
+    }
+    return size;
+}
@@ -34,6 +34,7 @@
 #include "reader/PixelsRecordReader.h"
 #include "physical/PhysicalReader.h"
 #include "physical/PhysicalReaderUtil.h"
+#include "physical/compression/BlockCompressor.h"
 #include "PixelsVersion.h"
 
 const int PixelsWriterImpl::CHUNK_ALIGNMENT = std::stoi(ConfigFactory::Instance().getProperty("column.chunk.alignment"));
@@ -46,13 +47,18 @@ PixelsWriterImpl::PixelsWriterImpl(std::shared_ptr<TypeDescription> schema, int
                                    : schema(schema), rowGroupSize(rowGroupSize), compressionBlockSize(compressionBlockSize) {
     this->columnWriterOption = std::make_shared<PixelsWriterOption>()->setPixelsStride(pixelsStride)->setEncodingLevel(encodingLevel)->setNullsPadding(nullsPadding);
     this->physicalWriter = PhysicalWriterUtil::newPhysicalWriter(targetFilePath, blockSize, blockPadding, false);
-    this->compressionKind = pixels::proto::CompressionKind::NONE;
+    this->compressionKind = BlockCompressor::parseKind(ConfigFactory::Instance().getProperty("compression.kind"));
+    if(compressionKind != pixels::proto::CompressionKind::NONE && compressionBlockSize <= 0) {
+        throw InvalidArgumentException("PixelsWriterImpl: the compression block size must be positive.");
+    }
+    this->rowGroupFootersConsolidated = ConfigFactory::Instance().boolCheckProperty("rowgroup.footer.consolidated");
     // this->timeZone = std::unique_ptr<icu::TimeZone>(icu::TimeZone::createDefault());
     this->children = schema->getChildren();
     this->partitioned=partitioned;
 
     for(int i=0;i<children.size();i++){
         columnWriters.push_back(ColumnWriterBuilder::newColumnWriter(children.at(i),columnWriterOption));
+        fileColStatRecorders.push_back(StatsRecorder::create(*children.at(i)));
     }
 }
 
@@ -120,15 +126,22 @@ void PixelsWriterImpl::writeRowGroup() {
     // TODO
     std::cout<<"Try to write rowGroup"<<std::endl;
     int rowGroupDataLength = 0;
-//    pixels::proto::RowGroupStatistic curRowGroupStatistic;
+    pixels::proto::RowGroupStatistic curRowGroupStatistic;
     pixels::proto::RowGroupInformation curRowGroupInfo;
     pixels::proto::RowGroupIndex curRowGroupIndex;
     pixels::proto::RowGroupEncoding curRowGroupEncoding;
     // reset each column writer and get current row group content size in bytes
+    std::vector<std::vector<uint8_t>> chunkContents;
     for(auto writer:columnWriters){
         // flush writes the isNull bit map into the internal output stream.
         writer->flush();
-        rowGroupDataLength+=writer->getColumnChunkSize();
+        chunkContents.emplace_back(writer->getColumnChunkContent());
+        if(compressionKind != pixels::proto::CompressionKind::NONE) {
+            // the column chunk is stored as compressed blocks, and the chunk length in the index is the stored length
+            chunkContents.back() = BlockCompressor::compress(compressionKind, chunkContents.back().data(),
+                                                             chunkContents.back().size(), compressionBlockSize);
+        }
+        rowGroupDataLength+=chunkContents.back().size();
         if(CHUNK_ALIGNMENT!=0&& rowGroupDataLength%CHUNK_ALIGNMENT!=0){
             /*
             * Issue #519:
@@ -155,8 +168,7 @@ void PixelsWriterImpl::writeRowGroup() {
                 throw std::runtime_error("Failed to align the start offset of the column chunks in the row group");
             }
 
-            for(auto& writer:columnWriters){
-                auto rowGroupBuffer=writer->getColumnChunkContent();
+            for(auto& rowGroupBuffer:chunkContents){
                 physicalWriter->append(rowGroupBuffer.data(), 0, rowGroupBuffer.size());
                 writtenBytes += rowGroupBuffer.size();
                 if (CHUNK_ALIGNMENT != 0 && rowGroupBuffer.size() % CHUNK_ALIGNMENT != 0) {
@@ -183,14 +195,17 @@ void PixelsWriterImpl::writeRowGroup() {
         std::shared_ptr<ColumnWriter> writer=columnWriters[i];
         auto chunkIndex=writer->getColumnChunkIndex();
         chunkIndex.set_chunkoffset(curRowGroupOffset+rowGroupDataLength);
-        chunkIndex.set_chunklength(writer->getColumnChunkSize());
+        chunkIndex.set_chunklength(chunkContents[i].size());
         chunkIndex.set_littleendian(true);
-        rowGroupDataLength+=writer->getColumnChunkSize();
+        rowGroupDataLength+=chunkContents[i].size();
         if(CHUNK_ALIGNMENT!=0&&rowGroupDataLength%CHUNK_ALIGNMENT!=0){
             rowGroupDataLength += CHUNK_ALIGNMENT - rowGroupDataLength % CHUNK_ALIGNMENT;
         }
         *(curRowGroupIndex.add_columnchunkindexentries()) = chunkIndex;
         *(curRowGroupEncoding.add_columnchunkencodings()) = writer->getColumnChunkEncoding();
+        // the column chunk statistics are used by the readers to skip row groups
+        *(curRowGroupStatistic.add_columnchunkstats()) = writer->getColumnChunkStatRecorder().serialize();
+        fileColStatRecorders[i]->merge(writer->getColumnChunkStatRecorder());
 
 
         columnWriters[i]=ColumnWriterBuilder::newColumnWriter(children.at(i),columnWriterOption);
@@ -210,6 +225,9 @@ void PixelsWriterImpl::writeRowGroup() {
         curRowGroupFooterOffset = physicalWriter->append(footerBuffer.getPointer(), 0, footerBuffer.size());
         writtenBytes += footerBuffer.size();
         physicalWriter->flush();
+        if(rowGroupFootersConsolidated) {
+            rowGroupFooterContents.emplace_back((char *) footerBuffer.getPointer(), footerBuffer.size());
+        }
     } catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
         throw;
@@ -220,6 +238,7 @@ void PixelsWriterImpl::writeRowGroup() {
     curRowGroupInfo.set_footerlength(rowGroupFooter->ByteSizeLong());
     curRowGroupInfo.set_numberofrows(curRowGroupNumOfRows);
     rowGroupInfoList.push_back(curRowGroupInfo);
+    rowGroupStatisticList.push_back(curRowGroupStatistic);
 
     this->fileRowNum += curRowGroupNumOfRows;
     this->fileContentLength += rowGroupDataLength;
@@ -229,10 +248,30 @@ void PixelsWriterImpl::writeRowGroup() {
 void PixelsWriterImpl::writeFileTail() {
     std::shared_ptr<pixels::proto::Footer> footer=std::make_shared<pixels::proto::Footer>();
     std::shared_ptr<pixels::proto::PostScript> postScript=std::make_shared<pixels::proto::PostScript>();
+    if(rowGroupFootersConsolidated) {
+        // copy the RowGroupFooters right before the file tail, so that a reader gets all of them in one read
+        int footersLength = 0;
+        for(const auto& content: rowGroupFooterContents) {
+            footersLength += content.size();
+        }
+        long footersOffset = physicalWriter->prepare(footersLength);
+        for(const auto& content: rowGroupFooterContents) {
+            physicalWriter->append((const uint8_t *) content.data(), 0, content.size());
+        }
+        writtenBytes += footersLength;
+        postScript->set_rowgroupfootersconsolidated(true);
+        postScript->set_rowgroupfootersoffset(footersOffset);
+    }
     schema->writeTypes(footer);
+    for(const auto& recorder: fileColStatRecorders){
+        *(footer->add_columnstats()) = recorder->serialize();
+    }
     for(auto rowGroupInformation: rowGroupInfoList){
         *(footer->add_rowgroupinfos()) = rowGroupInformation;
     }
+    for(const auto& rowGroupStatistic: rowGroupStatisticList){
+        *(footer->add_rowgroupstats()) = rowGroupStatistic;
+    }
     postScript->set_version(PixelsVersion::V1);
     std::string FILE_MAGIC="PIXELS";
     postScript->set_contentlength(fileContentLength);
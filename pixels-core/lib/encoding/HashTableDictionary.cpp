@@ -0,0 +1,121 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "encoding/HashTableDictionary.h"
+#include "exception/InvalidArgumentException.h"
+#include <cstring>
+
+HashTableDictionary::HashTableDictionary(int initialCapacity) {
+    if(initialCapacity <= 0) {
+        throw InvalidArgumentException("HashTableDictionary: the initial capacity must be positive.");
+    }
+    // the number of slots is a power of 2 and at least twice the capacity
+    uint64_t slotNum = 2;
+    while(slotNum < 2 * (uint64_t) initialCapacity) {
+        slotNum <<= 1;
+    }
+    slots.assign(slotNum, -1);
+    mask = slotNum - 1;
+    starts.push_back(0);
+}
+
+uint64_t HashTableDictionary::hash(const uint8_t * key, int length) {
+    // hash 8 bytes at a time, the bits are mixed at the end as the slot is picked by the low bits
+    const uint64_t multiplier = 0x9e3779b97f4a7c15ULL;
+    uint64_t h = (uint64_t) length * multiplier;
+    int i = 0;
+    for(; i + 8 <= length; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, key + i, sizeof(word));
+        h = (h ^ word) * multiplier;
+        h ^= h >> 29;
+    }
+    if(i < length) {
+        uint64_t word = 0;
+        std::memcpy(&word, key + i, length - i);
+        h = (h ^ word) * multiplier;
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h;
+}
+
+int HashTableDictionary::add(const uint8_t * key, int length) {
+    uint64_t h = hash(key, length);
+    uint64_t slot = h & mask;
+    while(slots[slot] != -1) {
+        int id = slots[slot];
+        if(hashes[id] == h && getKeyLength(id) == length &&
+           std::memcmp(content.data() + starts[id], key, length) == 0) {
+            return id;
+        }
+        slot = (slot + 1) & mask;
+    }
+    int id = size();
+    slots[slot] = id;
+    hashes.push_back(h);
+    content.insert(content.end(), key, key + length);
+    starts.push_back((int) content.size());
+    // keep the load factor below 0.5
+    if(2 * (uint64_t) size() > mask) {
+        grow();
+    }
+    return id;
+}
+
+void HashTableDictionary::grow() {
+    slots.assign(2 * slots.size(), -1);
+    mask = slots.size() - 1;
+    for(int id = 0; id < size(); id++) {
+        uint64_t slot = hashes[id] & mask;
+        while(slots[slot] != -1) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = id;
+    }
+}
+
+int HashTableDictionary::size() const {
+    return (int) hashes.size();
+}
+
+const uint8_t * HashTableDictionary::getKey(int id) const {
+    return content.data() + starts[id];
+}
+
+int HashTableDictionary::getKeyLength(int id) const {
+    return starts[id + 1] - starts[id];
+}
+
+const std::vector<uint8_t> & HashTableDictionary::getContent() const {
+    return content;
+}
+
+const std::vector<int> & HashTableDictionary::getStarts() const {
+    return starts;
+}
+
+void HashTableDictionary::clear() {
+    content.clear();
+    starts.assign(1, 0);
+    hashes.clear();
+    std::fill(slots.begin(), slots.end(), -1);
+}
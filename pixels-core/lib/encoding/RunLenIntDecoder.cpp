@@ -3,6 +3,11 @@
 //
 
 #include "encoding/RunLenIntDecoder.h"
+#include <algorithm>
+#include <type_traits>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 RunLenIntDecoder::RunLenIntDecoder(const std::shared_ptr <ByteBuffer>& bb, bool isSigned) {
     literals = new long[Constants::MAX_SCOPE];
@@ -11,6 +16,7 @@ RunLenIntDecoder::RunLenIntDecoder(const std::shared_ptr <ByteBuffer>& bb, bool
     numLiterals = 0;
     used = 0;
 	isRepeating = false;
+    isMonotonic = false;
 }
 
 void RunLenIntDecoder::close() {
@@ -35,9 +41,322 @@ long RunLenIntDecoder::next() {
     return result;
 }
 
+void RunLenIntDecoder::skip(long n) {
+    while (n > 0) {
+        if (used == numLiterals) {
+            numLiterals = 0;
+            used = 0;
+            // try to skip the next run without decoding it
+            long skipped = skipRun(n);
+            if (skipped > 0) {
+                n -= skipped;
+                continue;
+            }
+            readValues();
+        }
+        long consumed = std::min(n, (long) (numLiterals - used));
+        used += (int) consumed;
+        n -= consumed;
+    }
+}
+
+/**
+ * Skip the next run in the input stream if it contains no more than n values.
+ *
+ * @param n the maximal number of values to skip
+ * @return the number of skipped values, or 0 if the run is not skipped
+ */
+long RunLenIntDecoder::skipRun(long n) {
+    uint32_t startPos = inputStream->getReadPos();
+    int firstByte = (int) inputStream->get();
+    auto currentEncoding = (EncodingType) ((firstByte >> 6) & 0x03);
+    long len;
+    switch (currentEncoding) {
+        case RunLenIntEncoder::SHORT_REPEAT: {
+            int size = ((((uint32_t)firstByte) >> 3) & 0x07) + 1;
+            len = (firstByte & 0x07) + Constants::MIN_REPEAT;
+            if (len > n) {
+                break;
+            }
+            inputStream->skipBytes(size);
+            return len;
+        }
+        case RunLenIntEncoder::DIRECT: {
+            int fb = encodingUtils.decodeBitWidth((firstByte >> 1) & 0x1f);
+            len = (((firstByte & 0x01) << 8) | inputStream->get()) + 1;
+            if (len > n) {
+                break;
+            }
+            inputStream->skipBytes((uint32_t) ((len * fb + 7) / 8));
+            return len;
+        }
+        case RunLenIntEncoder::DELTA: {
+            int fb = (((uint32_t)firstByte) >> 1) & 0x1f;
+            if (fb != 0) {
+                fb = encodingUtils.decodeBitWidth(fb);
+            }
+            // the first value is not counted in the run length
+            len = (((firstByte & 0x01) << 8) | inputStream->get()) + 1;
+            if (len > n) {
+                break;
+            }
+            // the first value and the delta base (or the fixed delta)
+            skipVulong(inputStream);
+            skipVulong(inputStream);
+            if (fb != 0) {
+                inputStream->skipBytes((uint32_t) (((len - 2) * fb + 7) / 8));
+            }
+            return len;
+        }
+        case RunLenIntEncoder::PATCHED_BASE: {
+            int fb = encodingUtils.decodeBitWidth((firstByte >> 1) & 0x1f);
+            len = (((firstByte & 0x01) << 8) | inputStream->get()) + 1;
+            if (len > n) {
+                break;
+            }
+            int thirdByte = inputStream->get();
+            int fourthByte = inputStream->get();
+            int baseBytes = ((thirdByte >> 5) & 0x07) + 1;
+            int pw = encodingUtils.decodeBitWidth(thirdByte & 0x1f);
+            int pgw = ((fourthByte >> 5) & 0x07) + 1;
+            int pl = fourthByte & 0x1f;
+            int patchBits = encodingUtils.getClosestFixedBits(pw + pgw);
+            inputStream->skipBytes((uint32_t) (baseBytes + (len * fb + 7) / 8 + (pl * patchBits + 7) / 8));
+            return len;
+        }
+        default:
+            break;
+    }
+    inputStream->setReadPos(startPos);
+    return 0;
+}
+
+void RunLenIntDecoder::skipVulong(const std::shared_ptr<ByteBuffer> &input) {
+    while (input->get() >= 0x80) {
+    }
+}
+
+template <class T>
+static void broadcastValues(T * out, int len, T val) {
+    int i = 0;
+#ifdef __AVX2__
+    __m256i vals;
+    if constexpr(sizeof(T) == 8) {
+        vals = _mm256_set1_epi64x(val);
+    } else {
+        vals = _mm256_set1_epi32(val);
+    }
+    for (; i + (int) (32 / sizeof(T)) <= len; i += 32 / sizeof(T)) {
+        _mm256_storeu_si256((__m256i *) (out + i), vals);
+    }
+#endif
+    for (; i < len; i++) {
+        out[i] = val;
+    }
+}
+
+static void zigzagDecodeValues(long * values, int len) {
+    int i = 0;
+#ifdef __AVX2__
+    const __m256i one = _mm256_set1_epi64x(1);
+    const __m256i zero = _mm256_setzero_si256();
+    for (; i + 4 <= len; i += 4) {
+        __m256i v = _mm256_loadu_si256((__m256i *) (values + i));
+        // (v >>> 1) ^ -(v & 1)
+        __m256i sign = _mm256_sub_epi64(zero, _mm256_and_si256(v, one));
+        v = _mm256_xor_si256(_mm256_srli_epi64(v, 1), sign);
+        _mm256_storeu_si256((__m256i *) (values + i), v);
+    }
+#endif
+    for (; i < len; i++) {
+        values[i] = (long) (((uint64_t) values[i] >> 1) ^ -(values[i] & 1));
+    }
+}
+
+/**
+ * Compute the inclusive prefix sum of the deltas in place, starting from base.
+ * The deltas are subtracted instead if the sequence is decreasing.
+ */
+static void prefixSumValues(long * values, int len, long base, bool decreasing) {
+    int i = 0;
+#ifdef __AVX2__
+    __m256i carry = _mm256_set1_epi64x(base);
+    for (; i + 4 <= len; i += 4) {
+        __m256i v = _mm256_loadu_si256((__m256i *) (values + i));
+        if (decreasing) {
+            v = _mm256_sub_epi64(_mm256_setzero_si256(), v);
+        }
+        // prefix sum in each 128-bit lane: [a, a + b, c, c + d]
+        v = _mm256_add_epi64(v, _mm256_slli_si256(v, 8));
+        // add a + b to the upper lane
+        __m256i low = _mm256_permute4x64_epi64(v, _MM_SHUFFLE(1, 1, 1, 1));
+        v = _mm256_add_epi64(v, _mm256_blend_epi32(_mm256_setzero_si256(), low, 0xF0));
+        v = _mm256_add_epi64(v, carry);
+        _mm256_storeu_si256((__m256i *) (values + i), v);
+        carry = _mm256_permute4x64_epi64(v, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+    if (i > 0) {
+        base = values[i - 1];
+    }
+#endif
+    for (; i < len; i++) {
+        base = decreasing ? base - values[i] : base + values[i];
+        values[i] = base;
+    }
+}
+
+void RunLenIntDecoder::decode(int64_t * out, int n) {
+    bulkDecode<int64_t>(out, n);
+}
+
+void RunLenIntDecoder::decode(int32_t * out, int n) {
+    bulkDecode<int32_t>(out, n);
+}
+
+int RunLenIntDecoder::readRun(int64_t * out, int n, bool & monotonic) {
+    return readRunValues<int64_t>(out, n, monotonic);
+}
+
+int RunLenIntDecoder::readRun(int32_t * out, int n, bool & monotonic) {
+    return readRunValues<int32_t>(out, n, monotonic);
+}
+
+template <class T>
+int RunLenIntDecoder::readRunValues(T * out, int n, bool & monotonic) {
+    if (used == numLiterals) {
+        numLiterals = 0;
+        used = 0;
+        readValues();
+    }
+    int count = std::min(n, numLiterals - used);
+    if (count == 0 && n > 0) {
+        throw InvalidArgumentException("RunLenIntDecoder::readRun: no more values to read.");
+    }
+    for (int i = 0; i < count; i++) {
+        out[i] = (T) literals[used + i];
+    }
+    used += count;
+    monotonic = isMonotonic;
+    return count;
+}
+
+template <class T>
+void RunLenIntDecoder::bulkDecode(T * out, int n) {
+    int pos = 0;
+    while (pos < n) {
+        if (used < numLiterals) {
+            // drain the values of a partially consumed run
+            int count = std::min(n - pos, numLiterals - used);
+            for (int i = 0; i < count; i++) {
+                out[pos + i] = (T) literals[used + i];
+            }
+            used += count;
+            pos += count;
+            continue;
+        }
+        numLiterals = 0;
+        used = 0;
+        int decoded = decodeRun<T>(out + pos, n - pos);
+        if (decoded > 0) {
+            pos += decoded;
+            continue;
+        }
+        readValues();
+    }
+}
+
+/**
+ * Decode the next run straight into the output buffer if it contains no more than n values.
+ * For int32 output, the bit-unpacked values are narrowed from the literals buffer.
+ *
+ * @return the number of decoded values, or 0 if the run is not decoded
+ */
+template <class T>
+int RunLenIntDecoder::decodeRun(T * out, int n) {
+    uint32_t startPos = inputStream->getReadPos();
+    int firstByte = (int) inputStream->get();
+    auto currentEncoding = (EncodingType) ((firstByte >> 6) & 0x03);
+    // the buffer to unpack values, the output buffer is used directly if it is int64
+    long * unpacked = std::is_same<T, int64_t>::value ? (long *) out : literals;
+    int len;
+    switch (currentEncoding) {
+        case RunLenIntEncoder::SHORT_REPEAT: {
+            int size = ((((uint32_t)firstByte) >> 3) & 0x07) + 1;
+            len = (firstByte & 0x07) + Constants::MIN_REPEAT;
+            if (len > n) {
+                break;
+            }
+            long val = bytesToLongBE(inputStream, size);
+            if (isSigned) {
+                val = zigzagDecode(val);
+            }
+            broadcastValues<T>(out, len, (T) val);
+            return len;
+        }
+        case RunLenIntEncoder::DIRECT: {
+            int fb = encodingUtils.decodeBitWidth((firstByte >> 1) & 0x1f);
+            len = (((firstByte & 0x01) << 8) | inputStream->get()) + 1;
+            if (len > n) {
+                break;
+            }
+            readInts(unpacked, 0, len, fb, inputStream);
+            if (isSigned) {
+                zigzagDecodeValues(unpacked, len);
+            }
+            break;
+        }
+        case RunLenIntEncoder::DELTA: {
+            int fb = (((uint32_t)firstByte) >> 1) & 0x1f;
+            if (fb != 0) {
+                fb = encodingUtils.decodeBitWidth(fb);
+            }
+            len = (((firstByte & 0x01) << 8) | inputStream->get()) + 1;
+            if (len > n) {
+                break;
+            }
+            long firstVal = isSigned ? readVslong(inputStream) : readVulong(inputStream);
+            if (fb == 0) {
+                // fixed delta
+                long fd = readVslong(inputStream);
+                for (int i = 0; i < len; i++) {
+                    out[i] = (T) (firstVal + i * fd);
+                }
+                return len;
+            }
+            long deltaBase = readVslong(inputStream);
+            unpacked[0] = firstVal;
+            unpacked[1] = firstVal + deltaBase;
+            readInts(unpacked, 2, len - 2, fb, inputStream);
+            prefixSumValues(unpacked + 2, len - 2, unpacked[1], deltaBase < 0);
+            break;
+        }
+        case RunLenIntEncoder::PATCHED_BASE: {
+            len = (((firstByte & 0x01) << 8) | inputStream->get()) + 1;
+            if (len > n) {
+                break;
+            }
+            unpackPatchedBase(firstByte, unpacked, len);
+            break;
+        }
+        default:
+            throw InvalidArgumentException("Not supported encoding type.");
+    }
+    if (len > n) {
+        inputStream->setReadPos(startPos);
+        return 0;
+    }
+    if constexpr(!std::is_same<T, int64_t>::value) {
+        for (int i = 0; i < len; i++) {
+            out[i] = (T) unpacked[i];
+        }
+    }
+    return len;
+}
+
 void RunLenIntDecoder::readValues() {
 	// read the first 2 bits and determine the encoding type
 	isRepeating = false;
+    isMonotonic = false;
     int firstByte = (int) inputStream->get();
     if(firstByte < 0) {
         // TODO: logger.error
@@ -50,15 +369,18 @@ void RunLenIntDecoder::readValues() {
     switch (currentEncoding) {
         case RunLenIntEncoder::SHORT_REPEAT:
 	    	readShortRepeatValues(firstByte);
+            isMonotonic = true;
 	        break;
         case RunLenIntEncoder::DIRECT:
             readDirectValues(firstByte);
             break;
         case RunLenIntEncoder::PATCHED_BASE:
-            throw InvalidArgumentException("Currently "
-                                           "we don't support PATCHED_BASE encoding.");
+            readPatchedBaseValues(firstByte);
+            break;
         case RunLenIntEncoder::DELTA:
 		    readDeltaValues(firstByte);
+            // the deltas of a run have the same sign
+            isMonotonic = true;
 		    break;
         default:
             throw InvalidArgumentException("Not supported encoding type.");
@@ -97,47 +419,82 @@ long RunLenIntDecoder::zigzagDecode(long val) {
  */
 void RunLenIntDecoder::readInts(long *buffer, int offset, int len, int bitSize,
                            const std::shared_ptr<ByteBuffer> &input) {
-    int bitsLeft = 0;
-    int current = 0;
-    switch (bitSize) {
-	    case 1:
-            encodingUtils.unrolledUnPack1(buffer, offset, len, input);
-            return;
-	    case 2:
-			encodingUtils.unrolledUnPack2(buffer, offset, len, input);
-		    return;
-        case 4:
-            encodingUtils.unrolledUnPack4(buffer, offset, len, input);
-            return;
-        case 8:
-            encodingUtils.unrolledUnPack8(buffer, offset, len, input);
-            return;
-	    case 16:
-		    encodingUtils.unrolledUnPack16(buffer, offset, len, input);
-		    return;
-	    case 24:
-		    encodingUtils.unrolledUnPack24(buffer, offset, len, input);
-		    return;
-	    case 32:
-		    encodingUtils.unrolledUnPack32(buffer, offset, len, input);
-		    return;
-	    case 40:
-		    encodingUtils.unrolledUnPack40(buffer, offset, len, input);
-		    return;
-	    case 48:
-		    encodingUtils.unrolledUnPack48(buffer, offset, len, input);
-		    return;
-	    case 56:
-		    encodingUtils.unrolledUnPack56(buffer, offset, len, input);
-		    return;
-	    case 64:
-		    encodingUtils.unrolledUnPack64(buffer, offset, len, input);
-		    return;
-        default:
-            throw InvalidArgumentException("RunLenIntDecoder::readInts: "
-                                           "not supported bitSize.");
+    if (bitSize < 1 || bitSize > 64) {
+        throw InvalidArgumentException("RunLenIntDecoder::readInts: "
+                                       "not supported bitSize.");
+    }
+    encodingUtils.unPack(buffer, offset, len, bitSize, input);
+}
+
+void RunLenIntDecoder::readPatchedBaseValues(int firstByte) {
+    // extract the run length of data blob
+    int len = (firstByte & 0x01) << 8;
+    len |= inputStream->get();
+    // runs are one off
+    len += 1;
+    unpackPatchedBase(firstByte, literals + numLiterals, len);
+    numLiterals += len;
+}
+
+/**
+ * Decode the rest of a PATCHED_BASE run after its run length. The data blob is
+ * bulk unpacked and rebased first, then the patches are or-ed into the high bits
+ * of the values at the patched positions only.
+ */
+void RunLenIntDecoder::unpackPatchedBase(int firstByte, long * buffer, int len) {
+    int fb = encodingUtils.decodeBitWidth((firstByte >> 1) & 0x1f);
+    // 3 bits for the number of bytes of base and 5 bits for patch width
+    int thirdByte = inputStream->get();
+    int baseBytes = ((thirdByte >> 5) & 0x07) + 1;
+    int pw = encodingUtils.decodeBitWidth(thirdByte & 0x1f);
+    // 3 bits for patch gap width and 5 bits for patch list length
+    int fourthByte = inputStream->get();
+    int pgw = ((fourthByte >> 5) & 0x07) + 1;
+    int pl = fourthByte & 0x1f;
+    if (pw + pgw > 64) {
+        throw InvalidArgumentException("RunLenIntDecoder::unpackPatchedBase: "
+                                       "patch and gap width exceed 64 bits.");
+    }
+
+    // the MSB of base is the sign bit
+    long base = bytesToLongBE(inputStream, baseBytes);
+    long signMask = 1L << ((baseBytes * 8) - 1);
+    if ((base & signMask) != 0) {
+        base = -(base & ~signMask);
+    }
+
+    readInts(buffer, 0, len, fb, inputStream);
+    int i = 0;
+#ifdef __AVX2__
+    __m256i bases = _mm256_set1_epi64x(base);
+    for (; i + 4 <= len; i += 4) {
+        __m256i v = _mm256_loadu_si256((__m256i *) (buffer + i));
+        _mm256_storeu_si256((__m256i *) (buffer + i), _mm256_add_epi64(v, bases));
+    }
+#endif
+    for (; i < len; i++) {
+        buffer[i] += base;
+    }
+
+    long patches[32];
+    readInts(patches, 0, pl, encodingUtils.getClosestFixedBits(pw + pgw), inputStream);
+    long patchMask = (1L << pw) - 1;
+    long patchPos = 0;
+    for (int p = 0; p < pl; p++) {
+        long gap = (long) ((uint64_t) patches[p] >> pw);
+        long patch = patches[p] & patchMask;
+        patchPos += gap;
+        // a gap over 255 is split into entries of gap 255 and patch 0
+        if (gap == 255 && patch == 0) {
+            continue;
+        }
+        if (patchPos >= len) {
+            throw InvalidArgumentException("RunLenIntDecoder::unpackPatchedBase: "
+                                           "patch position out of the run.");
+        }
+        // the value is rebased before patching, so patch the bits above fb of the reduced value
+        buffer[patchPos] = ((buffer[patchPos] - base) | (patch << fb)) + base;
     }
-    // TODO: if notthe case, we should write the following code.
 }
 
 void RunLenIntDecoder::readDeltaValues(int firstByte) {
@@ -224,10 +224,14 @@ void RunLenIntEncoder::determineEncoding() {
         // fallback to DIRECT encoding.
         // The decision to use patched base was based on zigzag values, but the
         // actual patching is done on base reduced literals.
-        if(brBits100p - brBits95p != 0) {
+        if(brBits100p - brBits95p != 0 && std::abs(min) < Constants::BASE_VALUE_LIMIT) {
             // std::cout << "brBits100p - brBits95p != 0" << std::endl;
             encodingType = EncodingType::PATCHED_BASE;
             preparePatchedBlob();
+            // patching only pays off if the patched run is smaller than the direct run
+            if(getPatchedBaseSize() >= getDirectSize()) {
+                encodingType = EncodingType::DIRECT;
+            }
             return;
         } 
         else {
@@ -321,6 +325,7 @@ void RunLenIntEncoder::preparePatchedBlob() {
     // 255 gap => 0 for patch value
     // 1 gap => actual patch value
     if(patchGapWidth > 8) {
+        patchGapWidth = 8;
         // for gap = 511, we need two extra entries in patch list
         if(maxGap == 511) {
             patchLength += 2;
@@ -349,6 +354,21 @@ void RunLenIntEncoder::preparePatchedBlob() {
     }    
 }
 
+// the number of bytes of the run if it is written by writePatchedBaseValues
+int RunLenIntEncoder::getPatchedBaseSize() {
+    int baseWidth = findClosestNumBits(std::abs(min)) + 1;
+    int baseBytes = baseWidth % 8 == 0 ? baseWidth / 8 : (baseWidth / 8) + 1;
+    int dataBits = numLiterals * encodingUtils.getClosestFixedBits(brBits95p);
+    int patchBits = gapVsPatchListSize * encodingUtils.getClosestFixedBits(patchGapWidth + patchWidth);
+    return 4 + baseBytes + (dataBits + 7) / 8 + (patchBits + 7) / 8;
+}
+
+// the number of bytes of the run if it is written by writeDirectValues
+int RunLenIntEncoder::getDirectSize() {
+    int fb = isAlignedBitPacking ? getClosestAlignedFixedBits(zzBits100p) : zzBits100p;
+    return 2 + (numLiterals * fb + 7) / 8;
+}
+
 void RunLenIntEncoder::writeValues() {
     if(numLiterals == 0) {
         return;
@@ -476,7 +496,7 @@ void RunLenIntEncoder::writePatchedBaseValues() {
 
     // find the number of bytes required for base and shift it by 5 bits to
     // accommodate patch width. The additional bit is used to store the sign of the base value
-    int baseWidth = findClosestNumBits(min);
+    int baseWidth = findClosestNumBits(min) + 1;
     int baseBytes = baseWidth % 8 == 0 ? baseWidth / 8 : (baseWidth / 8) + 1;
     int bb = (baseBytes - 1) << 5;
 
@@ -853,7 +873,7 @@ int RunLenIntEncoder::percentileBits(long*  data, int offset, int length, double
         return -1;
     }
 
-    int hist[32];
+    int hist[32] = {0};
     for(int i = offset; i < (offset + length); ++i) {
         // QUESTION: there is calling of getClosestFixedBits in encodeBitWidth function, 
         //           is it redundant here to call it? maybe just count is enough
@@ -971,7 +991,7 @@ void RunLenIntEncoder::writeVulong(std::shared_ptr<ByteBuffer> output, long valu
         }
         else {
             output->put((byte) (0x80 | (value & 0x7f)));
-            value = ((unsigned)value) >> 7;
+            value = static_cast<unsigned long>(value) >> 7;
         }
     }
 }
@@ -3,6 +3,8 @@
 //
 
 #include "reader/ColumnReader.h"
+#include "profiler/CountProfiler.h"
+#include <tuple>
 
 ColumnReader::ColumnReader(std::shared_ptr<TypeDescription> type) {
     this->type = type;
@@ -55,6 +57,81 @@ ColumnReader::read(std::shared_ptr<ByteBuffer> input, pixels::proto::ColumnEncod
                    pixels::proto::ColumnChunkIndex &chunkIndex, std::shared_ptr<PixelsBitMask> filterMask) {
 }
 
+void ColumnReader::skip(std::shared_ptr<ByteBuffer> input, pixels::proto::ColumnEncoding &encoding, int offset,
+                        int size, int pixelStride, int vectorIndex, std::shared_ptr<ColumnVector> vector,
+                        pixels::proto::ColumnChunkIndex &chunkIndex) {
+    read(input, encoding, offset, size, pixelStride, vectorIndex, vector, chunkIndex, nullptr);
+}
+
+bool ColumnReader::readAndFilter(std::shared_ptr<ByteBuffer> input, pixels::proto::ColumnEncoding &encoding,
+                                 int offset, int size, int pixelStride, int vectorIndex,
+                                 std::shared_ptr<ColumnVector> vector, pixels::proto::ColumnChunkIndex &chunkIndex,
+                                 std::shared_ptr<PixelsBitMask> filterMask, duckdb::TableFilter &filter) {
+    return false;
+}
+
+template <class T>
+void ColumnReader::readRunsAndFilter(RunLenIntDecoder &decoder, T *values, int size,
+                                     const std::shared_ptr<ColumnVector> &vector,
+                                     PixelsBitMask &filterMask, duckdb::TableFilter &filter) {
+    // the runs [start, end) that are decided by their bounds
+    std::vector<std::tuple<int, int, bool>> decidedRuns;
+    bool checkValues = false;
+    int i = 0;
+    while (i < size) {
+        bool monotonic = false;
+        int count = decoder.readRun(values + i, size - i, monotonic);
+        PixelsFilter::BoundsMatch match = PixelsFilter::SOME_MATCH;
+        if (monotonic) {
+            int64_t first = values[i];
+            int64_t last = values[i + count - 1];
+            match = PixelsFilter::CheckBounds<int64_t>(filter, std::min(first, last),
+                                                       std::max(first, last), type);
+        }
+        if (match == PixelsFilter::SOME_MATCH) {
+            checkValues = true;
+        } else {
+            decidedRuns.emplace_back(i, i + count, match == PixelsFilter::ALL_MATCH);
+        }
+        i += count;
+    }
+    PixelsBitMask columnMask(filterMask.maskLength);
+    if (checkValues) {
+        PixelsFilter::ApplyFilter(vector, filter, columnMask, type);
+    }
+    for (auto &run : decidedRuns) {
+        columnMask.setRange(std::get<0>(run), std::get<1>(run), std::get<2>(run));
+    }
+    // the runs and the padding values do not decide the null rows
+    PixelsFilter::ApplyNulls(vector, columnMask, PixelsFilter::MatchesNull(filter));
+    if (!decidedRuns.empty()) {
+        ::CountProfiler::Instance().Count("filter runs on encoded data", (int) decidedRuns.size());
+    }
+    filterMask.And(columnMask);
+}
+
+template void ColumnReader::readRunsAndFilter<int32_t>(RunLenIntDecoder &decoder, int32_t *values, int size,
+        const std::shared_ptr<ColumnVector> &vector, PixelsBitMask &filterMask, duckdb::TableFilter &filter);
+template void ColumnReader::readRunsAndFilter<int64_t>(RunLenIntDecoder &decoder, int64_t *values, int size,
+        const std::shared_ptr<ColumnVector> &vector, PixelsBitMask &filterMask, duckdb::TableFilter &filter);
+
+void ColumnReader::skipValid(int pixelStride, int size, bool hasNull) {
+    if (hasNull) {
+        int elementSizeInCurrPixels = std::min(pixelStride, size);
+        isNullOffset += (int) ceil(1.0 * elementSizeInCurrPixels / 8);
+    }
+}
+
+bool ColumnReader::seekToNextPixel(const std::shared_ptr<ByteBuffer>& input, int pixelStride, int size,
+                                   pixels::proto::ColumnChunkIndex &chunkIndex) {
+    int pixelId = elementIndex / pixelStride;
+    if (elementIndex % pixelStride != 0 || size != pixelStride ||
+        pixelId + 1 >= chunkIndex.pixelpositions_size()) {
+        return false;
+    }
+    input->setReadPos(chunkIndex.pixelpositions(pixelId + 1));
+    return true;
+}
 
 void ColumnReader::setValid(const std::shared_ptr<ByteBuffer>& input, int pixelStride, const std::shared_ptr<ColumnVector>& columnVector, int pixelId, bool hasNull) {
     int elementSizeInCurrPixels = std::min(pixelStride, (int)columnVector->length);
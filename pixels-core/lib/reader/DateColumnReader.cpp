@@ -3,6 +3,7 @@
 //
 
 #include "reader/DateColumnReader.h"
+#include <algorithm>
 
 
 DateColumnReader::DateColumnReader(std::shared_ptr<TypeDescription> type) : ColumnReader(type) {
@@ -25,19 +26,81 @@ void DateColumnReader::read(std::shared_ptr<ByteBuffer> input, pixels::proto::Co
 	}
 
     int pixelId = elementIndex / pixelStride;
-    bool hasNull = chunkIndex.pixelstatistics(pixelId).statistic().hasnull();
+    bool hasNull = PixelIndex::hasNull(chunkIndex, pixelId);
     setValid(input, pixelStride, vector, pixelId, hasNull);
 
 	if(encoding.kind() == pixels::proto::ColumnEncoding_Kind_RUNLENGTH) {
-        for (int i = 0; i < size; i++) {
-            if (elementIndex % pixelStride == 0) {
-                int pixelId = elementIndex / pixelStride;
-            }
-            columnVector->set(i + vectorIndex, (int) decoder->next());
-            elementIndex++;
-        }
+		int i = 0;
+		while (i < size) {
+			// the rows that are already filtered out are skipped without decoding
+			int setStart = filterMask == nullptr ? i : (int) filterMask->nextSetBit(i, size);
+			if (setStart > i) {
+				decoder->skip(setStart - i);
+			}
+			int setEnd = filterMask == nullptr ? size : (int) filterMask->nextClearBit(setStart, size);
+			if (setEnd > setStart) {
+				decoder->decode(columnVector->dates + setStart + vectorIndex, setEnd - setStart);
+				columnVector->writeIndex = std::max<uint64_t>(columnVector->writeIndex, setEnd + vectorIndex);
+			}
+			i = setEnd;
+		}
+		elementIndex += size;
 	} else {
 		columnVector->dates = (int *)(input->getPointer() + input->getReadPos());
 		input->setReadPos(input->getReadPos() + size * sizeof(int));
+		elementIndex += size;
 	}
 }
+
+void DateColumnReader::skip(std::shared_ptr<ByteBuffer> input, pixels::proto::ColumnEncoding & encoding, int offset,
+                            int size, int pixelStride, int vectorIndex, std::shared_ptr<ColumnVector> vector,
+                            pixels::proto::ColumnChunkIndex & chunkIndex) {
+	std::shared_ptr<DateColumnVector> columnVector =
+	    std::static_pointer_cast<DateColumnVector>(vector);
+	if(offset == 0) {
+		decoder = std::make_shared<RunLenIntDecoder>(input, true);
+		elementIndex = 0;
+		isNullOffset = chunkIndex.isnulloffset();
+	}
+
+	int pixelId = elementIndex / pixelStride;
+	bool hasNull = PixelIndex::hasNull(chunkIndex, pixelId);
+	skipValid(pixelStride, size, hasNull);
+
+	if(encoding.kind() == pixels::proto::ColumnEncoding_Kind_RUNLENGTH) {
+		if(!seekToNextPixel(input, pixelStride, size, chunkIndex)) {
+			decoder->skip(size);
+		}
+	} else {
+		// the values are referenced without copy, so the vector still points to the skipped values
+		columnVector->dates = (int *)(input->getPointer() + input->getReadPos());
+		input->setReadPos(input->getReadPos() + size * sizeof(int));
+	}
+	elementIndex += size;
+}
+
+bool DateColumnReader::readAndFilter(std::shared_ptr<ByteBuffer> input, pixels::proto::ColumnEncoding & encoding,
+                                     int offset, int size, int pixelStride, int vectorIndex,
+                                     std::shared_ptr<ColumnVector> vector,
+                                     pixels::proto::ColumnChunkIndex & chunkIndex,
+                                     std::shared_ptr<PixelsBitMask> filterMask, duckdb::TableFilter & filter) {
+	if(encoding.kind() != pixels::proto::ColumnEncoding_Kind_RUNLENGTH) {
+		return false;
+	}
+	std::shared_ptr<DateColumnVector> columnVector =
+	    std::static_pointer_cast<DateColumnVector>(vector);
+	if(offset == 0) {
+		decoder = std::make_shared<RunLenIntDecoder>(input, true);
+		elementIndex = 0;
+		isNullOffset = chunkIndex.isnulloffset();
+	}
+
+	int pixelId = elementIndex / pixelStride;
+	bool hasNull = PixelIndex::hasNull(chunkIndex, pixelId);
+	setValid(input, pixelStride, vector, pixelId, hasNull);
+
+	readRunsAndFilter<int32_t>(*decoder, columnVector->dates + vectorIndex, size, vector, *filterMask, filter);
+	columnVector->writeIndex = std::max<uint64_t>(columnVector->writeIndex, vectorIndex + size);
+	elementIndex += size;
+	return true;
+}
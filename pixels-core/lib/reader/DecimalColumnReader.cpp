@@ -36,7 +36,7 @@ void DecimalColumnReader::read(std::shared_ptr<ByteBuffer> input, pixels::proto:
     // TODO: we didn't implement the run length encoded method
 
     int pixelId = elementIndex / pixelStride;
-    bool hasNull = chunkIndex.pixelstatistics(pixelId).statistic().hasnull();
+    bool hasNull = PixelIndex::hasNull(chunkIndex, pixelId);
     setValid(input, pixelStride, vector, pixelId, hasNull);
 
     columnVector->vector = (long *)(input->getPointer() + input->getReadPos());
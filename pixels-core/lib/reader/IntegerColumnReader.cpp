@@ -32,18 +32,27 @@ void IntegerColumnReader::read(std::shared_ptr<ByteBuffer> input, pixels::proto:
 
     int pixelId = elementIndex / pixelStride;
     // still need to add pixelsStatistics in the writer
-    bool hasNull = chunkIndex.pixelstatistics(pixelId).statistic().hasnull();
+    bool hasNull = PixelIndex::hasNull(chunkIndex, pixelId);
     setValid(input, pixelStride, vector, pixelId, hasNull);
 
     if(encoding.kind() == pixels::proto::ColumnEncoding_Kind_RUNLENGTH) {
-        for(int i = 0; i < size; i++) {
-			if(isLong) {
-				columnVector->longVector[i + vectorIndex] = decoder->next();
-			} else {
-				*(reinterpret_cast<int*>(columnVector->intVector) + i + vectorIndex)  = decoder->next();
-			}
-            elementIndex++;
+        int i = 0;
+        while(i < size) {
+            // the rows that are already filtered out are skipped without decoding
+            int setStart = filterMask == nullptr ? i : (int) filterMask->nextSetBit(i, size);
+            if(setStart > i) {
+                decoder->skip(setStart - i);
+            }
+            int setEnd = filterMask == nullptr ? size : (int) filterMask->nextClearBit(setStart, size);
+            if(isLong) {
+                decoder->decode(columnVector->longVector + setStart + vectorIndex, setEnd - setStart);
+            } else {
+                decoder->decode(reinterpret_cast<int32_t*>(columnVector->intVector) + setStart + vectorIndex,
+                                setEnd - setStart);
+            }
+            i = setEnd;
         }
+        elementIndex += size;
     } else {
         if(isLong) {
             // if long
@@ -54,5 +63,64 @@ void IntegerColumnReader::read(std::shared_ptr<ByteBuffer> input, pixels::proto:
             std::memcpy((void*)columnVector->intVector + vectorIndex * sizeof(int), input->getPointer() + input->getReadPos(), size * sizeof(int));
 			input->setReadPos(input->getReadPos() + size * sizeof(int));
         }
+        elementIndex += size;
     }
 }
+
+void IntegerColumnReader::skip(std::shared_ptr<ByteBuffer> input, pixels::proto::ColumnEncoding & encoding, int offset,
+                               int size, int pixelStride, int vectorIndex, std::shared_ptr<ColumnVector> vector,
+                               pixels::proto::ColumnChunkIndex & chunkIndex) {
+    if(offset == 0) {
+        decoder = std::make_shared<RunLenIntDecoder>(input, true);
+        ColumnReader::elementIndex = 0;
+        isLong = type->getCategory() == TypeDescription::Category::LONG;
+        isNullOffset = chunkIndex.isnulloffset();
+    }
+
+    int pixelId = elementIndex / pixelStride;
+    bool hasNull = PixelIndex::hasNull(chunkIndex, pixelId);
+    skipValid(pixelStride, size, hasNull);
+
+    if(encoding.kind() == pixels::proto::ColumnEncoding_Kind_RUNLENGTH) {
+        if(!seekToNextPixel(input, pixelStride, size, chunkIndex)) {
+            decoder->skip(size);
+        }
+    } else {
+        if(!seekToNextPixel(input, pixelStride, size, chunkIndex)) {
+            input->setReadPos(input->getReadPos() + size * (isLong ? sizeof(int64_t) : sizeof(int)));
+        }
+    }
+    elementIndex += size;
+}
+
+bool IntegerColumnReader::readAndFilter(std::shared_ptr<ByteBuffer> input, pixels::proto::ColumnEncoding & encoding,
+                                        int offset, int size, int pixelStride, int vectorIndex,
+                                        std::shared_ptr<ColumnVector> vector,
+                                        pixels::proto::ColumnChunkIndex & chunkIndex,
+                                        std::shared_ptr<PixelsBitMask> filterMask, duckdb::TableFilter & filter) {
+    if(encoding.kind() != pixels::proto::ColumnEncoding_Kind_RUNLENGTH) {
+        return false;
+    }
+    std::shared_ptr<LongColumnVector> columnVector =
+            std::static_pointer_cast<LongColumnVector>(vector);
+    if(offset == 0) {
+        decoder = std::make_shared<RunLenIntDecoder>(input, true);
+        ColumnReader::elementIndex = 0;
+        isLong = type->getCategory() == TypeDescription::Category::LONG;
+        isNullOffset = chunkIndex.isnulloffset();
+    }
+
+    int pixelId = elementIndex / pixelStride;
+    bool hasNull = PixelIndex::hasNull(chunkIndex, pixelId);
+    setValid(input, pixelStride, vector, pixelId, hasNull);
+
+    if(isLong) {
+        readRunsAndFilter<int64_t>(*decoder, columnVector->longVector + vectorIndex, size,
+                                   vector, *filterMask, filter);
+    } else {
+        readRunsAndFilter<int32_t>(*decoder, reinterpret_cast<int32_t*>(columnVector->intVector) + vectorIndex,
+                                   size, vector, *filterMask, filter);
+    }
+    elementIndex += size;
+    return true;
+}
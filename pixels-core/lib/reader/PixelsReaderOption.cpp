@@ -11,6 +11,7 @@ PixelsReaderOption::PixelsReaderOption() {
     enableEncodedColumnVector = true;
     enableFilterPushDown = false;
     queryId = -1L;
+    priority = RequestPriority::INTERACTIVE;
     batchSize = 0;
     rgStart = 0;
     rgLen = -1;  // -1 means reading to the end of the file
@@ -93,12 +94,10 @@ int PixelsReaderOption::getBatchSize() const {
     return batchSize;
 }
 
+void PixelsReaderOption::setPriority(RequestPriority priority) {
+    this->priority = priority;
+}
 
-
-
-
-
-
-
-
-
+RequestPriority PixelsReaderOption::getPriority() {
+    return priority;
+}
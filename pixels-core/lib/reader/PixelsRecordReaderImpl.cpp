@@ -5,16 +5,40 @@
 #include "reader/PixelsRecordReaderImpl.h"
 #include "physical/io/PhysicalLocalReader.h"
 #include "profiler/CountProfiler.h"
+#include "physical/compression/BlockCompressor.h"
+#include "utils/ThreadPool.h"
+#include "utils/ProtoArena.h"
+#include "exception/InvalidArgumentException.h"
+
+namespace {
+
+// the decompression workers are shared by all the scan threads
+ThreadPool & DecompressionPool() {
+    static ThreadPool pool(std::stoi(ConfigFactory::Instance().getProperty("compression.decompress.threads")));
+    return pool;
+}
+
+std::shared_ptr<pixels::proto::RowGroupFooter> parseRGFooter(const uint8_t * data, int length) {
+    auto footer = parseOnArena<pixels::proto::RowGroupFooter>(data, length);
+    if(footer == nullptr) {
+        throw InvalidArgumentException("PixelsRecordReaderImpl: parsing RowGroupFooter error!");
+    }
+    return footer;
+}
+
+}
 
 PixelsRecordReaderImpl::PixelsRecordReaderImpl(std::shared_ptr<PhysicalReader> reader,
-                                               const pixels::proto::PostScript& pixelsPostScript,
-                                               const pixels::proto::Footer& pixelsFooter,
+                                               std::shared_ptr<TypeDescription> fileSchema,
+                                               std::shared_ptr<pixels::proto::FileTail> fileTail,
                                                const PixelsReaderOption& opt,
-                                               std::shared_ptr<PixelsFooterCache> pixelsFooterCache) {
+                                               std::shared_ptr<PixelsFooterCache> pixelsFooterCache)
+        : fileTail(fileTail), footer(fileTail->footer()), postScript(fileTail->postscript()) {
     physicalReader = reader;
-    footer = pixelsFooter;
-    postScript = pixelsPostScript;
+    this->fileSchema = fileSchema;
     footerCache = pixelsFooterCache;
+    chunkCache = PixelsChunkCache::Instance();
+    vectorCache = PixelsVectorCache::Instance();
     option = opt;
     // TODO: intialize all kinds of variables
     queryId = option.getQueryId();
@@ -47,14 +71,8 @@ PixelsRecordReaderImpl::PixelsRecordReaderImpl(std::shared_ptr<PhysicalReader> r
 }
 
 void PixelsRecordReaderImpl::checkBeforeRead() {
-    // get file schema
-    auto fileColTypesFooterTypes = footer.types();
-    auto fileColTypes = std::vector<std::shared_ptr<pixels::proto::Type>>{};
-    for(const auto& type : fileColTypesFooterTypes) {
-        fileColTypes.emplace_back(std::make_shared<::pixels::proto::Type>(type));
-    }
-    // TODO: if fileCOlTypes == null
-    fileSchema = TypeDescription::createSchema(fileColTypes);
+    // the file schema is built by the PixelsReader, only the types of the result columns are needed here
+    const auto& fileColTypes = footer.types();
     // TODO: getChildren == NULL
     // filter included columns
     includedColumnNum = 0;
@@ -66,7 +84,7 @@ void PixelsRecordReaderImpl::checkBeforeRead() {
     std::vector<int> optionColsIndices;
     for(const auto& col: optionIncludedCols) {
         for(int j = 0; j < fileColTypes.size(); j ++) {
-            if(icompare(col, fileColTypes.at(j)->name())) {
+            if(icompare(col, fileColTypes.Get(j).name())) {
                 optionColsIndices.emplace_back(j);
                 includedColumns.at(j) = true;
                 includedColumnNum++;
@@ -108,10 +126,21 @@ void PixelsRecordReaderImpl::checkBeforeRead() {
 
     // create result vectorized row batch
     for(int resultColumn: resultColumns) {
-        includedColumnTypes.emplace_back(fileColTypes.at(resultColumn));
+        // share the types with the file tail instead of copying them
+        includedColumnTypes.emplace_back(fileTail, const_cast<pixels::proto::Type *>(&fileColTypes.Get(resultColumn)));
     }
     resultSchema = TypeDescription::createSchema(includedColumnTypes);
 
+    vectorsCached.assign(resultColumns.size(), false);
+    vectorsPinned.assign(resultColumns.size(), false);
+    copiedDictionaries.resize(resultColumns.size());
+    if(vectorCache != nullptr) {
+        for(int i = 0; i < resultColumns.size(); i++) {
+            const std::string & name = fileColTypes.Get(resultColumns.at(i)).name();
+            vectorsCached.at(i) = vectorCache->isCached(fileName, name);
+            vectorsPinned.at(i) = vectorCache->isPinned(fileName, name);
+        }
+    }
 }
 
 
@@ -119,11 +148,6 @@ void PixelsRecordReaderImpl::UpdateRowGroupInfo() {
 	// if not end of file, update row count
 	curRGRowCount = (int) footer.rowgroupinfos(targetRGs.at(curRGIdx)).numberofrows();
 
-    if(enabledFilterPushDown) {
-        int length = std::min(batchSize, curRGRowCount);
-        filterMask = std::make_shared<PixelsBitMask>(length);
-    }
-
 	curRGFooter = rowGroupFooters.at(curRGIdx);
 	// refresh resultColumnsEncoded for reading the column vectors in the next row group.
 	const pixels::proto::RowGroupEncoding& rgEncoding = rowGroupFooters.at(curRGIdx)->rowgroupencoding();
@@ -133,11 +157,17 @@ void PixelsRecordReaderImpl::UpdateRowGroupInfo() {
 		            .kind() != pixels::proto::ColumnEncoding_Kind_NONE
 		    && enableEncodedVector;
 	}
+	// the encodings and chunk indexes of the result columns are views of the row group footer
+	const pixels::proto::RowGroupIndex& rgIndex = curRGFooter->rowgroupindexentry();
 	for(int i = 0; i < resultColumns.size(); i++) {
-		curEncoding.at(i) = std::make_shared<pixels::proto::ColumnEncoding>(rgEncoding.columnchunkencodings(resultColumns.at(i)));
+		curEncoding.at(i) = std::shared_ptr<pixels::proto::ColumnEncoding>(curRGFooter,
+		        const_cast<pixels::proto::ColumnEncoding *>(&rgEncoding.columnchunkencodings(resultColumns.at(i))));
 		curChunkBufferIndex.at(i) = resultColumns.at(i);
-		curChunkIndex.at(i) = std::make_shared<pixels::proto::ColumnChunkIndex>(curRGFooter->rowgroupindexentry()
-		                          .columnchunkindexentries(resultColumns.at(i)));
+		curChunkIndex.at(i) = std::shared_ptr<pixels::proto::ColumnChunkIndex>(curRGFooter,
+		        const_cast<pixels::proto::ColumnChunkIndex *>(&rgIndex.columnchunkindexentries(resultColumns.at(i))));
+	}
+	if(filter != nullptr) {
+		updatePixelMatches();
 	}
 	// This flag makes sure that each row group invokes read()
 	everRead = false;
@@ -159,6 +189,10 @@ std::shared_ptr<VectorizedRowBatch> PixelsRecordReaderImpl::readBatch(bool reuse
 		if(!read()) {
 			throw std::runtime_error("failed to read file");
 		}
+		if(endOfFile) {
+			// all the row groups are pruned by the statistics
+			return createEmptyEOFRowBatch(0);
+		}
 	}
 
 
@@ -177,51 +211,80 @@ std::shared_ptr<VectorizedRowBatch> PixelsRecordReaderImpl::readBatch(bool reuse
     }
 
     auto columnVectors = resultRowBatch->cols;
-    if(filterMask != nullptr) {
+    if(enabledFilterPushDown) {
+        // the mask is replaced here instead of when moving to the next row group, since the
+        // caller reads the mask of the last batch of a row group after this batch is returned
+        int length = std::min(batchSize, curRGRowCount);
+        if(filterMask == nullptr || filterMask->maskLength != length) {
+            filterMask = std::make_shared<PixelsBitMask>(length);
+        }
         filterMask->set();
+        // the last batch of a row group may be shorter than the mask
+        filterMask->setRange(curBatchSize, filterMask->maskLength, 0);
     }
 
-    std::vector<int> filterColumnIndex;
-    if(has_async_task_num_ > 0) {
-      asyncReadComplete(has_async_task_num_);
+    if(filter != nullptr) {
+        // the batch may overlap several pixels, only the rows of the pixels that cannot
+        // satisfy the filters are cleared
+        int pixelStride = (int) postScript.pixelstride();
+        int batchEnd = curRowInRG + curBatchSize;
+        int prunedPixels = 0;
+        for(int rowId = curRowInRG; rowId < batchEnd; ) {
+            int pixelId = rowId / pixelStride;
+            int pixelEnd = std::min((pixelId + 1) * pixelStride, batchEnd);
+            if(!checkPixelStatistics(pixelId)) {
+                filterMask->setRange(rowId - curRowInRG, pixelEnd - curRowInRG, 0);
+                prunedPixels++;
+            }
+            rowId = pixelEnd;
+        }
+        if(prunedPixels > 0) {
+            ::CountProfiler::Instance().Count("pruned pixels", prunedPixels);
+        }
     }
+    // The columns are decoded in the order their chunks arrive, so that decoding overlaps with the
+    // reads and decompressions in flight. The filter columns go first, so that the other columns
+    // are skipped without being decoded as soon as no row survives the filters.
+    std::vector<int> filterColumnIndex;
     if(filter != nullptr) {
+        std::vector<int> filterColumns;
+        std::vector<duckdb::TableFilter *> tableFilters;
         for (auto &filterCol : filter->filters) {
-            if(filterMask->isNone()) {
-                break;
-            }
-            int i = filterCol.first;
-            int index = curChunkBufferIndex.at(i);
-            auto & encoding = curEncoding.at(i);
-            auto & chunkIndex = curChunkIndex.at(i);
-            readers.at(i)->read(chunkBuffers.at(index), *encoding, curRowInRG, curBatchSize,
-                                postScript.pixelstride(), resultRowBatch->rowCount,
-                                columnVectors.at(i), *chunkIndex, filterMask);
-            filterColumnIndex.emplace_back(index);
-            PixelsFilter::ApplyFilter(columnVectors.at(i), *filterCol.second, *filterMask,
-                                      resultSchema->getChildren().at(i));
+            filterColumns.emplace_back(filterCol.first);
+            tableFilters.emplace_back(filterCol.second.get());
+        }
+        while(!filterColumns.empty() && !filterMask->isNone()) {
+            size_t next = waitAnyChunk(filterColumns);
+            int i = filterColumns.at(next);
+            filterColumnIndex.emplace_back(curChunkBufferIndex.at(i));
+            filterColumn(i, *tableFilters.at(next), curBatchSize, columnVectors);
+            filterColumns.erase(filterColumns.begin() + next);
+            tableFilters.erase(tableFilters.begin() + next);
         }
     }
 
+    // if no row survives the filters, the remaining columns are skipped instead of decoded.
+    // The column readers still advance their state, so that the next batch is read correctly (Issue #564).
+    bool skipBatch = filterMask != nullptr && filterMask->isNone();
+    // the vectors are only cached if none of their rows are skipped by the filters
+    bool decodedAll = filterMask == nullptr || filterMask->nextClearBit(0, curBatchSize) == curBatchSize;
     // read vectors
+    std::vector<int> columns;
     for(int i = 0; i < resultColumns.size(); i++) {
-        // TODO: Refer to Issue #564. Disable data skipping
-        //if(filterMask != nullptr) {
-        //    if(filterMask->isNone()) {
-        //        break;
-        //    }
-        //}
         // Skip the columns that calculate the filter mask, since they are already processed
         int index = curChunkBufferIndex.at(i);
-        if(std::find(filterColumnIndex.begin(), filterColumnIndex.end(), index) != filterColumnIndex.end()) {
-            continue;
+        if(std::find(filterColumnIndex.begin(), filterColumnIndex.end(), index) == filterColumnIndex.end()) {
+            columns.emplace_back(i);
         }
-        auto & encoding = curEncoding.at(i);
-        auto & chunkIndex = curChunkIndex.at(i);
-        readers.at(i)->read(chunkBuffers.at(index), *encoding, curRowInRG, curBatchSize,
-                            postScript.pixelstride(), resultRowBatch->rowCount,
-                            columnVectors.at(i), *chunkIndex, filterMask);
     }
+    while(!columns.empty()) {
+        size_t next = waitAnyChunk(columns);
+        readColumn(columns.at(next), curBatchSize, skipBatch, decodedAll, columnVectors);
+        columns.erase(columns.begin() + next);
+    }
+    // the chunks are cached once all of them are read and decompressed
+    waitDecompression();
+    cacheReadChunks();
 
     // update current row index in the row group
     curRowInRG += curBatchSize;
@@ -248,10 +311,18 @@ void PixelsRecordReaderImpl::prepareRead() {
     includedRGs.resize(RGLen);
 
     uint64_t includedRowNum = 0;
+    int prunedRGNum = 0;
     // read row group statistics and find target row groups
     for(int i = 0; i < RGLen; i++) {
-        includedRGs.at(i) = true;
-        includedRowNum += footer.rowgroupinfos(RGStart + i).numberofrows();
+        includedRGs.at(i) = checkRowGroupStatistics(RGStart + i);
+        if(includedRGs.at(i)) {
+            includedRowNum += footer.rowgroupinfos(RGStart + i).numberofrows();
+        } else {
+            prunedRGNum++;
+        }
+    }
+    if(prunedRGNum > 0) {
+        ::CountProfiler::Instance().Count("pruned row groups", prunedRGNum);
     }
     targetRGs.clear();
     targetRGs.resize(RGLen);
@@ -264,13 +335,15 @@ void PixelsRecordReaderImpl::prepareRead() {
     }
     targetRGNum = targetRGIdx;
 
-    // TODO: if taregetRGNum == 0
+    if(targetRGNum == 0) {
+        // all the row groups are pruned, nothing needs to be read
+        endOfFile = true;
+        return;
+    }
 
     // read row group footers
     rowGroupFooters.clear();
     rowGroupFooters.resize(targetRGNum);
-    std::vector<bool> rowGroupFooterCacheHit;
-    rowGroupFooterCacheHit.resize(targetRGNum);
 
     /**
      * Issue #114:
@@ -280,39 +353,45 @@ void PixelsRecordReaderImpl::prepareRead() {
      * the subsequent queries on the same table.
      */
     RequestBatch requestBatch;
+    requestBatch.setPriority(option.getPriority());
     std::vector<int> fis;
     std::vector<std::string> rgCacheIds;
+    std::string fileCacheId = footerCache != nullptr ? PixelsFooterCache::getFileId(physicalReader) : fileName;
     for(int i = 0; i < targetRGNum; i++) {
         int rgId = targetRGs[i];
-        std::string rgCacheId = fileName + "-" + std::to_string(rgId);
+        std::string rgCacheId = fileCacheId + "-" + std::to_string(rgId);
         rgCacheIds.emplace_back(rgCacheId);
-        if(footerCache != nullptr && footerCache->containsRGFooter(rgCacheId)) {
+        std::shared_ptr<pixels::proto::RowGroupFooter> cached =
+                footerCache != nullptr ? footerCache->findRGFooter(rgCacheId) : nullptr;
+        if(cached != nullptr) {
             // cache hit
-            rowGroupFooters.at(i) = footerCache->getRGFooter(rgCacheId);
-            rowGroupFooterCacheHit.at(i) = true;
+            rowGroupFooters.at(i) = cached;
         } else {
             // cache miss, read from disk and put it into cache
             const pixels::proto::RowGroupInformation& rowGroupInformation = footer.rowgroupinfos(rgId);
             uint64_t footerOffset = rowGroupInformation.footeroffset();
             uint64_t footerLength = rowGroupInformation.footerlength();
             fis.push_back(i);
-            requestBatch.add(queryId, (int) footerOffset, (int) footerLength);
-            rowGroupFooterCacheHit.at(i) = false;
+            if(!postScript.rowgroupfootersconsolidated()) {
+                requestBatch.add(queryId, (int) footerOffset, (int) footerLength);
+            }
         }
     }
+    if(postScript.rowgroupfootersconsolidated() && !fis.empty()) {
+        readConsolidatedRGFooters(fis, rgCacheIds, fileCacheId);
+        fis.clear();
+    }
     Scheduler * scheduler = SchedulerFactory::Instance()->getScheduler();
     auto bbs = scheduler->executeBatch(physicalReader, requestBatch, queryId);
     // TODO: the return value should be unique_ptr?
 
+    // bbs[i] is the footer of the i-th missed row group, i.e., fis[i]
     for(int i = 0; i < bbs.size(); i++) {
-        if(!rowGroupFooterCacheHit.at(i)) {
-			auto parsed = std::make_shared<pixels::proto::RowGroupFooter>();
-            parsed->ParseFromArray(bbs[i]->getPointer(), (int)bbs[i]->size());
-            rowGroupFooters.at(fis[i]) = parsed;
-			if(footerCache != nullptr) {
-				footerCache->putRGFooter(rgCacheIds[fis[i]], parsed);
-			}
-        }
+		auto parsed = parseRGFooter(bbs[i]->getPointer(), (int)bbs[i]->size());
+        rowGroupFooters.at(fis[i]) = parsed;
+		if(footerCache != nullptr) {
+			footerCache->putRGFooter(rgCacheIds[fis[i]], parsed);
+		}
     }
 
     bbs.clear();
@@ -325,20 +404,302 @@ void PixelsRecordReaderImpl::prepareRead() {
 	UpdateRowGroupInfo();
 }
 
+/**
+ * Check the row group statistics in the file footer against the pushed-down filters.
+ *
+ * @param rgId the id of the row group in the file
+ * @return false if the row group can not contain any row satisfying the filters
+ */
+bool PixelsRecordReaderImpl::checkRowGroupStatistics(int rgId) {
+    if(filter == nullptr || rgId >= footer.rowgroupstats_size()) {
+        return true;
+    }
+    const pixels::proto::RowGroupStatistic& rgStats = footer.rowgroupstats(rgId);
+    auto columnTypes = resultSchema->getChildren();
+    for(auto &filterCol : filter->filters) {
+        int i = (int) filterCol.first;
+        uint32_t colId = resultColumns.at(i);
+        if(colId >= rgStats.columnchunkstats_size()) {
+            continue;
+        }
+        if(!PixelsFilter::CheckStatistics(rgStats.columnchunkstats(colId), *filterCol.second,
+                                          columnTypes.at(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Check the pixel statistics of the filter columns for all the pixels in the current row group.
+ * The columnar pixel indexes are checked in a single pass over their arrays, the pixel statistics
+ * are checked one pixel after another.
+ */
+void PixelsRecordReaderImpl::updatePixelMatches() {
+    int pixelNum = (curRGRowCount + postScript.pixelstride() - 1) / postScript.pixelstride();
+    pixelMatches.assign(pixelNum, 1);
+    auto columnTypes = resultSchema->getChildren();
+    for(auto &filterCol : filter->filters) {
+        int i = (int) filterCol.first;
+        auto & chunkIndex = curChunkIndex.at(i);
+        if(chunkIndex->has_pixelindex()) {
+            PixelIndex pixelIndex(*chunkIndex);
+            if(pixelIndex.getPixelNum() == pixelNum) {
+                PixelsFilter::CheckPixelIndex(pixelIndex, *filterCol.second, columnTypes.at(i), pixelMatches.data());
+            }
+            continue;
+        }
+        int statNum = std::min(pixelNum, chunkIndex->pixelstatistics_size());
+        for(int pixelId = 0; pixelId < statNum; pixelId++) {
+            if(pixelMatches[pixelId] && !PixelsFilter::CheckStatistics(
+                    chunkIndex->pixelstatistics(pixelId).statistic(), *filterCol.second, columnTypes.at(i))) {
+                pixelMatches[pixelId] = 0;
+            }
+        }
+    }
+}
+
+/**
+ * @param pixelId the id of the pixel in the current row group
+ * @return false if the pixel can not contain any row satisfying the filters
+ */
+bool PixelsRecordReaderImpl::checkPixelStatistics(int pixelId) {
+    return pixelId >= pixelMatches.size() || pixelMatches[pixelId];
+}
+
 void PixelsRecordReaderImpl::asyncReadComplete(int requestSize) {
-    if(ConfigFactory::Instance().boolCheckProperty("localfs.enable.async.io")
-      && has_async_task_num_ >= requestSize) {
-        if(ConfigFactory::Instance().getProperty("localfs.async.lib") == "iouring") {
-            auto localReader = std::static_pointer_cast<PhysicalLocalReader>(physicalReader);
-            localReader->readAsyncComplete(requestSize);
-          has_async_task_num_ -= requestSize;
-        } else if(ConfigFactory::Instance().getProperty("localfs.async.lib") == "aio") {
-            throw InvalidArgumentException("PhysicalLocalReader::readAsync: We don't support aio for our async read yet.");
+    for(int i = 0; i < requestSize && has_async_task_num_ > 0; i++) {
+        completeAsyncRead();
+    }
+}
+
+/**
+ * Wait for the next async read of this reader to complete, and start decompressing its chunk
+ * while the other reads are in flight.
+ */
+void PixelsRecordReaderImpl::completeAsyncRead() {
+    auto localReader = std::static_pointer_cast<PhysicalLocalReader>(physicalReader);
+    int bufferId = localReader->readAsyncCompleteNext([this](int id) {
+        return asyncChunks.count(id) > 0;
+    });
+    uint32_t colId = asyncChunks.at(bufferId);
+    asyncChunks.erase(bufferId);
+    has_async_task_num_--;
+    if(postScript.compression() != pixels::proto::CompressionKind::NONE) {
+        decompressChunk(colId);
+    }
+}
+
+/**
+ * @return whether the chunk of the column is read and decompressed
+ */
+bool PixelsRecordReaderImpl::isChunkReady(uint32_t colId) {
+    for(auto & chunk : asyncChunks) {
+        if(chunk.second == colId) {
+            return false;
+        }
+    }
+    auto task = decompressTasks.find(colId);
+    if(task == decompressTasks.end()) {
+        return true;
+    }
+    if(task->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return false;
+    }
+    task->second.get();
+    decompressTasks.erase(task);
+    return true;
+}
+
+/**
+ * Wait until the chunk of one of the result columns is ready, completing the reads of this reader
+ * one at a time.
+ * @return the position in columns of the column whose chunk is ready
+ */
+size_t PixelsRecordReaderImpl::waitAnyChunk(const std::vector<int> & columns) {
+    while(true) {
+        for(size_t next = 0; next < columns.size(); next++) {
+            if(isChunkReady(curChunkBufferIndex.at(columns.at(next)))) {
+                return next;
+            }
+        }
+        if(has_async_task_num_ > 0) {
+            completeAsyncRead();
+        } else {
+            // all the chunks are read, wait for the decompression of the first one
+            decompressTasks.at(curChunkBufferIndex.at(columns.front())).wait();
+        }
+    }
+}
+
+/**
+ * Decode the filter column of the current batch and narrow the filter mask by its filter.
+ */
+void PixelsRecordReaderImpl::filterColumn(int i, duckdb::TableFilter & tableFilter, int size,
+                                          std::vector<std::shared_ptr<ColumnVector>> & columnVectors) {
+    int index = curChunkBufferIndex.at(i);
+    auto & encoding = curEncoding.at(i);
+    auto & chunkIndex = curChunkIndex.at(i);
+    // evaluate the filter on the encoded data (RLE runs or dictionary entries) if possible
+    if(readers.at(i)->readAndFilter(chunkBuffers.at(index), *encoding, curRowInRG, size,
+                                    postScript.pixelstride(), resultRowBatch->rowCount,
+                                    columnVectors.at(i), *chunkIndex, filterMask, tableFilter)) {
+        return;
+    }
+    readers.at(i)->read(chunkBuffers.at(index), *encoding, curRowInRG, size,
+                        postScript.pixelstride(), resultRowBatch->rowCount,
+                        columnVectors.at(i), *chunkIndex, filterMask);
+    // the rows filtered out by the previous filter columns are not decoded in this column,
+    // so the result of this column must be combined with the current mask
+    PixelsBitMask columnMask(filterMask->maskLength);
+    columnMask.And(*filterMask);
+    PixelsFilter::ApplyFilter(columnVectors.at(i), tableFilter, columnMask,
+                              resultSchema->getChildren().at(i));
+    filterMask->And(columnMask);
+}
+
+/**
+ * Decode the column of the current batch, or skip it if no row survives the filters or its
+ * vector is in the vector cache.
+ */
+void PixelsRecordReaderImpl::readColumn(int i, int size, bool skipBatch, bool decodedAll,
+                                        std::vector<std::shared_ptr<ColumnVector>> & columnVectors) {
+    int index = curChunkBufferIndex.at(i);
+    auto & encoding = curEncoding.at(i);
+    auto & chunkIndex = curChunkIndex.at(i);
+    std::string vectorId = skipBatch ? "" : getVectorId(i, size);
+    std::shared_ptr<DecodedVector> cachedVector = vectorId.empty() ? nullptr : vectorCache->find(vectorId);
+    if(skipBatch || cachedVector != nullptr) {
+        // the values of a cached vector are referenced from the cache instead of decoded
+        readers.at(i)->skip(chunkBuffers.at(index), *encoding, curRowInRG, size,
+                            postScript.pixelstride(), resultRowBatch->rowCount,
+                            columnVectors.at(i), *chunkIndex);
+        columnVectors.at(i)->cachedVector = cachedVector;
+    } else {
+        readers.at(i)->read(chunkBuffers.at(index), *encoding, curRowInRG, size,
+                            postScript.pixelstride(), resultRowBatch->rowCount,
+                            columnVectors.at(i), *chunkIndex, filterMask);
+        if(!vectorId.empty() && decodedAll) {
+            cacheVector(i, vectorId, size);
+        }
+    }
+}
+
+
+/**
+ * Read the consolidated RowGroupFooters of all the row groups in a single read. Besides the
+ * missed target row groups, the footers of the other row groups are also put into the footer
+ * cache, as they are likely to be read by the other scan units on this file.
+ */
+void PixelsRecordReaderImpl::readConsolidatedRGFooters(const std::vector<int> & missedTargets,
+                                                       const std::vector<std::string> & rgCacheIds,
+                                                       const std::string & fileCacheId) {
+    int rgNum = footer.rowgroupinfos_size();
+    std::vector<uint64_t> footerStarts(rgNum + 1, 0);
+    for(int rgId = 0; rgId < rgNum; rgId++) {
+        footerStarts[rgId + 1] = footerStarts[rgId] + footer.rowgroupinfos(rgId).footerlength();
+    }
+    RequestBatch requestBatch;
+    requestBatch.setPriority(option.getPriority());
+    requestBatch.add(queryId, (int) postScript.rowgroupfootersoffset(), (int) footerStarts[rgNum]);
+    Scheduler * scheduler = SchedulerFactory::Instance()->getScheduler();
+    auto bbs = scheduler->executeBatch(physicalReader, requestBatch, queryId);
+    uint8_t * footers = bbs.at(0)->getPointer();
+
+    for(int i : missedTargets) {
+        int rgId = targetRGs[i];
+        auto parsed = parseRGFooter(footers + footerStarts[rgId],
+                (int) (footerStarts[rgId + 1] - footerStarts[rgId]));
+        rowGroupFooters.at(i) = parsed;
+        if(footerCache != nullptr) {
+            footerCache->putRGFooter(rgCacheIds[i], parsed);
+        }
+    }
+    if(footerCache != nullptr) {
+        std::vector<bool> isTarget(rgNum, false);
+        for(int i : missedTargets) {
+            isTarget[targetRGs[i]] = true;
+        }
+        for(int rgId = 0; rgId < rgNum; rgId++) {
+            std::string rgCacheId = fileCacheId + "-" + std::to_string(rgId);
+            if(isTarget[rgId] || footerCache->findRGFooter(rgCacheId) != nullptr) {
+                continue;
+            }
+            auto parsed = parseRGFooter(footers + footerStarts[rgId],
+                    (int) (footerStarts[rgId + 1] - footerStarts[rgId]));
+            footerCache->putRGFooter(rgCacheId, parsed);
+        }
+    }
+}
+
+/**
+ * Submit the compressed chunk of the column to the decompression workers.
+ * The chunk buffer is replaced by the decompressed buffer from the buffer pool,
+ * which is ready after waitDecompression() returns.
+ */
+void PixelsRecordReaderImpl::decompressChunk(uint32_t colId) {
+    std::shared_ptr<ByteBuffer> compressed = chunkBuffers.at(colId);
+    if(compressed == nullptr) {
+        return;
+    }
+    uint64_t length = BlockCompressor::getDecompressedLength(compressed->getPointer(), compressed->size());
+    if(length == 0) {
+        return;
+    }
+    // the buffer pool is thread local, so the buffer is taken on the scan thread
+    std::shared_ptr<ByteBuffer> buffer = ::BufferPool::GetDecompressBuffer(colId, length);
+    chunkBuffers.at(colId) = std::make_shared<ByteBuffer>(*buffer, 0, length);
+    pixels::proto::CompressionKind kind = postScript.compression();
+    ::CountProfiler::Instance().Count("decompressed chunks");
+    decompressTasks[colId] = DecompressionPool().submit([kind, compressed, buffer, length]() {
+        BlockCompressor::decompress(kind, compressed->getPointer(), compressed->size(),
+                                    buffer->getPointer(), length);
+    });
+}
+
+/**
+ * Put the chunks read from the disk into the chunk cache, once they are read and decompressed.
+ */
+void PixelsRecordReaderImpl::cacheReadChunks() {
+    for(auto & chunk : chunksToCache) {
+        std::shared_ptr<ByteBuffer> buffer = chunkBuffers.at(chunk.first);
+        if(buffer != nullptr) {
+            chunkCache->put(chunk.second, buffer->getPointer(), buffer->size());
         }
     }
+    chunksToCache.clear();
+}
+
+/**
+ * @return the id of the vector of the i-th result column in the current batch in the vector cache,
+ * or an empty string if the vector is not cached.
+ */
+std::string PixelsRecordReaderImpl::getVectorId(int i, int size) {
+    if(vectorCache == nullptr || !vectorsCached.at(i)) {
+        return "";
+    }
+    // the plain encoded values are copied rather than decoded, caching them saves nothing unless they are pinned
+    if(!vectorsPinned.at(i) && curEncoding.at(i)->kind() == pixels::proto::ColumnEncoding_Kind_NONE) {
+        return "";
+    }
+    return PixelsVectorCache::getVectorId(cacheFileId, targetRGs.at(curRGIdx), resultColumns.at(i), curRowInRG, size);
+}
 
+void PixelsRecordReaderImpl::cacheVector(int i, const std::string & vectorId, int size) {
+    std::shared_ptr<DecodedVector> decoded = DecodedVector::copyOf(
+            resultRowBatch->cols.at(i), resultSchema->getChildren().at(i)->getCategory(), size,
+            copiedDictionaries.at(i));
+    if(decoded != nullptr) {
+        vectorCache->put(vectorId, decoded, vectorsPinned.at(i));
+    }
 }
 
+void PixelsRecordReaderImpl::waitDecompression() {
+    for(auto & task : decompressTasks) {
+        task.second.get();
+    }
+    decompressTasks.clear();
+}
 
 std::shared_ptr<PixelsBitMask> PixelsRecordReaderImpl::getFilterMask() {
     return filterMask;
@@ -350,17 +711,21 @@ bool PixelsRecordReaderImpl::read() {
 	}
 
     everRead = true;
+    if(targetRGNum == 0) {
+        return true;
+    }
 
     // read chunk offset and length of each target column chunks
 
     // TODO: this should remove later
     chunkBuffers.clear();
     chunkBuffers.resize(includedColumns.size());
-    std::vector<ChunkId> diskChunks;
-    diskChunks.reserve(targetColumns.size());
-
-
-    // TODO: support cache read
+    std::vector<ChunkId> chunks;
+    chunks.reserve(targetColumns.size());
+    chunksToCache.clear();
+    if((chunkCache != nullptr || vectorCache != nullptr) && cacheFileId.empty()) {
+        cacheFileId = PixelsFooterCache::getFileId(physicalReader);
+    }
 
 	const pixels::proto::RowGroupIndex& rowGroupIndex =
 			rowGroupFooters[curRGIdx]->rowgroupindexentry();
@@ -371,32 +736,60 @@ bool PixelsRecordReaderImpl::read() {
             throw InvalidArgumentException("Pixels C++ reader only supports little endianness. ");
         }
 		ChunkId chunk(curRGIdx, colId, chunkIndex.chunkoffset(), chunkIndex.chunklength());
-		diskChunks.emplace_back(chunk);
+		chunks.emplace_back(chunk);
+		if(chunkCache != nullptr) {
+			// the cached chunk is decompressed already
+			std::string chunkId = PixelsChunkCache::getChunkId(cacheFileId, targetRGs.at(curRGIdx), colId);
+			chunkBuffers.at(colId) = chunkCache->find(chunkId);
+			if(chunkBuffers.at(colId) == nullptr) {
+				chunksToCache.emplace_back(colId, chunkId);
+			}
+		}
 	}
 
-
-    if(!diskChunks.empty()) {
-        RequestBatch requestBatch((int)diskChunks.size());
-        Scheduler * scheduler = SchedulerFactory::Instance()->getScheduler();
+    if(!chunks.empty()) {
+        // the buffer pool keeps a buffer for each target column, so that the buffer ids do not depend on the cache hits
 		std::vector<uint32_t> colIds;
 		std::vector<uint64_t> bytes;
-        for(int i = 0; i < diskChunks.size(); i++) {
-            ChunkId chunk = diskChunks.at(i);
-            requestBatch.add(queryId, chunk.offset, (int)chunk.length, ::BufferPool::GetBufferId(i));
+        for(const ChunkId & chunk : chunks) {
 			colIds.emplace_back(chunk.columnId);
 			bytes.emplace_back(chunk.length);
         }
 		::BufferPool::Initialize(colIds, bytes, fileSchema->getFieldNames());
-        ::DirectUringRandomAccessFile::RegisterBufferFromPool(colIds);
+        if(ConfigFactory::Instance().getProperty("localfs.async.lib") == "iouring") {
+            ::DirectUringRandomAccessFile::RegisterBufferFromPool(colIds);
+        }
+
+		// only the chunks missed in the chunk cache are read
+		std::vector<ChunkId> diskChunks;
+		std::vector<int64_t> chunkBufferIds;
 		std::vector<std::shared_ptr<ByteBuffer>> originalByteBuffers;
-		for(int i = 0; i < colIds.size(); i++) {
-            auto colId = colIds.at(i);
-			originalByteBuffers.emplace_back(::BufferPool::GetBuffer(colId));
+		for(int i = 0; i < chunks.size(); i++) {
+			const ChunkId & chunk = chunks.at(i);
+			if(chunkBuffers.at(chunk.columnId) != nullptr) {
+				continue;
+			}
+			diskChunks.emplace_back(chunk);
+			chunkBufferIds.emplace_back(::BufferPool::GetBufferId(i));
+			originalByteBuffers.emplace_back(::BufferPool::GetBuffer(chunk.columnId));
+		}
+		if(diskChunks.size() < chunks.size()) {
+			::CountProfiler::Instance().Count("cached chunks", (int) (chunks.size() - diskChunks.size()));
+		}
+		if(diskChunks.empty()) {
+			return true;
+		}
+        RequestBatch requestBatch((int)diskChunks.size());
+        requestBatch.setPriority(option.getPriority());
+        Scheduler * scheduler = SchedulerFactory::Instance()->getScheduler();
+		for(int i = 0; i < diskChunks.size(); i++) {
+			requestBatch.add(queryId, diskChunks.at(i).offset, (int)diskChunks.at(i).length, chunkBufferIds.at(i));
 		}
 
 		auto byteBuffers = scheduler->executeBatch(physicalReader, requestBatch, originalByteBuffers, queryId);
 
-      if(ConfigFactory::Instance().boolCheckProperty("localfs.enable.async.io") && originalByteBuffers.size() > 0) {
+      bool asyncRead = ConfigFactory::Instance().boolCheckProperty("localfs.enable.async.io") && originalByteBuffers.size() > 0;
+      if(asyncRead) {
         has_async_task_num_ += diskChunks.size();
       }
         for(int index = 0; index < diskChunks.size(); index++) {
@@ -406,6 +799,12 @@ bool PixelsRecordReaderImpl::read() {
             if(bb != nullptr) {
                 chunkBuffers.at(colId) = bb;
             }
+            if(asyncRead) {
+                // decoded, and decompressed if needed, when the read completes
+                asyncChunks[chunkBufferIds.at(index)] = colId;
+            } else if(postScript.compression() != pixels::proto::CompressionKind::NONE) {
+                decompressChunk(colId);
+            }
         }
     }
     return true;
@@ -438,6 +837,12 @@ bool PixelsRecordReaderImpl::isEndOfFile() {
 }
 
 void PixelsRecordReaderImpl::close() {
+	// the decompression workers may still be writing into the buffer pool
+	for(auto & task : decompressTasks) {
+		task.second.wait();
+	}
+	decompressTasks.clear();
+	asyncChunks.clear();
 	// release chunk buffers
 	chunkBuffers.clear();
 	for(const auto& reader: readers) {
@@ -4,6 +4,7 @@
 
 #include "reader/StringColumnReader.h"
 #include "profiler/CountProfiler.h"
+#include <cstring>
 
 StringColumnReader::StringColumnReader(std::shared_ptr<TypeDescription> type) : ColumnReader(type) {
     bufferOffset = 0;
@@ -18,6 +19,8 @@ StringColumnReader::StringColumnReader(std::shared_ptr<TypeDescription> type) :
     dictStartsOffset = 0;
     dictStarts = nullptr;
     startsLength = 0;
+    dictFilter = nullptr;
+    dictionary = nullptr;
 }
 
 void StringColumnReader::close() {
@@ -39,11 +42,20 @@ void StringColumnReader::read(std::shared_ptr<ByteBuffer> input, pixels::proto::
     }
 
     int pixelId = elementIndex / pixelStride;
-    bool hasNull = chunkIndex.pixelstatistics(pixelId).statistic().hasnull();
+    bool hasNull = PixelIndex::hasNull(chunkIndex, pixelId);
     setValid(input, pixelStride, vector, pixelId, hasNull);
+    columnVector->isDictionary = false;
 
-    // TODO: if dictionary encoded
-    if (encoding.kind() == pixels::proto::ColumnEncoding_Kind_DICTIONARY) {
+    if (encoding.kind() == pixels::proto::ColumnEncoding_Kind_DICTIONARY && columnVector->encoding) {
+        // hand the dictionary ids to the column vector instead of resolving them into strings
+        readDictIds(encoding, size);
+        columnVector->setDictionary(getDictionary());
+        uint32_t nullId = startsLength - 1;
+        for(int i = 0; i < size; i++) {
+            columnVector->setDictId(i + vectorIndex, vector->checkValid(i) ? dictIds[i] : nullId);
+        }
+        elementIndex += size;
+    } else if (encoding.kind() == pixels::proto::ColumnEncoding_Kind_DICTIONARY) {
         bool cascadeRLE = false;
         if (encoding.has_cascadeencoding() && encoding.cascadeencoding().kind() == pixels::proto::ColumnEncoding_Kind_RUNLENGTH) {
             cascadeRLE = true;
@@ -104,9 +116,143 @@ void StringColumnReader::read(std::shared_ptr<ByteBuffer> input, pixels::proto::
     }
 }
 
+void StringColumnReader::skip(std::shared_ptr<ByteBuffer> input, pixels::proto::ColumnEncoding & encoding, int offset,
+                              int size, int pixelStride, int vectorIndex, std::shared_ptr<ColumnVector> vector,
+                              pixels::proto::ColumnChunkIndex & chunkIndex) {
+    if(offset == 0) {
+        elementIndex = 0;
+        bufferOffset = 0;
+        isNullOffset = chunkIndex.isnulloffset();
+        readContent(input, input->bytesRemaining(), encoding);
+    }
+
+    int pixelId = elementIndex / pixelStride;
+    bool hasNull = PixelIndex::hasNull(chunkIndex, pixelId);
+    skipValid(pixelStride, size, hasNull);
+    if(size <= 0) {
+        return;
+    }
+
+    if (encoding.kind() == pixels::proto::ColumnEncoding_Kind_DICTIONARY) {
+        // each element (including null) has one dictionary id in the content
+        if (encoding.has_cascadeencoding() && encoding.cascadeencoding().kind() == pixels::proto::ColumnEncoding_Kind_RUNLENGTH) {
+            contentDecoder->skip(size);
+        } else {
+            contentBuf->setReadPos(contentBuf->getReadPos() + size * sizeof(int));
+        }
+    } else {
+        // the content of the skipped elements is contiguous, so we only need the last start offset
+        startsBuf->setReadPos(startsBuf->getReadPos() + (size - 1) * sizeof(int));
+        currentStart = nextStart;
+        nextStart = startsBuf->getInt();
+        bufferOffset += nextStart - currentStart;
+    }
+    elementIndex += size;
+}
+
+bool StringColumnReader::readAndFilter(std::shared_ptr<ByteBuffer> input, pixels::proto::ColumnEncoding & encoding,
+                                       int offset, int size, int pixelStride, int vectorIndex,
+                                       std::shared_ptr<ColumnVector> vector,
+                                       pixels::proto::ColumnChunkIndex & chunkIndex,
+                                       std::shared_ptr<PixelsBitMask> filterMask, duckdb::TableFilter & filter) {
+    if (encoding.kind() != pixels::proto::ColumnEncoding_Kind_DICTIONARY) {
+        return false;
+    }
+    std::shared_ptr<BinaryColumnVector> columnVector =
+            std::static_pointer_cast<BinaryColumnVector>(vector);
+    if(offset == 0) {
+        elementIndex = 0;
+        bufferOffset = 0;
+        isNullOffset = chunkIndex.isnulloffset();
+        readContent(input, input->bytesRemaining(), encoding);
+        dictFilter = nullptr;
+    }
+
+    int pixelId = elementIndex / pixelStride;
+    bool hasNull = PixelIndex::hasNull(chunkIndex, pixelId);
+    setValid(input, pixelStride, vector, pixelId, hasNull);
+    columnVector->isDictionary = false;
+
+    // evaluate the filter once for each dictionary entry of the column chunk
+    if (dictFilter != &filter) {
+        int dictSize = startsLength - 1;
+        dictMatches.resize(dictSize);
+        // the entry is reused, so that it is only reallocated for a longer entry
+        std::string entry;
+        for (int id = 0; id < dictSize; id++) {
+            entry.assign((const char *) dictContentBuf->getPointer() + dictStarts[id],
+                         dictStarts[id + 1] - dictStarts[id]);
+            dictMatches[id] = PixelsFilter::CheckBounds<std::string>(filter, entry, entry, type) !=
+                              PixelsFilter::NONE_MATCH;
+        }
+        dictFilter = &filter;
+    }
+
+    readDictIds(encoding, size);
+    if (columnVector->encoding) {
+        columnVector->setDictionary(getDictionary());
+    }
+    uint32_t nullId = startsLength - 1;
+    bool nullMatches = PixelsFilter::MatchesNull(filter);
+    for (int i = 0; i < size; i++) {
+        bool valid = vector->checkValid(i);
+        int originId = dictIds[i];
+        if (columnVector->encoding) {
+            columnVector->setDictId(i + vectorIndex, valid ? originId : nullId);
+        }
+        if (!filterMask->get(i)) {
+            continue;
+        }
+        if (!valid) {
+            if (!nullMatches) {
+                filterMask->set(i, 0);
+            }
+            continue;
+        }
+        if (!dictMatches[originId]) {
+            filterMask->set(i, 0);
+        } else if (!columnVector->encoding) {
+            int tmpLen = dictStarts[originId + 1] - dictStarts[originId];
+            columnVector->setRef(i + vectorIndex, dictContentBuf->getPointer(), dictStarts[originId], tmpLen);
+        }
+    }
+    elementIndex += size;
+    return true;
+}
+
+void StringColumnReader::readDictIds(pixels::proto::ColumnEncoding & encoding, int size) {
+    // each element (including null) has one dictionary id in the content
+    dictIds.resize(size);
+    if (encoding.has_cascadeencoding() && encoding.cascadeencoding().kind() == pixels::proto::ColumnEncoding_Kind_RUNLENGTH) {
+        contentDecoder->decode(dictIds.data(), size);
+    } else {
+        std::memcpy(dictIds.data(), contentBuf->getPointer() + contentBuf->getReadPos(), size * sizeof(int));
+        contentBuf->setReadPos(contentBuf->getReadPos() + size * sizeof(int));
+    }
+}
+
+std::shared_ptr<BinaryDictionary> StringColumnReader::getDictionary() {
+    if (dictionary != nullptr) {
+        return dictionary;
+    }
+    int dictSize = startsLength - 1;
+    dictionary = std::make_shared<BinaryDictionary>();
+    // one more entry for null
+    dictionary->values.resize(dictSize + 1);
+    for (int id = 0; id < dictSize; id++) {
+        dictionary->values[id] = duckdb::string_t((char *) dictContentBuf->getPointer() + dictStarts[id],
+                                                  dictStarts[id + 1] - dictStarts[id]);
+    }
+    dictionary->values[dictSize] = duckdb::string_t((char *) dictContentBuf->getPointer(), 0);
+    dictionary->valid.assign((dictSize + 1 + 63) / 64, ~0UL);
+    dictionary->valid[dictSize / 64] &= ~(1UL << (dictSize % 64));
+    return dictionary;
+}
+
 void StringColumnReader::readContent(std::shared_ptr<ByteBuffer> input,
                                      uint32_t inputLength,
                                      pixels::proto::ColumnEncoding & encoding) {
+    dictionary = nullptr;
     if(encoding.kind() == pixels::proto::ColumnEncoding_Kind_DICTIONARY) {
         input->markReaderIndex();
         input->skipBytes(inputLength - 2 * sizeof(int));
@@ -146,6 +292,7 @@ void StringColumnReader::readContent(std::shared_ptr<ByteBuffer> input,
             {
                 throw new InvalidArgumentException("the dictionary size is inconsistent with the size of the starts array");
             }
+            startsLength = startsSize;
             dictStarts = new int[startsSize];
             for (int i = 0; i < startsSize; ++i)
             {
@@ -3,6 +3,7 @@
 //
 
 #include "reader/TimestampColumnReader.h"
+#include <algorithm>
 
 TimestampColumnReader::TimestampColumnReader(std::shared_ptr<TypeDescription> type) : ColumnReader(type) {
 
@@ -26,19 +27,55 @@ void TimestampColumnReader::read(std::shared_ptr<ByteBuffer> input, pixels::prot
     }
 
     int pixelId = elementIndex / pixelStride;
-    bool hasNull = chunkIndex.pixelstatistics(pixelId).statistic().hasnull();
+    bool hasNull = PixelIndex::hasNull(chunkIndex, pixelId);
     setValid(input, pixelStride, vector, pixelId, hasNull);
 
     if(encoding.kind() == pixels::proto::ColumnEncoding_Kind_RUNLENGTH) {
-        for (int i = 0; i < size; i++) {
-            if (elementIndex % pixelStride == 0) {
-                int pixelId = elementIndex / pixelStride;
+        int i = 0;
+        while (i < size) {
+            // the rows that are already filtered out are skipped without decoding
+            int setStart = filterMask == nullptr ? i : (int) filterMask->nextSetBit(i, size);
+            if (setStart > i) {
+                decoder->skip(setStart - i);
             }
-            columnVector->set(i + vectorIndex, decoder->next());
-            elementIndex++;
+            int setEnd = filterMask == nullptr ? size : (int) filterMask->nextClearBit(setStart, size);
+            if (setEnd > setStart) {
+                decoder->decode(columnVector->times + setStart + vectorIndex, setEnd - setStart);
+                columnVector->writeIndex = std::max<uint64_t>(columnVector->writeIndex, setEnd + vectorIndex);
+            }
+            i = setEnd;
+        }
+        elementIndex += size;
+    } else {
+        columnVector->times = (int64_t *)(input->getPointer() + input->getReadPos());
+        input->setReadPos(input->getReadPos() + size * sizeof(int64_t));
+        elementIndex += size;
+    }
+}
+
+void TimestampColumnReader::skip(std::shared_ptr<ByteBuffer> input, pixels::proto::ColumnEncoding &encoding, int offset,
+                                 int size, int pixelStride, int vectorIndex, std::shared_ptr<ColumnVector> vector,
+                                 pixels::proto::ColumnChunkIndex &chunkIndex) {
+    std::shared_ptr<TimestampColumnVector> columnVector =
+            std::static_pointer_cast<TimestampColumnVector>(vector);
+    if(offset == 0) {
+        decoder = std::make_shared<RunLenIntDecoder>(input, true);
+        ColumnReader::elementIndex = 0;
+        isNullOffset = chunkIndex.isnulloffset();
+    }
+
+    int pixelId = elementIndex / pixelStride;
+    bool hasNull = PixelIndex::hasNull(chunkIndex, pixelId);
+    skipValid(pixelStride, size, hasNull);
+
+    if(encoding.kind() == pixels::proto::ColumnEncoding_Kind_RUNLENGTH) {
+        if(!seekToNextPixel(input, pixelStride, size, chunkIndex)) {
+            decoder->skip(size);
         }
     } else {
+        // the values are referenced without copy, so the vector still points to the skipped values
         columnVector->times = (int64_t *)(input->getPointer() + input->getReadPos());
         input->setReadPos(input->getReadPos() + size * sizeof(int64_t));
     }
+    elementIndex += size;
 }
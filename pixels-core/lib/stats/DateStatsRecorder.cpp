@@ -0,0 +1,99 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "stats/DateStatsRecorder.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+
+DateStatsRecorder::DateStatsRecorder()
+        : minimum(std::numeric_limits<int>::max()), maximum(std::numeric_limits<int>::min()),
+          hasMinimum(false) {}
+
+
+DateStatsRecorder::DateStatsRecorder(const pixels::proto::ColumnStatistic& statistic)
+        : StatsRecorder(statistic), minimum(std::numeric_limits<int>::max()),
+          maximum(std::numeric_limits<int>::min()), hasMinimum(false) {
+    const pixels::proto::DateStatistic& stat = statistic.datestatistics();
+    if (stat.has_minimum() && stat.has_maximum()) {
+        minimum = stat.minimum();
+        maximum = stat.maximum();
+        hasMinimum = true;
+    }
+}
+
+
+void DateStatsRecorder::updateDate(int value) {
+    if (!hasMinimum) {
+        hasMinimum = true;
+        minimum = value;
+        maximum = value;
+    } else if (value < minimum) {
+        minimum = value;
+    } else if (value > maximum) {
+        maximum = value;
+    }
+    numberOfValues++;
+}
+
+
+void DateStatsRecorder::merge(const StatsRecorder& stats) {
+    const auto* other = dynamic_cast<const DateStatsRecorder*>(&stats);
+    if (other != nullptr) {
+        if (other->hasMinimum) {
+            if (!hasMinimum) {
+                hasMinimum = true;
+                minimum = other->minimum;
+                maximum = other->maximum;
+            } else {
+                minimum = std::min(minimum, other->minimum);
+                maximum = std::max(maximum, other->maximum);
+            }
+        }
+    } else if (stats.isStatsExists() && hasMinimum) {
+        throw std::invalid_argument("Incompatible merging of date column statistics");
+    }
+    StatsRecorder::merge(stats);
+}
+
+
+void DateStatsRecorder::reset() {
+    StatsRecorder::reset();
+    minimum = std::numeric_limits<int>::max();
+    maximum = std::numeric_limits<int>::min();
+    hasMinimum = false;
+}
+
+
+int DateStatsRecorder::getMinimum() const { return minimum; }
+
+int DateStatsRecorder::getMaximum() const { return maximum; }
+
+
+pixels::proto::ColumnStatistic DateStatsRecorder::serialize() const {
+    pixels::proto::ColumnStatistic statistic = StatsRecorder::serialize();
+    pixels::proto::DateStatistic* stat = statistic.mutable_datestatistics();
+    if (hasMinimum) {
+        stat->set_minimum(minimum);
+        stat->set_maximum(maximum);
+    }
+    return statistic;
+}
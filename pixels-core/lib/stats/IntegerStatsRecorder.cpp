@@ -0,0 +1,126 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "stats/IntegerStatsRecorder.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+
+IntegerStatsRecorder::IntegerStatsRecorder()
+        : minimum(std::numeric_limits<long>::max()), maximum(std::numeric_limits<long>::min()),
+          hasMinimum(false), sum(0), overflow(false) {}
+
+
+IntegerStatsRecorder::IntegerStatsRecorder(const pixels::proto::ColumnStatistic& statistic)
+        : StatsRecorder(statistic), minimum(std::numeric_limits<long>::max()),
+          maximum(std::numeric_limits<long>::min()), hasMinimum(false), sum(0), overflow(false) {
+    const pixels::proto::IntegerStatistic& intStat = statistic.intstatistics();
+    if (intStat.has_minimum()) {
+        minimum = intStat.minimum();
+        hasMinimum = true;
+    }
+    if (intStat.has_maximum()) {
+        maximum = intStat.maximum();
+    }
+    if (intStat.has_sum()) {
+        sum = intStat.sum();
+    } else {
+        overflow = true;
+    }
+}
+
+
+void IntegerStatsRecorder::updateInteger(long value, int repetitions) {
+    if (!hasMinimum) {
+        hasMinimum = true;
+        minimum = value;
+        maximum = value;
+    } else if (value < minimum) {
+        minimum = value;
+    } else if (value > maximum) {
+        maximum = value;
+    }
+    long increment;
+    if (__builtin_mul_overflow(value, (long) repetitions, &increment)) {
+        overflow = true;
+    } else {
+        addToSum(increment);
+    }
+    numberOfValues += repetitions;
+}
+
+
+void IntegerStatsRecorder::merge(const StatsRecorder& stats) {
+    const auto* intStats = dynamic_cast<const IntegerStatsRecorder*>(&stats);
+    if (intStats != nullptr) {
+        if (intStats->hasMinimum) {
+            if (!hasMinimum) {
+                hasMinimum = true;
+                minimum = intStats->minimum;
+                maximum = intStats->maximum;
+            } else {
+                minimum = std::min(minimum, intStats->minimum);
+                maximum = std::max(maximum, intStats->maximum);
+            }
+        }
+        overflow |= intStats->overflow;
+        addToSum(intStats->sum);
+    } else if (stats.isStatsExists() && hasMinimum) {
+        throw std::invalid_argument("Incompatible merging of integer column statistics");
+    }
+    StatsRecorder::merge(stats);
+}
+
+
+void IntegerStatsRecorder::reset() {
+    StatsRecorder::reset();
+    minimum = std::numeric_limits<long>::max();
+    maximum = std::numeric_limits<long>::min();
+    hasMinimum = false;
+    sum = 0;
+    overflow = false;
+}
+
+
+long IntegerStatsRecorder::getMinimum() const { return minimum; }
+
+long IntegerStatsRecorder::getMaximum() const { return maximum; }
+
+
+pixels::proto::ColumnStatistic IntegerStatsRecorder::serialize() const {
+    pixels::proto::ColumnStatistic statistic = StatsRecorder::serialize();
+    pixels::proto::IntegerStatistic* intStat = statistic.mutable_intstatistics();
+    if (hasMinimum) {
+        intStat->set_minimum(minimum);
+        intStat->set_maximum(maximum);
+    }
+    if (!overflow) {
+        intStat->set_sum(sum);
+    }
+    return statistic;
+}
+
+
+void IntegerStatsRecorder::addToSum(long value) {
+    if (!overflow && __builtin_add_overflow(sum, value, &sum)) {
+        overflow = true;
+    }
+}
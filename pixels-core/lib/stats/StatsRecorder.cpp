@@ -23,6 +23,10 @@
 //
 
 #include "stats/StatsRecorder.h"
+#include "stats/IntegerStatsRecorder.h"
+#include "stats/StringStatsRecorder.h"
+#include "stats/DateStatsRecorder.h"
+#include "stats/TimestampStatsRecorder.h"
 #include <stdexcept>
 
 
@@ -69,6 +73,10 @@ void StatsRecorder::updateString(const std::string&, int) {
     throw std::logic_error("Can't update string");
 }
 
+void StatsRecorder::updateString(const uint8_t*, int, int) {
+    throw std::logic_error("Can't update string");
+}
+
 void StatsRecorder::updateBinary(const std::string&, int) {
     throw std::logic_error("Can't update binary");
 }
@@ -122,28 +130,53 @@ pixels::proto::ColumnStatistic StatsRecorder::serialize() const {
 std::unique_ptr<StatsRecorder> StatsRecorder::create(TypeDescription type) {
     switch (type.getCategory()) {
 
-        case TypeDescription::BOOLEAN:
-            // return std::make_unique<BooleanStatsRecorder>();
-            break;
+        case TypeDescription::SHORT:
+        case TypeDescription::INT:
+        case TypeDescription::LONG:
+            return std::make_unique<IntegerStatsRecorder>();
+
+        case TypeDescription::STRING:
+        case TypeDescription::VARCHAR:
+        case TypeDescription::CHAR:
+            return std::make_unique<StringStatsRecorder>();
+
+        case TypeDescription::DATE:
+            return std::make_unique<DateStatsRecorder>();
+
+        case TypeDescription::TIMESTAMP:
+            return std::make_unique<TimestampStatsRecorder>();
 
         default:
+            // the columns without a writer only record the number of values and nulls
             return std::make_unique<StatsRecorder>();
     }
 }
 
 
 std::unique_ptr<StatsRecorder> StatsRecorder::create(TypeDescription type, const pixels::proto::ColumnStatistic& statistic) {
-    switch (type.getCategory()) {
-
-        default:
-            return std::make_unique<StatsRecorder>(statistic);
-    }
+    return create(type.getCategory(), statistic);
 }
 
 
 std::unique_ptr<StatsRecorder> StatsRecorder::create(TypeDescription::Category category, const pixels::proto::ColumnStatistic& statistic) {
     switch (category) {
 
+        case TypeDescription::SHORT:
+        case TypeDescription::INT:
+        case TypeDescription::LONG:
+            return std::make_unique<IntegerStatsRecorder>(statistic);
+
+        case TypeDescription::STRING:
+        case TypeDescription::VARCHAR:
+        case TypeDescription::CHAR:
+            return std::make_unique<StringStatsRecorder>(statistic);
+
+        case TypeDescription::DATE:
+            return std::make_unique<DateStatsRecorder>(statistic);
+
+        case TypeDescription::TIMESTAMP:
+            return std::make_unique<TimestampStatsRecorder>(statistic);
+
         default:
             return std::make_unique<StatsRecorder>(statistic);
     }
@@ -0,0 +1,126 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "stats/StringStatsRecorder.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+// byte-wise comparison, the same order as std::string and duckdb string_t
+int compareBytes(const uint8_t* bytes, int length, const std::string& value) {
+    int common = std::min(length, (int) value.size());
+    int res = std::memcmp(bytes, value.data(), common);
+    if (res != 0) {
+        return res;
+    }
+    return length - (int) value.size();
+}
+
+}
+
+
+StringStatsRecorder::StringStatsRecorder() : hasMinimum(false), sum(0) {}
+
+
+StringStatsRecorder::StringStatsRecorder(const pixels::proto::ColumnStatistic& statistic)
+        : StatsRecorder(statistic), hasMinimum(false), sum(0) {
+    const pixels::proto::StringStatistic& stringStat = statistic.stringstatistics();
+    if (stringStat.has_minimum() && stringStat.has_maximum()) {
+        minimum = stringStat.minimum();
+        maximum = stringStat.maximum();
+        hasMinimum = true;
+    }
+    if (stringStat.has_sum()) {
+        sum = stringStat.sum();
+    }
+}
+
+
+void StringStatsRecorder::updateString(const std::string& value, int repetitions) {
+    updateString(reinterpret_cast<const uint8_t*>(value.data()), (int) value.size(), repetitions);
+}
+
+
+void StringStatsRecorder::updateString(const uint8_t* bytes, int length, int repetitions) {
+    if (!hasMinimum) {
+        hasMinimum = true;
+        minimum.assign(reinterpret_cast<const char*>(bytes), length);
+        maximum = minimum;
+    } else if (compareBytes(bytes, length, minimum) < 0) {
+        minimum.assign(reinterpret_cast<const char*>(bytes), length);
+    } else if (compareBytes(bytes, length, maximum) > 0) {
+        maximum.assign(reinterpret_cast<const char*>(bytes), length);
+    }
+    sum += (long) length * repetitions;
+    numberOfValues += repetitions;
+}
+
+
+void StringStatsRecorder::merge(const StatsRecorder& stats) {
+    const auto* stringStats = dynamic_cast<const StringStatsRecorder*>(&stats);
+    if (stringStats != nullptr) {
+        if (stringStats->hasMinimum) {
+            if (!hasMinimum) {
+                hasMinimum = true;
+                minimum = stringStats->minimum;
+                maximum = stringStats->maximum;
+            } else {
+                if (stringStats->minimum < minimum) {
+                    minimum = stringStats->minimum;
+                }
+                if (stringStats->maximum > maximum) {
+                    maximum = stringStats->maximum;
+                }
+            }
+        }
+        sum += stringStats->sum;
+    } else if (stats.isStatsExists() && hasMinimum) {
+        throw std::invalid_argument("Incompatible merging of string column statistics");
+    }
+    StatsRecorder::merge(stats);
+}
+
+
+void StringStatsRecorder::reset() {
+    StatsRecorder::reset();
+    minimum.clear();
+    maximum.clear();
+    hasMinimum = false;
+    sum = 0;
+}
+
+
+const std::string& StringStatsRecorder::getMinimum() const { return minimum; }
+
+const std::string& StringStatsRecorder::getMaximum() const { return maximum; }
+
+
+pixels::proto::ColumnStatistic StringStatsRecorder::serialize() const {
+    pixels::proto::ColumnStatistic statistic = StatsRecorder::serialize();
+    pixels::proto::StringStatistic* stringStat = statistic.mutable_stringstatistics();
+    if (hasMinimum) {
+        stringStat->set_minimum(minimum);
+        stringStat->set_maximum(maximum);
+    }
+    stringStat->set_sum(sum);
+    return statistic;
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "stats/TimestampStatsRecorder.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+
+TimestampStatsRecorder::TimestampStatsRecorder()
+        : minimum(std::numeric_limits<long>::max()), maximum(std::numeric_limits<long>::min()),
+          hasMinimum(false) {}
+
+
+TimestampStatsRecorder::TimestampStatsRecorder(const pixels::proto::ColumnStatistic& statistic)
+        : StatsRecorder(statistic), minimum(std::numeric_limits<long>::max()),
+          maximum(std::numeric_limits<long>::min()), hasMinimum(false) {
+    const pixels::proto::TimestampStatistic& stat = statistic.timestampstatistics();
+    if (stat.has_minimum() && stat.has_maximum()) {
+        minimum = stat.minimum();
+        maximum = stat.maximum();
+        hasMinimum = true;
+    }
+}
+
+
+void TimestampStatsRecorder::updateTimestamp(long value) {
+    if (!hasMinimum) {
+        hasMinimum = true;
+        minimum = value;
+        maximum = value;
+    } else if (value < minimum) {
+        minimum = value;
+    } else if (value > maximum) {
+        maximum = value;
+    }
+    numberOfValues++;
+}
+
+
+void TimestampStatsRecorder::merge(const StatsRecorder& stats) {
+    const auto* other = dynamic_cast<const TimestampStatsRecorder*>(&stats);
+    if (other != nullptr) {
+        if (other->hasMinimum) {
+            if (!hasMinimum) {
+                hasMinimum = true;
+                minimum = other->minimum;
+                maximum = other->maximum;
+            } else {
+                minimum = std::min(minimum, other->minimum);
+                maximum = std::max(maximum, other->maximum);
+            }
+        }
+    } else if (stats.isStatsExists() && hasMinimum) {
+        throw std::invalid_argument("Incompatible merging of timestamp column statistics");
+    }
+    StatsRecorder::merge(stats);
+}
+
+
+void TimestampStatsRecorder::reset() {
+    StatsRecorder::reset();
+    minimum = std::numeric_limits<long>::max();
+    maximum = std::numeric_limits<long>::min();
+    hasMinimum = false;
+}
+
+
+long TimestampStatsRecorder::getMinimum() const { return minimum; }
+
+long TimestampStatsRecorder::getMaximum() const { return maximum; }
+
+
+pixels::proto::ColumnStatistic TimestampStatsRecorder::serialize() const {
+    pixels::proto::ColumnStatistic statistic = StatsRecorder::serialize();
+    pixels::proto::TimestampStatistic* stat = statistic.mutable_timestampstatistics();
+    if (hasMinimum) {
+        stat->set_minimum(minimum);
+        stat->set_maximum(maximum);
+    }
+    return statistic;
+}
@@ -3,6 +3,11 @@
 //
 
 #include "utils/EncodingUtils.h"
+#include <algorithm>
+#include <cstring>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
 
 int EncodingUtils::BUFFER_SIZE = 64;
 
@@ -162,6 +167,119 @@ void EncodingUtils::unrolledUnPack64(long *buffer, int offset, int len,
 	unrolledUnPackBytes(buffer, offset, len, input, 8);
 }
 
+// -----------------------------------------------------------
+// bit unpacking kernels for any bit width. Values are packed big-endian:
+// the first value starts at the most significant bit of the first byte.
+// Each kernel decodes values from index start and returns the index of
+// the first value it did not decode.
+
+static inline uint64_t loadLongBE(const uint8_t *in) {
+    uint64_t val;
+    std::memcpy(&val, in, sizeof(val));
+    return __builtin_bswap64(val);
+}
+
+static int unPackScalar(const uint8_t *in, uint32_t avail, long *out, int start, int len, int bitSize) {
+    uint64_t bitPos = (uint64_t) start * bitSize;
+    int i = start;
+    // the 64 bits from the start of the value plus at most 7 bits of the next byte
+    for (; i < len && (bitPos >> 3) + 9 <= avail; i++, bitPos += bitSize) {
+        const uint8_t *p = in + (bitPos >> 3);
+        int shift = bitPos & 7;
+        uint64_t val = loadLongBE(p) << shift;
+        if (shift != 0) {
+            val |= p[8] >> (8 - shift);
+        }
+        out[i] = (long) (val >> (64 - bitSize));
+    }
+    // the last values are read from a zero-padded copy to stay inside the buffer
+    for (; i < len; i++, bitPos += bitSize) {
+        uint8_t pad[9] = {0};
+        uint32_t byteOffset = bitPos >> 3;
+        std::memcpy(pad, in + byteOffset, std::min(avail - byteOffset, (uint32_t) sizeof(pad)));
+        int shift = bitPos & 7;
+        uint64_t val = loadLongBE(pad) << shift;
+        if (shift != 0) {
+            val |= pad[8] >> (8 - shift);
+        }
+        out[i] = (long) (val >> (64 - bitSize));
+    }
+    return i;
+}
+
+#if defined(__x86_64__)
+/**
+ * Bit widths up to 8: every 8 values fill exactly bitSize bytes, which are
+ * deposited into the 8 bytes of a word by pdep and then widened to 64 bits.
+ */
+__attribute__((target("avx2,bmi2")))
+static int unPackBmi2(const uint8_t *in, uint32_t avail, long *out, int start, int len, int bitSize) {
+    uint64_t mask = 0x0101010101010101ULL * ((1U << bitSize) - 1);
+    int i = start;
+    for (; i + 8 <= len && (uint64_t) (i / 8) * bitSize + 8 <= avail; i += 8) {
+        uint64_t packed = loadLongBE(in + (i / 8) * bitSize) >> (64 - 8 * bitSize);
+        // the first value is deposited into the highest byte, so reverse the bytes
+        uint64_t bytes = __builtin_bswap64(_pdep_u64(packed, mask));
+        _mm256_storeu_si256((__m256i *) (out + i), _mm256_cvtepu8_epi64(_mm_cvtsi32_si128((int) bytes)));
+        _mm256_storeu_si256((__m256i *) (out + i + 4),
+                            _mm256_cvtepu8_epi64(_mm_cvtsi32_si128((int) (bytes >> 32))));
+    }
+    return i;
+}
+
+/**
+ * Bit widths up to 56: each of the 4 lanes gathers the 8 bytes starting at
+ * the byte of its value, which always cover the whole value.
+ */
+__attribute__((target("avx2")))
+static int unPackAvx2(const uint8_t *in, uint32_t avail, long *out, int start, int len, int bitSize) {
+    const __m256i reverse = _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                             7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    const __m256i seven = _mm256_set1_epi64x(7);
+    const __m256i rightShift = _mm256_set1_epi64x(64 - bitSize);
+    const __m256i step = _mm256_set1_epi64x(4L * bitSize);
+    uint64_t bitPos = (uint64_t) start * bitSize;
+    __m256i bits = _mm256_add_epi64(_mm256_set1_epi64x(bitPos),
+                                    _mm256_setr_epi64x(0, bitSize, 2L * bitSize, 3L * bitSize));
+    int i = start;
+    for (; i + 4 <= len && ((uint64_t) (i + 3) * bitSize >> 3) + 8 <= avail; i += 4) {
+        __m256i val = _mm256_i64gather_epi64((const long long *) in, _mm256_srli_epi64(bits, 3), 1);
+        val = _mm256_shuffle_epi8(val, reverse);
+        val = _mm256_sllv_epi64(val, _mm256_and_si256(bits, seven));
+        val = _mm256_srlv_epi64(val, rightShift);
+        _mm256_storeu_si256((__m256i *) (out + i), val);
+        bits = _mm256_add_epi64(bits, step);
+    }
+    return i;
+}
+#endif
+
+typedef int (*UnPackKernel)(const uint8_t *in, uint32_t avail, long *out, int start, int len, int bitSize);
+
+static UnPackKernel selectUnPackKernel(int bitSize) {
+#if defined(__x86_64__)
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    static const bool hasBmi2 = __builtin_cpu_supports("bmi2");
+    if (bitSize <= 8 && hasAvx2 && hasBmi2) {
+        return unPackBmi2;
+    }
+    if (bitSize <= 56 && hasAvx2) {
+        return unPackAvx2;
+    }
+#endif
+    return unPackScalar;
+}
+
+void EncodingUtils::unPack(long *buffer, int offset, int len, int bitSize,
+                           const std::shared_ptr<ByteBuffer> &input) {
+    const uint8_t *in = input->getPointer() + input->getReadPos();
+    uint32_t avail = input->bytesRemaining();
+    long *out = buffer + offset;
+    int i = selectUnPackKernel(bitSize)(in, avail, out, 0, len, bitSize);
+    unPackScalar(in, avail, out, i, len, bitSize);
+    input->setReadPos(input->getReadPos() + (uint32_t) (((uint64_t) len * bitSize + 7) / 8));
+}
+
 void EncodingUtils::unrolledUnPackBytes(long *buffer, int offset, int len,
                                         const std::shared_ptr<ByteBuffer> &input,
                                         int numBytes) {
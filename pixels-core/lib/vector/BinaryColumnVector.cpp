@@ -8,6 +8,13 @@ BinaryColumnVector::BinaryColumnVector(uint64_t len, bool encoding): ColumnVecto
     posix_memalign(reinterpret_cast<void **>(&vector), 32,
                    len * sizeof(duckdb::string_t));
     memoryUsage += (long) sizeof(uint8_t) * len;
+    isDictionary = false;
+    dictionary = nullptr;
+    dictIds = nullptr;
+    if(encoding) {
+        posix_memalign(reinterpret_cast<void **>(&dictIds), 32, len * sizeof(uint32_t));
+        memoryUsage += (long) sizeof(uint32_t) * len;
+    }
 }
 
 void BinaryColumnVector::close() {
@@ -15,6 +22,11 @@ void BinaryColumnVector::close() {
 		ColumnVector::close();
 		free(vector);
 		vector = nullptr;
+		if(dictIds != nullptr) {
+			free(dictIds);
+			dictIds = nullptr;
+		}
+		dictionary = nullptr;
 
 	}
 }
@@ -30,6 +42,21 @@ void BinaryColumnVector::setRef(int elementNum, uint8_t * const &sourceBuf, int
 
 }
 
+void BinaryColumnVector::setDictionary(const std::shared_ptr<BinaryDictionary> &dictionary) {
+    if(dictIds == nullptr) {
+        throw InvalidArgumentException("BinaryColumnVector: dictionary is only supported by encoded vectors.");
+    }
+    this->dictionary = dictionary;
+    isDictionary = true;
+}
+
+void BinaryColumnVector::setDictId(int elementNum, uint32_t id) {
+    if(elementNum >= writeIndex) {
+        writeIndex = elementNum + 1;
+    }
+    dictIds[elementNum] = id;
+}
+
 void BinaryColumnVector::print(int rowCount) {
 	throw InvalidArgumentException("not support print binarycolumnvector.");
 }
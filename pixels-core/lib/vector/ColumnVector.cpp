@@ -20,6 +20,7 @@ void ColumnVector::close() {
 	if(!closed) {
         writeIndex = 0;
         closed = true;
+        cachedVector = nullptr;
         // TODO: reset other variables
         if (isValid != nullptr) {
             free(isValid);
@@ -31,6 +32,7 @@ void ColumnVector::close() {
 void ColumnVector::reset() {
     writeIndex = 0;
     readIndex = 0;
+    cachedVector = nullptr;
     // TODO: reset other variables
 }
 
@@ -27,6 +27,7 @@
 
 const int ColumnWriter::ISNULL_ALIGNMENT = std::stoi(ConfigFactory::Instance().getProperty("isnull.bitmap.alignment"));
 const std::vector<uint8_t> ColumnWriter::ISNULL_PADDING_BUFFER(ColumnWriter::ISNULL_ALIGNMENT, 0);
+const bool ColumnWriter::COLUMNAR_PIXEL_INDEX = ConfigFactory::Instance().boolCheckProperty("pixel.index.columnar");
 
 
 
@@ -54,6 +55,10 @@ pixels::proto::ColumnEncoding ColumnWriter::getColumnChunkEncoding() {
     return encoding;
 }
 
+const StatsRecorder & ColumnWriter::getColumnChunkStatRecorder() const {
+    return *columnChunkStatRecorder;
+}
+
 
 void ColumnWriter::flush() {
     if (curPixelEleIndex > 0) {
@@ -66,6 +71,9 @@ void ColumnWriter::flush() {
         isNullOffset += alignBytes;
     }
     columnChunkIndex->set_isnulloffset(isNullOffset);
+    if (columnarPixelIndex) {
+        columnChunkIndex->set_pixelindex(pixelIndexBuilder.build());
+    }
     outputStream->putBytes(isNullStream->getPointer() + isNullStream->getReadPos(), isNullStream->getWritePos() - isNullStream->getReadPos());
 }
 
@@ -73,23 +81,24 @@ void ColumnWriter::newPixel() {
     if (hasNull) {
         auto compacted = BitUtils::bitWiseCompact(isNull, curPixelIsNullIndex, byteOrder);
         isNullStream->putBytes(const_cast<uint8_t*>(compacted.data()), compacted.size());
-        pixelStatRecorder.setHasNull();
+        pixelStatRecorder->setHasNull();
     }
     curPixelPosition = static_cast<int>(outputStream->getWritePos());
     curPixelEleIndex = 0;
     curPixelVectorIndex = 0;
     curPixelIsNullIndex = 0;
 
-    columnChunkStatRecorder.merge(pixelStatRecorder);
+    columnChunkStatRecorder->merge(*pixelStatRecorder);
 
-    pixels::proto::PixelStatistic pixelStat;
-    *pixelStat.mutable_statistic() = pixelStatRecorder.serialize();
     columnChunkIndex->add_pixelpositions(lastPixelPosition);
-    auto new_pixelstatistic = columnChunkIndex->add_pixelstatistics();
-    *new_pixelstatistic = pixelStat;
+    if (columnarPixelIndex) {
+        pixelIndexBuilder.add(pixelStatRecorder->serialize());
+    } else {
+        *columnChunkIndex->add_pixelstatistics()->mutable_statistic() = pixelStatRecorder->serialize();
+    }
 
     lastPixelPosition = curPixelPosition;
-    pixelStatRecorder.reset();
+    pixelStatRecorder->reset();
     hasNull = false;
 }
 
@@ -98,8 +107,9 @@ void ColumnWriter::reset() {
     curPixelPosition = 0;
     columnChunkIndex->Clear();
     columnChunkStat->Clear();
-    pixelStatRecorder.reset();
-    columnChunkStatRecorder.reset();
+    pixelStatRecorder->reset();
+    columnChunkStatRecorder->reset();
+    pixelIndexBuilder.reset();
     outputStream->resetPosition();
     isNullStream->resetPosition();
 }
@@ -126,6 +136,9 @@ ColumnWriter::ColumnWriter(std::shared_ptr<TypeDescription> type,
     columnChunkIndex->set_littleendian(byteOrder == ByteOrder::PIXELS_LITTLE_ENDIAN);
     columnChunkIndex->set_nullspadding(nullsPadding);
     columnChunkIndex->set_isnullalignment(ISNULL_ALIGNMENT);
+    pixelStatRecorder = StatsRecorder::create(*type);
+    columnChunkStatRecorder = StatsRecorder::create(*type);
+    columnarPixelIndex = COLUMNAR_PIXEL_INDEX && PixelIndex::isSupported(type->getCategory());
 }
 
 
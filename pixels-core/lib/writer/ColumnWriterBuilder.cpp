@@ -24,6 +24,9 @@
 //#include "writer/ColumnWriterBuilder.h"
 #include "writer/ColumnWriterBuilder.h"
 #include "writer/IntegerColumnWriter.h"
+#include "writer/StringColumnWriter.h"
+#include "writer/DateColumnWriter.h"
+#include "writer/TimestampColumnWriter.h"
 
 std::shared_ptr<ColumnWriter> ColumnWriterBuilder::newColumnWriter(std::shared_ptr<TypeDescription> type, std::shared_ptr<PixelsWriterOption> writerOption) {
     switch(type->getCategory()) {
@@ -41,9 +44,15 @@ std::shared_ptr<ColumnWriter> ColumnWriterBuilder::newColumnWriter(std::shared_p
         case TypeDescription::DOUBLE:
             break;
         case TypeDescription::STRING:
-            break;
+        case TypeDescription::VARCHAR:
+        case TypeDescription::CHAR:
+            return std::make_shared<StringColumnWriter>(type, writerOption);
+        case TypeDescription::DATE:
+            return std::make_shared<DateColumnWriter>(type, writerOption);
         case TypeDescription::TIME:
             break;
+        case TypeDescription::TIMESTAMP:
+            return std::make_shared<TimestampColumnWriter>(type, writerOption);
         case TypeDescription::VARBINARY:
             break;
         case TypeDescription::BINARY:
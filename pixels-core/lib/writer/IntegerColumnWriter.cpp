@@ -85,15 +85,13 @@ void IntegerColumnWriter::writeCurPartLong(std::shared_ptr<ColumnVector> columnV
         if (columnVector->isNull[i + curPartOffset])
         {
             hasNull = true;
-            if (nullsPadding)
-            {
-                // padding 0 for nulls
-                curPixelVector[curPixelVectorIndex++] = 0L;
-            }
+            // the reader decodes one value for each element, including nulls, so nulls are padded by 0
+            curPixelVector[curPixelVectorIndex++] = 0L;
         }
         else
         {
             curPixelVector[curPixelVectorIndex++] = values[i + curPartOffset];
+            pixelStatRecorder->updateInteger(values[i + curPartOffset], 1);
         }
     }
     std::copy(columnVector->isNull + curPartOffset, columnVector->isNull + curPartOffset + curPartLength, isNull.begin() + curPixelIsNullIndex);
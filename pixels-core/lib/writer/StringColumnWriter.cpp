@@ -19,26 +19,243 @@
  */
 
 #include "writer/StringColumnWriter.h"
+#include "utils/ConfigFactory.h"
+
+const double StringColumnWriter::DICTIONARY_DISTINCT_RATIO_THRESHOLD =
+    std::stod(ConfigFactory::Instance().getProperty("string.dictionary.distinct.ratio.threshold"));
 
 StringColumnWriter::StringColumnWriter(std::shared_ptr<TypeDescription> type,std::shared_ptr<PixelsWriterOption> writerOption):
 ColumnWriter(type,writerOption),curPixelVector(pixelStride) {
  encodingUtils= std::make_shared<EncodingUtils>();
  runlengthEncoding = encodingLevel.ge(EncodingLevel::Level::EL2);
+ dictionaryEncoding = encodingLevel.ge(EncodingLevel::Level::EL1);
  if (runlengthEncoding)
  {
-  encoder = std::make_unique<RunLenIntEncoder>();
+  // dictionary ids and starts are non-negative, the reader decodes them as unsigned
+  encoder = std::make_unique<RunLenIntEncoder>(false, true);
+ }
+ if (dictionaryEncoding)
+ {
+  dictionary = std::make_unique<HashTableDictionary>();
  }
  startsArray=std::make_shared<DynamicIntArray>();
 }
 
+int StringColumnWriter::write(std::shared_ptr<ColumnVector> vector, int size) {
+ auto columnVector = std::static_pointer_cast<BinaryColumnVector>(vector);
+ if (!columnVector)
+ {
+  throw std::invalid_argument("Invalid vector type");
+ }
+
+ int curPartLength;         // size of the partition which belongs to current pixel
+ int curPartOffset = 0;     // starting offset of the partition which belongs to current pixel
+ int nextPartLength = size; // size of the partition which belongs to next pixel
+
+ // do the calculation to partition the vector into current pixel and next one
+ while ((curPixelIsNullIndex + nextPartLength) >= pixelStride)
+ {
+  curPartLength = pixelStride - curPixelIsNullIndex;
+  // dictionary encoding may be given up when the first pixel is done
+  if (dictionaryEncoding)
+  {
+   writeCurPartWithDict(columnVector, curPartLength, curPartOffset);
+  }
+  else
+  {
+   writeCurPartWithoutDict(columnVector, curPartLength, curPartOffset);
+  }
+  newPixel();
+  curPartOffset += curPartLength;
+  nextPartLength = size - curPartOffset;
+ }
+
+ curPartLength = nextPartLength;
+ if (dictionaryEncoding)
+ {
+  writeCurPartWithDict(columnVector, curPartLength, curPartOffset);
+ }
+ else
+ {
+  writeCurPartWithoutDict(columnVector, curPartLength, curPartOffset);
+ }
+
+ return outputStream->getWritePos();
+}
+
+void StringColumnWriter::writeCurPartWithDict(std::shared_ptr<BinaryColumnVector> columnVector, int curPartLength, int curPartOffset) {
+ for (int i = 0; i < curPartLength; i++)
+ {
+  curPixelEleIndex++;
+  if (columnVector->isNull[i + curPartOffset])
+  {
+   hasNull = true;
+   // the reader expects one dictionary id for each element, including nulls
+   curPixelVector[curPixelVectorIndex++] = 0L;
+  }
+  else
+  {
+   const duckdb::string_t & value = columnVector->vector[i + curPartOffset];
+   curPixelVector[curPixelVectorIndex++] =
+       dictionary->add(reinterpret_cast<const uint8_t *>(value.GetData()), (int) value.GetSize());
+   pixelStatRecorder->updateString(reinterpret_cast<const uint8_t *>(value.GetData()), (int) value.GetSize(), 1);
+   curPixelValueNum++;
+  }
+ }
+ std::copy(columnVector->isNull + curPartOffset, columnVector->isNull + curPartOffset + curPartLength, isNull.begin() + curPixelIsNullIndex);
+ curPixelIsNullIndex += curPartLength;
+}
+
+void StringColumnWriter::writeCurPartWithoutDict(std::shared_ptr<BinaryColumnVector> columnVector, int curPartLength, int curPartOffset) {
+ for (int i = 0; i < curPartLength; i++)
+ {
+  curPixelEleIndex++;
+  // nulls occupy an empty string in the starts array
+  startsArray->add(startOffset);
+  if (columnVector->isNull[i + curPartOffset])
+  {
+   hasNull = true;
+  }
+  else
+  {
+   const duckdb::string_t & value = columnVector->vector[i + curPartOffset];
+   outputStream->putBytes(reinterpret_cast<uint8_t *>(const_cast<char *>(value.GetData())), value.GetSize());
+   startOffset += (int) value.GetSize();
+   pixelStatRecorder->updateString(reinterpret_cast<const uint8_t *>(value.GetData()), (int) value.GetSize(), 1);
+  }
+ }
+ std::copy(columnVector->isNull + curPartOffset, columnVector->isNull + curPartOffset + curPartLength, isNull.begin() + curPixelIsNullIndex);
+ curPixelIsNullIndex += curPartLength;
+}
+
+void StringColumnWriter::newPixel() {
+ if (dictionaryEncoding && !doneDictionaryEncodingCheck)
+ {
+  checkDictionaryEncoding();
+ }
+ if (dictionaryEncoding)
+ {
+  writeInts(curPixelVector.data(), curPixelVectorIndex);
+ }
+ curPixelValueNum = 0;
+ ColumnWriter::newPixel();
+}
+
+void StringColumnWriter::checkDictionaryEncoding() {
+ doneDictionaryEncodingCheck = true;
+ if (curPixelValueNum > 0 && dictionary->size() <= DICTIONARY_DISTINCT_RATIO_THRESHOLD * curPixelValueNum)
+ {
+  return;
+ }
+ // too many distinct values or no value to learn from, write the buffered first pixel without dictionary
+ dictionaryEncoding = false;
+ for (int i = 0; i < curPixelVectorIndex; i++)
+ {
+  startsArray->add(startOffset);
+  if (!isNull[i])
+  {
+   int id = (int) curPixelVector[i];
+   int length = dictionary->getKeyLength(id);
+   outputStream->putBytes(const_cast<uint8_t *>(dictionary->getKey(id)), length);
+   startOffset += length;
+  }
+ }
+ dictionary.reset();
+}
+
+void StringColumnWriter::writeInts(long * values, int length) {
+ if (runlengthEncoding)
+ {
+  std::vector<byte> buffer((length + 1) * sizeof(long));
+  int resLen;
+  encoder->encode(values, buffer.data(), length, resLen);
+  outputStream->putBytes(buffer.data(), resLen);
+ }
+ else if (byteOrder == ByteOrder::PIXELS_LITTLE_ENDIAN)
+ {
+  for (int i = 0; i < length; i++)
+  {
+   encodingUtils->writeIntLE(outputStream, (int) values[i]);
+  }
+ }
+ else
+ {
+  for (int i = 0; i < length; i++)
+  {
+   encodingUtils->writeIntBE(outputStream, (int) values[i]);
+  }
+ }
+}
+
+void StringColumnWriter::close() {
+ if (runlengthEncoding && encoder)
+ {
+  encoder->clear();
+ }
+ if (dictionary)
+ {
+  dictionary->clear();
+ }
+ startsArray->clear();
+ ColumnWriter::close();
+}
+
+bool StringColumnWriter::decideNullsPadding(std::shared_ptr<PixelsWriterOption> writerOption) {
+ if (writerOption->getEncodingLevel().ge(EncodingLevel::Level::EL2))
+ {
+  return false;
+ }
+ return writerOption->isNullsPadding();
+}
+
+pixels::proto::ColumnEncoding StringColumnWriter::getColumnChunkEncoding() {
+ pixels::proto::ColumnEncoding columnEncoding;
+ if (dictionaryEncoding)
+ {
+  columnEncoding.set_kind(pixels::proto::ColumnEncoding::Kind::ColumnEncoding_Kind_DICTIONARY);
+  columnEncoding.set_dictionarysize(dictionary->size());
+  if (runlengthEncoding)
+  {
+   columnEncoding.mutable_cascadeencoding()->set_kind(pixels::proto::ColumnEncoding::Kind::ColumnEncoding_Kind_RUNLENGTH);
+  }
+ }
+ else
+ {
+  columnEncoding.set_kind(pixels::proto::ColumnEncoding::Kind::ColumnEncoding_Kind_NONE);
+ }
+ return columnEncoding;
+}
 
 void StringColumnWriter::flush(){
  ColumnWriter::flush();
- flushStarts();
+ if (dictionaryEncoding)
+ {
+  flushDictionary();
+ }
+ else
+ {
+  flushStarts();
+ }
+}
+
+void StringColumnWriter::flushDictionary() {
+ int dictContentOffset = outputStream->getWritePos();
+ const std::vector<uint8_t> & content = dictionary->getContent();
+ outputStream->putBytes(const_cast<uint8_t *>(content.data()), content.size());
+
+ int dictStartsOffset = outputStream->getWritePos();
+ const std::vector<int> & starts = dictionary->getStarts();
+ std::vector<long> startsVector(starts.begin(), starts.end());
+ writeInts(startsVector.data(), (int) startsVector.size());
+
+ std::shared_ptr<ByteBuffer> offsetBuffer=std::make_shared<ByteBuffer>(2 * sizeof(int));
+ offsetBuffer->putInt(dictContentOffset);
+ offsetBuffer->putInt(dictStartsOffset);
+ outputStream->putBytes(offsetBuffer->getPointer(),offsetBuffer->getWritePos());
 }
 
 void StringColumnWriter::flushStarts() {
- int startsFieldOffset=outputStream->size();
+ int startsFieldOffset=outputStream->getWritePos();
  startsArray->add(startOffset);
  if(byteOrder==ByteOrder::PIXELS_LITTLE_ENDIAN) {
   for (int i=0;i<startsArray->size();i++) {
@@ -0,0 +1,152 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PIXELS_TESTUTILS_H
+#define PIXELS_TESTUTILS_H
+
+#include "PixelsWriterImpl.h"
+#include "PixelsReaderBuilder.h"
+#include "physical/StorageFactory.h"
+#include "utils/ConfigFactory.h"
+#include <functional>
+#include <map>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+/**
+ * A file written by PixelsWriterImpl for a test under /tmp, it is removed when the object is destroyed.
+ */
+class TempPixelsFile {
+public:
+    // write the i-th row of the file into the row-th row of the batch
+    using RowWriter = std::function<void(VectorizedRowBatch &rowBatch, int row, int i)>;
+
+    /**
+     * @param name the prefix of the file name, the process id is appended to it
+     * @param schema the schema of the file, e.g., struct<a:bigint>
+     */
+    TempPixelsFile(const std::string &name, const std::string &schema, int pixelStride, int rowGroupSize,
+                   int rowNum, const RowWriter &writeRow, int compressionBlockSize = 1)
+            : path("/tmp/" + name + "_" + std::to_string(getpid()) + ".pxl") {
+        write(path, schema, pixelStride, rowGroupSize, rowNum, writeRow, compressionBlockSize);
+    }
+
+    ~TempPixelsFile() {
+        unlink(path.c_str());
+    }
+
+    TempPixelsFile(const TempPixelsFile &) = delete;
+    TempPixelsFile &operator=(const TempPixelsFile &) = delete;
+
+    /**
+     * Write the rows into the file at the path, replacing the file if it exists.
+     */
+    static void write(const std::string &path, const std::string &schema, int pixelStride, int rowGroupSize,
+                      int rowNum, const RowWriter &writeRow, int compressionBlockSize = 1) {
+        unlink(path.c_str());
+        auto fileSchema = TypeDescription::fromString(schema);
+        // the vectors own their values, since those of the date and timestamp vectors are not allocated otherwise
+        auto rowBatch = fileSchema->createRowBatch(pixelStride, std::vector<bool>(fileSchema->getChildren().size(), true));
+        PixelsWriterImpl writer(fileSchema, pixelStride, rowGroupSize, path, 1024, true,
+                                EncodingLevel(EncodingLevel::EL2), true, false, compressionBlockSize);
+        for (int i = 0; i < rowNum; i++) {
+            writeRow(*rowBatch, rowBatch->rowCount++, i);
+            if (rowBatch->rowCount == rowBatch->getMaxSize()) {
+                writer.addRowBatch(rowBatch);
+                rowBatch->reset();
+            }
+        }
+        if (rowBatch->rowCount != 0) {
+            writer.addRowBatch(rowBatch);
+        }
+        writer.close();
+    }
+
+    const std::string &getPath() const {
+        return path;
+    }
+
+    /**
+     * Open the file with a footer cache of its own, so that the file tails of the other tests are not hit.
+     */
+    std::shared_ptr<PixelsReader> openReader() const {
+        auto storage = StorageFactory::getInstance()->getStorage(::Storage::file);
+        return std::make_shared<PixelsReaderBuilder>()
+                ->setPath(path)
+                ->setStorage(storage)
+                ->setPixelsFooterCache(std::make_shared<PixelsFooterCache>())
+                ->build();
+    }
+
+    /**
+     * @return the options pixels_scan reads the row groups [rgStart, rgStart + rgLen) with
+     */
+    static PixelsReaderOption scanOption(const std::vector<std::string> &includeCols, int batchSize,
+                                         int rgStart, int rgLen) {
+        PixelsReaderOption option;
+        option.setSkipCorruptRecords(false);
+        option.setTolerantSchemaEvolution(true);
+        option.setEnableEncodedColumnVector(true);
+        option.setIncludeCols(includeCols);
+        option.setBatchSize(batchSize);
+        option.setRGRange(rgStart, rgLen);
+        return option;
+    }
+
+private:
+    std::string path;
+};
+
+/**
+ * Override the properties of ConfigFactory in a test, the original values are restored when the
+ * object is destroyed.
+ */
+class ScopedProperties {
+public:
+    ScopedProperties() = default;
+
+    ScopedProperties(std::initializer_list<std::pair<const char *, std::string>> properties) {
+        for (const auto &property : properties) {
+            set(property.first, property.second);
+        }
+    }
+
+    ~ScopedProperties() {
+        for (const auto &original : originals) {
+            ConfigFactory::Instance().addProperty(original.first, original.second);
+        }
+    }
+
+    ScopedProperties(const ScopedProperties &) = delete;
+    ScopedProperties &operator=(const ScopedProperties &) = delete;
+
+    void set(const std::string &key, const std::string &value) {
+        if (originals.find(key) == originals.end()) {
+            originals[key] = ConfigFactory::Instance().getProperty(key);
+        }
+        ConfigFactory::Instance().addProperty(key, value);
+    }
+
+private:
+    std::map<std::string, std::string> originals;
+};
+
+#endif //PIXELS_TESTUTILS_H
@@ -0,0 +1,246 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Round trips of RunLenIntEncoder and RunLenIntDecoder.
+ */
+#include "encoding/RunLenIntEncoder.h"
+#include "encoding/RunLenIntDecoder.h"
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+static std::vector<uint8_t> encode(std::vector<long> values, bool isSigned) {
+    RunLenIntEncoder encoder(isSigned, true);
+    // a run takes at most a few header bytes more than its values at 64 bits
+    std::vector<uint8_t> encoded(values.size() * sizeof(long) * 2 + 64);
+    int length;
+    encoder.encode(values.data(), encoded.data(), (int) values.size(), length);
+    encoded.resize(length);
+    return encoded;
+}
+
+static std::shared_ptr<ByteBuffer> wrap(const std::vector<uint8_t> &encoded) {
+    auto *data = (uint8_t *) malloc(encoded.size());
+    std::memcpy(data, encoded.data(), encoded.size());
+    return std::make_shared<ByteBuffer>(data, encoded.size(), false);
+}
+
+static std::vector<long> decodeByNext(const std::vector<uint8_t> &encoded, bool isSigned, int n) {
+    RunLenIntDecoder decoder(wrap(encoded), isSigned);
+    std::vector<long> values(n);
+    for (int i = 0; i < n; i++) {
+        values[i] = decoder.next();
+    }
+    EXPECT_FALSE(decoder.hasNext());
+    return values;
+}
+
+static std::vector<long> decodeByBatch(const std::vector<uint8_t> &encoded, bool isSigned, int n) {
+    RunLenIntDecoder decoder(wrap(encoded), isSigned);
+    std::vector<int64_t> values(n);
+    decoder.decode(values.data(), n);
+    return std::vector<long>(values.begin(), values.end());
+}
+
+// @return the encoding of the first run
+static EncodingType firstRunEncoding(const std::vector<uint8_t> &encoded) {
+    return (EncodingType) ((encoded.at(0) >> 6) & 0x03);
+}
+
+/**
+ * Values of a narrow range with a few wide outliers, which PATCHED_BASE stores as patches.
+ * @param outliers the indexes of the outliers
+ */
+static std::vector<long> withOutliers(int n, long base, long range, const std::vector<int> &outliers,
+                                      long outlier, unsigned seed) {
+    std::mt19937_64 random(seed);
+    std::vector<long> values(n);
+    for (int i = 0; i < n; i++) {
+        values[i] = base + (long) (random() % range);
+    }
+    for (int i : outliers) {
+        values[i] = outlier + (long) (random() % range);
+    }
+    return values;
+}
+
+// runs of every encoding: SHORT_REPEAT, DELTA, DIRECT, PATCHED_BASE and a long repeat
+static std::vector<long> mixedRuns() {
+    std::vector<long> values(8, 42);
+    for (long i = 0; i < 300; i++) {
+        values.push_back(i * 3 - 100);
+    }
+    std::mt19937_64 random(7);
+    for (int i = 0; i < 200; i++) {
+        values.push_back((long) (random() % 1000) - 500);
+    }
+    auto patched = withOutliers(512, 1000, 100, {7, 300, 500}, 1L << 40, 8);
+    values.insert(values.end(), patched.begin(), patched.end());
+    values.insert(values.end(), 700, -7);
+    return values;
+}
+
+static void expectRoundTrip(const std::vector<long> &values, bool isSigned, EncodingType firstRun) {
+    auto encoded = encode(values, isSigned);
+    EXPECT_EQ(firstRunEncoding(encoded), firstRun);
+    EXPECT_EQ(decodeByNext(encoded, isSigned, (int) values.size()), values);
+    EXPECT_EQ(decodeByBatch(encoded, isSigned, (int) values.size()), values);
+}
+
+TEST(RunLenIntTest, PatchedBase) {
+    for (bool isSigned : {true, false}) {
+        std::vector<int> outliers;
+        for (int i = 7; i < 512; i += 30) {
+            outliers.push_back(i);
+        }
+        // 3% of the values take 40 bits, the others 10 bits
+        expectRoundTrip(withOutliers(512, 1000, 100, outliers, 1L << 40, 1), isSigned,
+                        EncodingType::PATCHED_BASE);
+    }
+}
+
+TEST(RunLenIntTest, PatchedBaseNegativeBase) {
+    // the base is negative, and the outliers are positive
+    expectRoundTrip(withOutliers(512, -5000, 100, {0, 100, 200, 300, 400, 511}, 1L << 50, 2), true,
+                    EncodingType::PATCHED_BASE);
+}
+
+TEST(RunLenIntTest, PatchedBaseOutliersAtEnds) {
+    // the first and the last values are patched
+    expectRoundTrip(withOutliers(300, 0, 60, {0, 299}, 1L << 33, 3), false, EncodingType::PATCHED_BASE);
+}
+
+TEST(RunLenIntTest, PatchedBaseLongGaps) {
+    // the gap between the patches does not fit into the 8 bits of a patch, so extra patches are inserted
+    expectRoundTrip(withOutliers(512, 10, 30, {1, 400, 510}, 1L << 45, 4), false, EncodingType::PATCHED_BASE);
+}
+
+TEST(RunLenIntTest, PatchedBaseManyRuns) {
+    // several runs of at most 512 values, with an outlier every 37 values
+    std::vector<int> outliers;
+    for (int i = 0; i < 2000; i += 37) {
+        outliers.push_back(i);
+    }
+    for (bool isSigned : {true, false}) {
+        auto values = withOutliers(2000, 100, 200, outliers, 1L << 36, 5);
+        auto encoded = encode(values, isSigned);
+        EXPECT_EQ(decodeByNext(encoded, isSigned, (int) values.size()), values);
+        EXPECT_EQ(decodeByBatch(encoded, isSigned, (int) values.size()), values);
+    }
+}
+
+TEST(RunLenIntTest, TooManyOutliersToPatch) {
+    // a quarter of the values are wide, patching them is larger than the direct run
+    std::vector<int> outliers;
+    for (int i = 0; i < 512; i += 4) {
+        outliers.push_back(i);
+    }
+    expectRoundTrip(withOutliers(512, 0, 50, outliers, 1L << 40, 6), false, EncodingType::DIRECT);
+}
+
+TEST(RunLenIntTest, Skip) {
+    auto values = mixedRuns();
+    auto encoded = encode(values, true);
+    int n = (int) values.size();
+    // the number of values to skip and to read in turn, the skips cover partial, whole and several runs
+    std::vector<std::pair<int, int>> patterns = {{1, 1}, {3, 5}, {7, 100}, {100, 7}, {513, 1}, {1000, 3}};
+    for (auto pattern : patterns) {
+        RunLenIntDecoder decoder(wrap(encoded), true);
+        int position = 0;
+        while (position < n) {
+            int skipped = std::min(pattern.first, n - position);
+            decoder.skip(skipped);
+            position += skipped;
+            for (int i = 0; i < pattern.second && position < n; i++, position++) {
+                ASSERT_EQ(decoder.next(), values[position])
+                        << "skip " << pattern.first << " read " << pattern.second << " at " << position;
+            }
+        }
+        EXPECT_FALSE(decoder.hasNext());
+    }
+}
+
+TEST(RunLenIntTest, SkipThenDecode) {
+    auto values = mixedRuns();
+    auto encoded = encode(values, true);
+    int n = (int) values.size();
+    for (int skipped : {0, 5, 8, 9, 308, 500, 600, 1020, 1100}) {
+        RunLenIntDecoder decoder(wrap(encoded), true);
+        decoder.skip(skipped);
+        std::vector<int64_t> decoded(n - skipped);
+        decoder.decode(decoded.data(), n - skipped);
+        EXPECT_EQ(std::vector<long>(decoded.begin(), decoded.end()),
+                  std::vector<long>(values.begin() + skipped, values.end())) << "skip " << skipped;
+    }
+}
+
+TEST(RunLenIntTest, BatchDecodeMatchesNext) {
+    auto values = mixedRuns();
+    auto encoded = encode(values, true);
+    int n = (int) values.size();
+    auto expected = decodeByNext(encoded, true, n);
+    ASSERT_EQ(expected, values);
+    // the batches end inside the runs and at their boundaries
+    for (int batchSize : {1, 7, 8, 100, 512, n}) {
+        RunLenIntDecoder longDecoder(wrap(encoded), true);
+        RunLenIntDecoder intDecoder(wrap(encoded), true);
+        std::vector<int64_t> longs(batchSize);
+        std::vector<int32_t> ints(batchSize);
+        for (int position = 0; position < n; position += batchSize) {
+            int size = std::min(batchSize, n - position);
+            longDecoder.decode(longs.data(), size);
+            intDecoder.decode(ints.data(), size);
+            for (int i = 0; i < size; i++) {
+                ASSERT_EQ(longs[i], expected[position + i]) << "batch " << batchSize << " at " << position + i;
+                ASSERT_EQ(ints[i], (int32_t) expected[position + i]) << "batch " << batchSize << " at " << position + i;
+            }
+        }
+        EXPECT_FALSE(longDecoder.hasNext());
+        EXPECT_FALSE(intDecoder.hasNext());
+    }
+}
+
+TEST(RunLenIntTest, ReadRun) {
+    auto values = mixedRuns();
+    auto encoded = encode(values, true);
+    int n = (int) values.size();
+    RunLenIntDecoder decoder(wrap(encoded), true);
+    std::vector<int64_t> run(n);
+    int position = 0;
+    while (position < n) {
+        bool monotonic;
+        int size = decoder.readRun(run.data(), n - position, monotonic);
+        ASSERT_GT(size, 0);
+        for (int i = 0; i < size; i++) {
+            ASSERT_EQ(run[i], values[position + i]) << "at " << position + i;
+            // a monotonic run is bounded by its first and its last value
+            if (monotonic) {
+                ASSERT_GE(run[i], std::min(run[0], run[size - 1]));
+                ASSERT_LE(run[i], std::max(run[0], run[size - 1]));
+            }
+        }
+        position += size;
+    }
+    EXPECT_FALSE(decoder.hasNext());
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Micro-benchmark of EncodingUtils::unPack against the unrolled unpacking code.
+ */
+#include "utils/EncodingUtils.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <vector>
+
+static const int NUM_VALUES = 10000;
+static const int NUM_ROUNDS = 200;
+
+/**
+ * Bit-pack the values big-endian, the same layout as RunLenIntEncoder::writeInts.
+ */
+static std::vector<uint8_t> packValues(const std::vector<long> &values, int bitSize) {
+    std::vector<uint8_t> packed(((uint64_t) values.size() * bitSize + 7) / 8, 0);
+    uint64_t bitPos = 0;
+    for (long value : values) {
+        for (int b = bitSize - 1; b >= 0; b--, bitPos++) {
+            if (((uint64_t) value >> b) & 1) {
+                packed[bitPos >> 3] |= 0x80 >> (bitPos & 7);
+            }
+        }
+    }
+    return packed;
+}
+
+static std::shared_ptr<ByteBuffer> wrap(const std::vector<uint8_t> &packed) {
+    auto *data = (uint8_t *) malloc(packed.size());
+    std::memcpy(data, packed.data(), packed.size());
+    return std::make_shared<ByteBuffer>(data, packed.size(), false);
+}
+
+typedef void (EncodingUtils::*UnrolledUnPack)(long *, int, int, const std::shared_ptr<ByteBuffer> &);
+
+static UnrolledUnPack getUnrolledUnPack(int bitSize) {
+    switch (bitSize) {
+        case 1: return &EncodingUtils::unrolledUnPack1;
+        case 2: return &EncodingUtils::unrolledUnPack2;
+        case 4: return &EncodingUtils::unrolledUnPack4;
+        case 8: return &EncodingUtils::unrolledUnPack8;
+        case 16: return &EncodingUtils::unrolledUnPack16;
+        case 24: return &EncodingUtils::unrolledUnPack24;
+        case 32: return &EncodingUtils::unrolledUnPack32;
+        case 40: return &EncodingUtils::unrolledUnPack40;
+        case 48: return &EncodingUtils::unrolledUnPack48;
+        case 56: return &EncodingUtils::unrolledUnPack56;
+        case 64: return &EncodingUtils::unrolledUnPack64;
+        default: return nullptr;
+    }
+}
+
+template <class F>
+static double valuesPerSecond(F unpack) {
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < NUM_ROUNDS; round++) {
+        unpack();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return (double) NUM_VALUES * NUM_ROUNDS / elapsed.count();
+}
+
+TEST(UnpackBenchmark, UnpackAllBitWidths) {
+    EncodingUtils encodingUtils;
+    std::mt19937_64 random(0);
+    std::vector<long> unpacked(NUM_VALUES);
+    for (int bitSize = 1; bitSize <= 64; bitSize++) {
+        uint64_t mask = bitSize == 64 ? ~0ULL : (1ULL << bitSize) - 1;
+        std::vector<long> values(NUM_VALUES);
+        for (long &value : values) {
+            value = (long) (random() & mask);
+        }
+        auto input = wrap(packValues(values, bitSize));
+
+        double simd = valuesPerSecond([&]() {
+            input->setReadPos(0);
+            encodingUtils.unPack(unpacked.data(), 0, NUM_VALUES, bitSize, input);
+        });
+        ASSERT_EQ(values, unpacked) << "bit width " << bitSize;
+
+        UnrolledUnPack unrolled = getUnrolledUnPack(bitSize);
+        if (unrolled == nullptr) {
+            printf("bit width %2d: unPack %8.1f M values/s\n", bitSize, simd / 1e6);
+            continue;
+        }
+        double scalar = valuesPerSecond([&]() {
+            input->setReadPos(0);
+            (encodingUtils.*unrolled)(unpacked.data(), 0, NUM_VALUES, input);
+        });
+        ASSERT_EQ(values, unpacked) << "bit width " << bitSize;
+        printf("bit width %2d: unPack %8.1f M values/s, unrolled %8.1f M values/s\n",
+               bitSize, simd / 1e6, scalar / 1e6);
+    }
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#include "physical/compression/BlockCompressor.h"
+#include "exception/InvalidArgumentException.h"
+#include "gtest/gtest.h"
+#include <cstring>
+#include <random>
+
+namespace {
+
+// compressible runs of repeated bytes followed by random bytes that are stored as is
+std::vector<uint8_t> makeChunk(uint64_t length) {
+    std::mt19937 random(42);
+    std::vector<uint8_t> chunk(length);
+    for (uint64_t i = 0; i < length; i++) {
+        chunk[i] = i < length / 2 ? (uint8_t) (i / 100) : (uint8_t) random();
+    }
+    return chunk;
+}
+
+std::vector<uint8_t> decompress(pixels::proto::CompressionKind kind, const std::vector<uint8_t> &compressed) {
+    uint64_t length = BlockCompressor::getDecompressedLength(compressed.data(), compressed.size());
+    std::vector<uint8_t> output(length);
+    BlockCompressor::decompress(kind, compressed.data(), compressed.size(), output.data(), output.size());
+    return output;
+}
+
+const pixels::proto::CompressionKind kinds[] = {
+        pixels::proto::CompressionKind::LZ4, pixels::proto::CompressionKind::ZSTD};
+
+}
+
+TEST(BlockCompressorTest, RoundTrip) {
+    for (auto kind : kinds) {
+        for (uint64_t length : {0UL, 1UL, 4095UL, 4096UL, 100000UL}) {
+            auto chunk = makeChunk(length);
+            auto compressed = BlockCompressor::compress(kind, chunk.data(), chunk.size(), 4096);
+            EXPECT_EQ(decompress(kind, compressed), chunk)
+                    << pixels::proto::CompressionKind_Name(kind) << " " << length;
+        }
+    }
+}
+
+TEST(BlockCompressorTest, StoredBlocks) {
+    // the random half is not compressible, so some of its blocks are stored as is
+    auto chunk = makeChunk(100000);
+    auto compressed = BlockCompressor::compress(pixels::proto::CompressionKind::LZ4, chunk.data(), chunk.size(), 4096);
+    EXPECT_LT(compressed.size(), chunk.size());
+    uint32_t storedLength, originalLength;
+    uint64_t offset = 0;
+    int storedBlocks = 0;
+    while (offset < compressed.size()) {
+        std::memcpy(&storedLength, compressed.data() + offset, sizeof(uint32_t));
+        std::memcpy(&originalLength, compressed.data() + offset + sizeof(uint32_t), sizeof(uint32_t));
+        storedBlocks += storedLength == originalLength;
+        offset += BlockCompressor::BLOCK_HEADER_SIZE + storedLength;
+    }
+    EXPECT_GT(storedBlocks, 0);
+}
+
+TEST(BlockCompressorTest, CorruptInput) {
+    for (auto kind : kinds) {
+        auto chunk = makeChunk(10000);
+        auto compressed = BlockCompressor::compress(kind, chunk.data(), chunk.size(), 4096);
+        std::vector<uint8_t> output(chunk.size());
+
+        // a truncated block header
+        EXPECT_THROW(BlockCompressor::getDecompressedLength(compressed.data(), 4), InvalidArgumentException);
+        EXPECT_THROW(BlockCompressor::decompress(kind, compressed.data(), 4, output.data(), output.size()),
+                     InvalidArgumentException);
+        // a truncated block
+        EXPECT_THROW(BlockCompressor::decompress(kind, compressed.data(), compressed.size() - 1,
+                                                 output.data(), output.size()), InvalidArgumentException);
+        // an output buffer that is too small or too large
+        EXPECT_THROW(BlockCompressor::decompress(kind, compressed.data(), compressed.size(),
+                                                 output.data(), output.size() - 1), InvalidArgumentException);
+        std::vector<uint8_t> larger(chunk.size() + 1);
+        EXPECT_THROW(BlockCompressor::decompress(kind, compressed.data(), compressed.size(),
+                                                 larger.data(), larger.size()), InvalidArgumentException);
+        // a compressed block with its payload overwritten
+        auto corrupted = compressed;
+        uint32_t storedLength;
+        std::memcpy(&storedLength, corrupted.data(), sizeof(uint32_t));
+        ASSERT_LT(storedLength, 4096);
+        std::memset(corrupted.data() + BlockCompressor::BLOCK_HEADER_SIZE, 0xFF, storedLength);
+        EXPECT_THROW(BlockCompressor::decompress(kind, corrupted.data(), corrupted.size(),
+                                                 output.data(), output.size()), InvalidArgumentException);
+    }
+}
+
+TEST(BlockCompressorTest, ParseKind) {
+    EXPECT_EQ(BlockCompressor::parseKind("zstd"), pixels::proto::CompressionKind::ZSTD);
+    EXPECT_EQ(BlockCompressor::parseKind("LZ4"), pixels::proto::CompressionKind::LZ4);
+    EXPECT_EQ(BlockCompressor::parseKind("none"), pixels::proto::CompressionKind::NONE);
+    EXPECT_THROW(BlockCompressor::parseKind("snappy"), InvalidArgumentException);
+    EXPECT_THROW(BlockCompressor::parseKind("gzip2"), InvalidArgumentException);
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#include "PixelsTestUtils.h"
+#include "physical/BufferPool.h"
+#include "gtest/gtest.h"
+#include <future>
+#include <thread>
+
+namespace {
+
+const uint64_t columnBytes = 1024 * 1024;
+
+// scan a column in this thread, which leaves its two buffers idle
+void scan() {
+    BufferPool::Initialize({0}, {columnBytes}, {"a"});
+    BufferPool::Release();
+}
+
+}
+
+class BufferPoolTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // the idle buffers of one scan fit, those of two scans do not
+        properties.set("buffer.pool.idle.bytes", std::to_string(3 * columnBytes));
+    }
+
+    ScopedProperties properties;
+};
+
+TEST_F(BufferPoolTest, IdleBytesOfAllThreads) {
+    uint64_t before = BufferPool::GetIdleBytes();
+    std::promise<void> firstScanned;
+    std::promise<void> secondScanned;
+    std::thread first([&]() {
+        scan();
+        firstScanned.set_value();
+        // keep the idle buffers of this thread while the other thread scans
+        secondScanned.get_future().wait();
+    });
+    firstScanned.get_future().wait();
+    uint64_t firstIdleBytes = BufferPool::GetIdleBytes() - before;
+    EXPECT_GE(firstIdleBytes, 2 * columnBytes);
+    EXPECT_LE(firstIdleBytes, 3 * columnBytes);
+
+    std::thread second([&]() {
+        scan();
+    });
+    second.join();
+    // the second thread frees its own buffers, since the first one has taken most of the budget
+    EXPECT_LE(BufferPool::GetIdleBytes() - before, 3 * columnBytes);
+    EXPECT_GE(BufferPool::GetIdleBytes() - before, firstIdleBytes);
+    secondScanned.set_value();
+    first.join();
+    // the idle buffers of a thread are freed when it exits
+    EXPECT_EQ(BufferPool::GetIdleBytes(), before);
+}
+
+TEST_F(BufferPoolTest, TrimBeforeScan) {
+    uint64_t before = BufferPool::GetIdleBytes();
+    std::thread([&]() {
+        scan();
+        EXPECT_GT(BufferPool::GetIdleBytes(), before);
+        // a lower budget is applied by the trim at the start of the next scan
+        properties.set("buffer.pool.idle.bytes", "0");
+        EXPECT_TRUE(BufferPool::Trim());
+        EXPECT_EQ(BufferPool::GetIdleBytes(), before);
+        EXPECT_FALSE(BufferPool::Trim());
+    }).join();
+}
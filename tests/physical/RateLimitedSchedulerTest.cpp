@@ -0,0 +1,149 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#include "PixelsTestUtils.h"
+#include "physical/scheduler/RateLimitedScheduler.h"
+#include "physical/PhysicalReaderUtil.h"
+#include "physical/StorageFactory.h"
+#include "exception/InvalidArgumentException.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <thread>
+#include <unistd.h>
+
+/**
+ * Read a file through the rate limited scheduler. The scheduler is created once per process, so it
+ * is configured before its first use, and all the tests share the token bucket of the device of /tmp.
+ */
+class RateLimitedSchedulerTest : public ::testing::Test {
+protected:
+    static void SetUpTestSuite() {
+        properties.reset(new ScopedProperties{
+                {"read.request.ratelimit.mbps", "8"},
+                {"read.request.ratelimit.iops", "0"},
+                // no burst, so that every batch is paid for at the rate
+                {"read.request.ratelimit.burst.ms", "0"},
+                {"storage.directory.depth", "1"},
+                // the requests are read synchronously, without the buffers of the buffer pool
+                {"localfs.enable.async.io", "false"}});
+        scheduler = RateLimitedScheduler::Instance();
+
+        path = "/tmp/pixels_rate_limited_" + std::to_string(getpid()) + ".bin";
+        std::ofstream file(path, std::ios::binary);
+        for (uint64_t i = 0; i < fileSize; i++) {
+            file.put((char) (i % 251));
+        }
+    }
+
+    static void TearDownTestSuite() {
+        properties.reset();
+        unlink(path.c_str());
+    }
+
+    // read the file by batches of a request, and check the content
+    static void readBatches(int batchNum, uint64_t length, RequestPriority priority) {
+        auto reader = PhysicalReaderUtil::newPhysicalReader(::Storage::file, path);
+        for (int b = 0; b < batchNum; b++) {
+            RequestBatch batch(1);
+            batch.setPriority(priority);
+            uint64_t start = (b * length) % (fileSize - length);
+            batch.add(0, start, length);
+            auto buffers = scheduler->executeBatch(reader, batch, 0);
+            ASSERT_EQ(buffers.size(), 1);
+            ASSERT_EQ(buffers[0]->getPointer()[0], (uint8_t) (start % 251));
+            ASSERT_EQ(buffers[0]->getPointer()[length - 1], (uint8_t) ((start + length - 1) % 251));
+        }
+        reader->close();
+    }
+
+    static double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    static constexpr double bytesPerSecond = 8.0 * 1024 * 1024;
+    static const uint64_t fileSize = 4 * 1024 * 1024;
+    static Scheduler *scheduler;
+    static std::string path;
+    static std::unique_ptr<ScopedProperties> properties;
+};
+
+Scheduler *RateLimitedSchedulerTest::scheduler = nullptr;
+std::string RateLimitedSchedulerTest::path;
+std::unique_ptr<ScopedProperties> RateLimitedSchedulerTest::properties;
+
+TEST_F(RateLimitedSchedulerTest, ParsePriority) {
+    EXPECT_EQ(RateLimitedScheduler::ParsePriority("interactive"), RequestPriority::INTERACTIVE);
+    EXPECT_EQ(RateLimitedScheduler::ParsePriority("Batch"), RequestPriority::BATCH);
+    EXPECT_THROW(RateLimitedScheduler::ParsePriority("urgent"), InvalidArgumentException);
+}
+
+TEST_F(RateLimitedSchedulerTest, Rate) {
+    // pay off the debt left by the other tests
+    readBatches(1, 1024, RequestPriority::INTERACTIVE);
+    const int batchNum = 16;
+    const uint64_t length = 256 * 1024;
+    auto start = std::chrono::steady_clock::now();
+    readBatches(batchNum + 1, length, RequestPriority::INTERACTIVE);
+    double seconds = secondsSince(start);
+    // each batch waits for the debt of the previous one
+    double expected = batchNum * length / bytesPerSecond;
+    EXPECT_GE(seconds, expected * 0.9);
+    EXPECT_LE(seconds, expected * 3);
+}
+
+TEST_F(RateLimitedSchedulerTest, LargeBatchLeavesDebt) {
+    readBatches(1, 1024, RequestPriority::INTERACTIVE);
+    // the batch is larger than the bucket, it is issued at once and the next batch pays for it
+    auto start = std::chrono::steady_clock::now();
+    readBatches(1, 2 * 1024 * 1024, RequestPriority::INTERACTIVE);
+    EXPECT_LT(secondsSince(start), 0.2);
+    readBatches(1, 1024, RequestPriority::INTERACTIVE);
+    EXPECT_GE(secondsSince(start), 2 * 1024 * 1024 / bytesPerSecond * 0.9);
+}
+
+TEST_F(RateLimitedSchedulerTest, InteractiveFirst) {
+    // the bucket is in debt for 0.25 seconds
+    readBatches(1, 2 * 1024 * 1024, RequestPriority::BATCH);
+    std::atomic<int> order{0};
+    std::vector<int> batchOrders(3, -1);
+    int interactiveOrder = -1;
+    std::vector<std::thread> batchQueries;
+    for (int q = 0; q < (int) batchOrders.size(); q++) {
+        batchQueries.emplace_back([&, q]() {
+            readBatches(1, 256 * 1024, RequestPriority::BATCH);
+            batchOrders[q] = order++;
+        });
+    }
+    // the interactive batch arrives later, but it is admitted before the waiting batches of the batch queries
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    std::thread interactiveQuery([&]() {
+        readBatches(1, 256 * 1024, RequestPriority::INTERACTIVE);
+        interactiveOrder = order++;
+    });
+    for (auto &batchQuery : batchQueries) {
+        batchQuery.join();
+    }
+    interactiveQuery.join();
+    EXPECT_EQ(interactiveOrder, 0);
+    for (int batchOrder : batchOrders) {
+        EXPECT_GT(batchOrder, 0);
+    }
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Micro-benchmark of the io_uring modes of DirectUringRandomAccessFile. It reads random blocks of
+ * the file in PIXELS_URING_BENCHMARK_FILE, or of a generated file in the page cache if it is not set,
+ * and reports the IOPS and the CPU time per GB of each mode. The CPU time of the process includes
+ * the SQPOLL kernel thread and the io_uring workers. The reads of the generated file are checked
+ * against its content, and the generated file is removed at the end.
+ */
+#include "physical/natives/DirectUringRandomAccessFile.h"
+#include "utils/ConfigFactory.h"
+
+#include "gtest/gtest.h"
+
+#include <sys/resource.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+static const int READ_SIZE = 64 * 1024;
+static const int NUM_READS = 16384;
+// the reads in flight, a batch is submitted in several parts if the queue depth is smaller
+static const int BATCH_SIZE = 128;
+static const long GENERATED_FILE_SIZE = 256L * 1024 * 1024;
+
+static double cpuSeconds() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec
+           + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+// the byte at the offset of the generated file
+static char generatedByte(long offset) {
+    return (char) (offset * 31);
+}
+
+// @param generated set to whether the file is generated
+static std::string getFile(bool &generated) {
+    const char * file = std::getenv("PIXELS_URING_BENCHMARK_FILE");
+    generated = file == nullptr;
+    if (!generated) {
+        return file;
+    }
+    std::string path = "/tmp/pixels_uring_benchmark.bin";
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    std::vector<char> block(1024 * 1024);
+    for (long written = 0; written < GENERATED_FILE_SIZE; written += block.size()) {
+        for (size_t i = 0; i < block.size(); i++) {
+            block[i] = generatedByte(written + i);
+        }
+        output.write(block.data(), block.size());
+    }
+    return path;
+}
+
+static void runMode(const std::string &name, const UringOptions &options, const std::string &path, bool generated) {
+    DirectUringRandomAccessFile::Reset();
+    DirectUringRandomAccessFile::Initialize(options);
+    int depth = BATCH_SIZE;
+    int blockSize = std::stoi(ConfigFactory::Instance().getProperty("localfs.block.size"));
+    DirectIoLib directIoLib(blockSize);
+    std::vector<std::shared_ptr<ByteBuffer>> buffers;
+    for (int i = 0; i < depth; i++) {
+        buffers.emplace_back(directIoLib.allocateDirectBuffer(READ_SIZE));
+    }
+    DirectUringRandomAccessFile::RegisterBuffer(buffers);
+
+    DirectUringRandomAccessFile file(path);
+    long blocks = file.length() / READ_SIZE;
+    ASSERT_GT(blocks, 0) << path << " is smaller than a read";
+    std::mt19937_64 random(0);
+    double cpuStart = cpuSeconds();
+    auto start = std::chrono::steady_clock::now();
+    std::vector<long> offsets(depth);
+    std::vector<std::shared_ptr<ByteBuffer>> results(depth);
+    for (int issued = 0; issued < NUM_READS; issued += depth) {
+        for (int i = 0; i < depth; i++) {
+            offsets[i] = (long) (random() % blocks) * READ_SIZE;
+            file.seek(offsets[i]);
+            results[i] = file.readAsync(READ_SIZE, buffers[i], i);
+        }
+        int completed = 0;
+        // a failed or short read throws
+        ASSERT_NO_THROW({
+            file.readAsyncSubmit(depth);
+            file.readAsyncComplete(depth, [&completed](int index) { completed++; });
+        }) << name;
+        ASSERT_EQ(completed, depth) << name;
+        for (int i = 0; generated && i < depth; i++) {
+            ASSERT_EQ(results[i]->getPointer()[0], (uint8_t) generatedByte(offsets[i])) << name;
+            ASSERT_EQ(results[i]->getPointer()[READ_SIZE - 1], (uint8_t) generatedByte(offsets[i] + READ_SIZE - 1))
+                    << name;
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    double cpu = cpuSeconds() - cpuStart;
+    double gigabytes = (double) NUM_READS * READ_SIZE / (1024.0 * 1024 * 1024);
+    printf("%-28s %10.0f IOPS %8.1f MB/s %8.2f CPU s/GB\n", name.c_str(), NUM_READS / elapsed.count(),
+           gigabytes * 1024 / elapsed.count(), cpu / gigabytes);
+    file.close();
+    DirectUringRandomAccessFile::Reset();
+}
+
+TEST(UringBenchmark, RandomReads) {
+    bool generated;
+    std::string path = getFile(generated);
+    UringOptions defaults;
+    std::vector<std::pair<std::string, UringOptions>> modes;
+    modes.emplace_back("default", defaults);
+    UringOptions registerFiles = defaults;
+    registerFiles.registerFiles = true;
+    modes.emplace_back("registered files", registerFiles);
+    UringOptions asyncHint = defaults;
+    asyncHint.asyncHint = true;
+    modes.emplace_back("async hint", asyncHint);
+    UringOptions sqpoll = registerFiles;
+    sqpoll.sqpoll = true;
+    modes.emplace_back("sqpoll, registered files", sqpoll);
+    // the batches are larger than the submission queue
+    UringOptions shallow = defaults;
+    shallow.queueDepth = 16;
+    modes.emplace_back("queue depth 16", shallow);
+    if (ConfigFactory::Instance().boolCheckProperty("localfs.enable.direct.io")) {
+        UringOptions iopoll = registerFiles;
+        iopoll.iopoll = true;
+        modes.emplace_back("iopoll, registered files", iopoll);
+    }
+    for (const auto &mode : modes) {
+        runMode(mode.first, mode.second, path, generated);
+    }
+    if (generated) {
+        std::remove(path.c_str());
+    }
+}
@@ -0,0 +1,215 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#include "PixelsTestUtils.h"
+#include "reader/PixelsRecordReaderImpl.h"
+#include "vector/LongColumnVector.h"
+#include "vector/BinaryColumnVector.h"
+#include "duckdb/planner/table_filter.hpp"
+#include "gtest/gtest.h"
+#include <functional>
+#include <random>
+
+/**
+ * Scan a run-length encoded integer column and a dictionary encoded string column with the
+ * filters evaluated on the runs and the dictionary entries, and compare the rows that pass with
+ * the rows of a scan without filters that are filtered after decoding.
+ */
+class EncodedFilterTest : public ::testing::Test {
+protected:
+    struct Row {
+        bool aValid;
+        int64_t a;
+        bool sValid;
+        std::string s;
+    };
+
+    void SetUp() override {
+        std::mt19937 random(11);
+        // ten distinct strings, so that the writer keeps the dictionary encoding
+        std::vector<std::string> keys;
+        for (int k = 0; k < 10; k++) {
+            keys.push_back("k" + std::to_string(k));
+        }
+        file.reset(new TempPixelsFile("pixels_encoded_filter", "struct<a:bigint,s:varchar(8)>", pixelStride,
+                                      1000, rowNum, [&](VectorizedRowBatch &rowBatch, int row, int i) {
+            auto a = std::static_pointer_cast<LongColumnVector>(rowBatch.cols[0]);
+            auto s = std::static_pointer_cast<BinaryColumnVector>(rowBatch.cols[1]);
+            // repeats, ascending runs, random values and descending runs of 50 rows
+            switch ((i / 50) % 4) {
+                case 0: a->add((int64_t) (i / 50)); break;
+                case 1: a->add((int64_t) i); break;
+                case 2: a->add((int64_t) (random() % 1000)); break;
+                default: a->add((int64_t) (rowNum - i)); break;
+            }
+            if (i % 37 == 0) {
+                a->isNull[row] = true;
+                a->noNulls = false;
+            }
+            if (i % 41 == 0) {
+                s->addNull();
+            } else {
+                const std::string &key = keys[(i * 7 + i / 100) % keys.size()];
+                s->setRef(row, (uint8_t *) key.data(), 0, key.size());
+                s->isNull[row] = false;
+            }
+        }));
+        reader = file->openReader();
+        duckdb::TableFilterSet noFilters;
+        rows = scan(noFilters, false);
+        ASSERT_EQ(rows.size(), rowNum);
+    }
+
+    void TearDown() override {
+        reader->close();
+    }
+
+    /**
+     * @return the rows that pass the filters
+     */
+    std::vector<Row> scan(duckdb::TableFilterSet &filters, bool pushDown) {
+        auto option = TempPixelsFile::scanOption({"a", "s"}, pixelStride, 0, reader->getRowGroupNum());
+        if (pushDown) {
+            option.setFilter(&filters);
+            option.setEnabledFilterPushDown(true);
+        }
+        auto recordReader = reader->read(option);
+        auto impl = std::static_pointer_cast<PixelsRecordReaderImpl>(recordReader);
+        std::vector<Row> passed;
+        while (true) {
+            auto rowBatch = recordReader->readBatch(false);
+            if (rowBatch->cols.empty()) {
+                break;
+            }
+            auto mask = pushDown ? impl->getFilterMask() : nullptr;
+            auto a = std::static_pointer_cast<LongColumnVector>(rowBatch->cols[0]);
+            auto s = std::static_pointer_cast<BinaryColumnVector>(rowBatch->cols[1]);
+            for (int i = 0; i < rowBatch->rowCount; i++) {
+                if (mask == nullptr || mask->get(i)) {
+                    Row row{a->checkValid(i), 0, s->checkValid(i), ""};
+                    if (row.aValid) {
+                        row.a = a->longVector[i];
+                    }
+                    if (row.sValid) {
+                        row.s = s->isDictionary ? s->dictionary->values[s->dictIds[i]].GetString()
+                                                : s->vector[i].GetString();
+                    }
+                    passed.push_back(row);
+                }
+            }
+            if (rowBatch->isEndOfFile()) {
+                break;
+            }
+        }
+        recordReader->close();
+        return passed;
+    }
+
+    // scan with the filters pushed down, and compare with the decoded rows filtered by the predicate
+    void expectFiltered(duckdb::TableFilterSet &filters, const std::function<bool(const Row &)> &predicate) {
+        std::vector<Row> expected;
+        for (const auto &row : rows) {
+            if (predicate(row)) {
+                expected.push_back(row);
+            }
+        }
+        auto passed = scan(filters, true);
+        ASSERT_EQ(passed.size(), expected.size());
+        for (size_t i = 0; i < passed.size(); i++) {
+            EXPECT_EQ(passed[i].aValid, expected[i].aValid) << "row " << i;
+            EXPECT_EQ(passed[i].a, expected[i].a) << "row " << i;
+            EXPECT_EQ(passed[i].sValid, expected[i].sValid) << "row " << i;
+            EXPECT_EQ(passed[i].s, expected[i].s) << "row " << i;
+        }
+    }
+
+    static duckdb::unique_ptr<duckdb::TableFilter> compare(duckdb::ExpressionType type, duckdb::Value value) {
+        return duckdb::make_uniq<duckdb::ConstantFilter>(type, std::move(value));
+    }
+
+    static duckdb::unique_ptr<duckdb::TableFilter> between(duckdb::Value lower, duckdb::Value upper) {
+        auto conjunction = duckdb::make_uniq<duckdb::ConjunctionAndFilter>();
+        conjunction->child_filters.push_back(compare(duckdb::ExpressionType::COMPARE_GREATERTHANOREQUALTO, lower));
+        conjunction->child_filters.push_back(compare(duckdb::ExpressionType::COMPARE_LESSTHANOREQUALTO, upper));
+        return std::move(conjunction);
+    }
+
+    static const int pixelStride = 100;
+    const int rowNum = 3000;
+    std::unique_ptr<TempPixelsFile> file;
+    std::shared_ptr<PixelsReader> reader;
+    std::vector<Row> rows;
+};
+
+TEST_F(EncodedFilterTest, IntegerRuns) {
+    {
+        // matches whole repeat runs
+        duckdb::TableFilterSet filters;
+        filters.filters[0] = compare(duckdb::ExpressionType::COMPARE_EQUAL, duckdb::Value::BIGINT(20));
+        expectFiltered(filters, [](const Row &row) { return row.aValid && row.a == 20; });
+    }
+    {
+        // matches parts of the ascending and the descending runs
+        duckdb::TableFilterSet filters;
+        filters.filters[0] = compare(duckdb::ExpressionType::COMPARE_GREATERTHAN, duckdb::Value::BIGINT(1500));
+        expectFiltered(filters, [](const Row &row) { return row.aValid && row.a > 1500; });
+    }
+    {
+        duckdb::TableFilterSet filters;
+        filters.filters[0] = between(duckdb::Value::BIGINT(100), duckdb::Value::BIGINT(700));
+        expectFiltered(filters, [](const Row &row) { return row.aValid && row.a >= 100 && row.a <= 700; });
+    }
+    {
+        duckdb::TableFilterSet filters;
+        filters.filters[0] = compare(duckdb::ExpressionType::COMPARE_LESSTHAN, duckdb::Value::BIGINT(0));
+        expectFiltered(filters, [](const Row &row) { return row.aValid && row.a < 0; });
+    }
+}
+
+TEST_F(EncodedFilterTest, DictionaryEntries) {
+    {
+        duckdb::TableFilterSet filters;
+        filters.filters[1] = compare(duckdb::ExpressionType::COMPARE_EQUAL, duckdb::Value("k3"));
+        expectFiltered(filters, [](const Row &row) { return row.sValid && row.s == "k3"; });
+    }
+    {
+        duckdb::TableFilterSet filters;
+        filters.filters[1] = compare(duckdb::ExpressionType::COMPARE_LESSTHAN, duckdb::Value("k4"));
+        expectFiltered(filters, [](const Row &row) { return row.sValid && row.s < "k4"; });
+    }
+    {
+        duckdb::TableFilterSet filters;
+        filters.filters[1] = between(duckdb::Value("k2"), duckdb::Value("k5"));
+        expectFiltered(filters, [](const Row &row) { return row.sValid && row.s >= "k2" && row.s <= "k5"; });
+    }
+    {
+        duckdb::TableFilterSet filters;
+        filters.filters[1] = compare(duckdb::ExpressionType::COMPARE_GREATERTHAN, duckdb::Value("z"));
+        expectFiltered(filters, [](const Row &row) { return row.sValid && row.s > "z"; });
+    }
+}
+
+TEST_F(EncodedFilterTest, BothColumns) {
+    duckdb::TableFilterSet filters;
+    filters.filters[0] = compare(duckdb::ExpressionType::COMPARE_GREATERTHAN, duckdb::Value::BIGINT(200));
+    filters.filters[1] = compare(duckdb::ExpressionType::COMPARE_EQUAL, duckdb::Value("k1"));
+    expectFiltered(filters, [](const Row &row) {
+        return row.aValid && row.a > 200 && row.sValid && row.s == "k1";
+    });
+}
@@ -0,0 +1,172 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#include "PixelIndex.h"
+#include "PixelsFilter.h"
+#include "PixelsTestUtils.h"
+#include "reader/PixelsRecordReaderImpl.h"
+#include "vector/LongColumnVector.h"
+#include "duckdb/planner/table_filter.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+pixels::proto::ColumnStatistic pixelStatistic(bool hasCount, uint32_t count, bool hasNull,
+                                              int64_t minimum, int64_t maximum) {
+    pixels::proto::ColumnStatistic statistic;
+    if (hasCount) {
+        statistic.set_numberofvalues(count);
+        statistic.mutable_intstatistics()->set_minimum(minimum);
+        statistic.mutable_intstatistics()->set_maximum(maximum);
+    }
+    statistic.set_hasnull(hasNull);
+    return statistic;
+}
+
+std::vector<uint8_t> checkPixelIndex(const pixels::proto::ColumnChunkIndex &chunkIndex,
+                                     duckdb::TableFilter &filter) {
+    PixelIndex index(chunkIndex);
+    std::vector<uint8_t> matches(index.getPixelNum(), 1);
+    PixelsFilter::CheckPixelIndex(index, filter, TypeDescription::createLong(), matches.data());
+    return matches;
+}
+
+}
+
+TEST(PixelIndexTest, NullPixels) {
+    PixelIndex::Builder builder;
+    // written before the writers counted the values: no count, no nulls
+    builder.add(pixelStatistic(false, 0, false, 0, 0));
+    // all null
+    builder.add(pixelStatistic(true, 0, true, 0, 0));
+    // some nulls
+    builder.add(pixelStatistic(true, 5, true, 10, 20));
+    // no nulls
+    builder.add(pixelStatistic(true, 10, false, 30, 40));
+    pixels::proto::ColumnChunkIndex chunkIndex;
+    chunkIndex.set_pixelindex(builder.build());
+
+    duckdb::IsNullFilter isNull;
+    EXPECT_EQ(checkPixelIndex(chunkIndex, isNull), std::vector<uint8_t>({0, 1, 1, 0}));
+    duckdb::IsNotNullFilter isNotNull;
+    EXPECT_EQ(checkPixelIndex(chunkIndex, isNotNull), std::vector<uint8_t>({1, 0, 1, 1}));
+    // the pixel without min/max is not pruned by the range
+    duckdb::ConstantFilter greaterThan(duckdb::ExpressionType::COMPARE_GREATERTHAN, duckdb::Value::BIGINT(25));
+    EXPECT_EQ(checkPixelIndex(chunkIndex, greaterThan), std::vector<uint8_t>({1, 0, 0, 1}));
+}
+
+/**
+ * Write a column with all-null, partially null and non-null pixels, and check that scanning it
+ * with the filters pushed down returns exactly the rows that satisfy the filters.
+ */
+class PixelIndexRoundTripTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        file.reset(new TempPixelsFile("pixel_index", "struct<a:bigint>", pixelStride, 200, rowNum,
+                                      [](VectorizedRowBatch &rowBatch, int row, int i) {
+            auto a = std::static_pointer_cast<LongColumnVector>(rowBatch.cols[0]);
+            if (isNullRow(i)) {
+                a->addNull();
+            } else {
+                a->add((int64_t) i);
+            }
+        }));
+        reader = file->openReader();
+    }
+
+    void TearDown() override {
+        reader->close();
+    }
+
+    // every third pixel is all null, the pixel after it has nulls in its first half
+    static bool isNullRow(int i) {
+        int pixelId = i / pixelStride;
+        return pixelId % 3 == 0 || (pixelId % 3 == 1 && i % pixelStride < pixelStride / 2);
+    }
+
+    /**
+     * @return the row ids of the rows that pass the filter
+     */
+    std::vector<int> scan(duckdb::TableFilterSet &filters) {
+        auto option = TempPixelsFile::scanOption({"a"}, pixelStride, 0, reader->getRowGroupNum());
+        option.setFilter(&filters);
+        option.setEnabledFilterPushDown(true);
+        auto recordReader = reader->read(option);
+        auto impl = std::static_pointer_cast<PixelsRecordReaderImpl>(recordReader);
+        std::vector<int> passed;
+        int rowId = 0;
+        while (true) {
+            auto rowBatch = recordReader->readBatch(false);
+            if (rowBatch->cols.empty()) {
+                break;
+            }
+            auto mask = impl->getFilterMask();
+            auto a = std::static_pointer_cast<LongColumnVector>(rowBatch->cols[0]);
+            for (int i = 0; i < rowBatch->rowCount; i++) {
+                if (mask == nullptr || mask->get(i)) {
+                    // the non-null values are the row ids
+                    EXPECT_TRUE(!a->checkValid(i) || a->longVector[i] == rowId + i);
+                    passed.push_back(rowId + i);
+                }
+            }
+            rowId += rowBatch->rowCount;
+            if (rowBatch->isEndOfFile()) {
+                break;
+            }
+        }
+        recordReader->close();
+        return passed;
+    }
+
+    template <class Predicate>
+    std::vector<int> expected(Predicate predicate) {
+        std::vector<int> rows;
+        for (int i = 0; i < rowNum; i++) {
+            if (predicate(i)) {
+                rows.push_back(i);
+            }
+        }
+        return rows;
+    }
+
+    static const int pixelStride = 10;
+    const int rowNum = 300;
+    std::unique_ptr<TempPixelsFile> file;
+    std::shared_ptr<PixelsReader> reader;
+};
+
+TEST_F(PixelIndexRoundTripTest, IsNull) {
+    duckdb::TableFilterSet filters;
+    filters.filters[0] = duckdb::make_uniq<duckdb::IsNullFilter>();
+    EXPECT_EQ(scan(filters), expected([](int i) { return isNullRow(i); }));
+}
+
+TEST_F(PixelIndexRoundTripTest, IsNotNull) {
+    duckdb::TableFilterSet filters;
+    filters.filters[0] = duckdb::make_uniq<duckdb::IsNotNullFilter>();
+    EXPECT_EQ(scan(filters), expected([](int i) { return !isNullRow(i); }));
+}
+
+TEST_F(PixelIndexRoundTripTest, Comparison) {
+    // a < 100, the nulls are padded by 0 but do not satisfy the comparison
+    duckdb::TableFilterSet filters;
+    filters.filters[0] = duckdb::make_uniq<duckdb::ConstantFilter>(
+            duckdb::ExpressionType::COMPARE_LESSTHAN, duckdb::Value::BIGINT(100));
+    EXPECT_EQ(scan(filters), expected([](int i) { return i < 100 && !isNullRow(i); }));
+}
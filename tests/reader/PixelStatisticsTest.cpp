@@ -0,0 +1,97 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#include "PixelsTestUtils.h"
+#include "reader/PixelsRecordReaderImpl.h"
+#include "vector/LongColumnVector.h"
+#include "duckdb/planner/table_filter.hpp"
+#include "gtest/gtest.h"
+
+/**
+ * Scan a file with batches that are not aligned to the pixels, so that a batch overlaps two
+ * pixels. The pixels pruned by their statistics must only clear their own rows of the batch.
+ */
+class PixelStatisticsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        file.reset(new TempPixelsFile("pixel_statistics", "struct<a:bigint>", pixelStride, 200, rowNum,
+                                      [](VectorizedRowBatch &rowBatch, int row, int i) {
+            std::static_pointer_cast<LongColumnVector>(rowBatch.cols[0])->add((int64_t) i);
+        }));
+        reader = file->openReader();
+    }
+
+    void TearDown() override {
+        reader->close();
+    }
+
+    /**
+     * @return the values of the rows that pass the filter
+     */
+    std::vector<int64_t> scan(duckdb::TableFilterSet &filters, int batchSize) {
+        auto option = TempPixelsFile::scanOption({"a"}, batchSize, 0, reader->getRowGroupNum());
+        option.setFilter(&filters);
+        option.setEnabledFilterPushDown(true);
+        auto recordReader = reader->read(option);
+        auto impl = std::static_pointer_cast<PixelsRecordReaderImpl>(recordReader);
+        std::vector<int64_t> passed;
+        while (true) {
+            auto rowBatch = recordReader->readBatch(false);
+            if (rowBatch->cols.empty()) {
+                break;
+            }
+            auto mask = impl->getFilterMask();
+            auto a = std::static_pointer_cast<LongColumnVector>(rowBatch->cols[0]);
+            for (int i = 0; i < rowBatch->rowCount; i++) {
+                if (mask == nullptr || mask->get(i)) {
+                    passed.push_back(a->longVector[i]);
+                }
+            }
+            if (rowBatch->isEndOfFile()) {
+                break;
+            }
+        }
+        recordReader->close();
+        return passed;
+    }
+
+    static const int pixelStride = 10;
+    const int rowNum = 1000;
+    std::unique_ptr<TempPixelsFile> file;
+    std::shared_ptr<PixelsReader> reader;
+};
+
+TEST_F(PixelStatisticsTest, BatchOverlapsPrunedPixel) {
+    // a >= 20 and a < 45: the pixel [10, 20) is pruned, the batch [16, 24) of 8 rows or [18, 21)
+    // of 3 rows starts in it, but its last rows are in the pixel [20, 30) that is not pruned
+    duckdb::TableFilterSet filters;
+    auto conjunction = duckdb::make_uniq<duckdb::ConjunctionAndFilter>();
+    conjunction->child_filters.push_back(duckdb::make_uniq<duckdb::ConstantFilter>(
+            duckdb::ExpressionType::COMPARE_GREATERTHANOREQUALTO, duckdb::Value::BIGINT(20)));
+    conjunction->child_filters.push_back(duckdb::make_uniq<duckdb::ConstantFilter>(
+            duckdb::ExpressionType::COMPARE_LESSTHAN, duckdb::Value::BIGINT(45)));
+    filters.filters[0] = std::move(conjunction);
+    for (int batchSize : {3, 8, pixelStride}) {
+        auto passed = scan(filters, batchSize);
+        ASSERT_EQ(passed.size(), 25) << "batch size " << batchSize;
+        for (int i = 0; i < 25; i++) {
+            EXPECT_EQ(passed[i], 20 + i) << "batch size " << batchSize;
+        }
+    }
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#include "PixelsChunkCache.h"
+#include "exception/InvalidArgumentException.h"
+#include "gtest/gtest.h"
+#include <cstring>
+
+namespace {
+
+const uint64_t chunkSize = 1024;
+
+std::vector<uint8_t> newChunk(uint8_t value) {
+    return std::vector<uint8_t>(chunkSize, value);
+}
+
+// look the chunk up the way the record reader does, and cache it on a miss
+bool read(PixelsChunkCache &cache, const std::string &id, uint8_t value) {
+    if (cache.find(id) != nullptr) {
+        return true;
+    }
+    auto chunk = newChunk(value);
+    return cache.put(id, chunk.data(), chunk.size());
+}
+
+void expectChunk(const std::shared_ptr<ByteBuffer> &chunk, uint8_t value) {
+    ASSERT_NE(chunk, nullptr);
+    ASSERT_EQ(chunk->size(), chunkSize);
+    for (uint64_t i = 0; i < chunkSize; i++) {
+        ASSERT_EQ(chunk->getPointer()[i], value) << "at " << i;
+    }
+}
+
+}
+
+TEST(PixelsChunkCacheTest, PutAndFind) {
+    PixelsChunkCache cache(16 * chunkSize, 1);
+    EXPECT_EQ(cache.find("a"), nullptr);
+    ASSERT_TRUE(read(cache, "a", 1));
+    expectChunk(cache.find("a"), 1);
+    // an existing chunk is not copied again
+    ASSERT_TRUE(read(cache, "a", 2));
+    expectChunk(cache.find("a"), 1);
+    EXPECT_EQ(cache.getSize(), chunkSize);
+    EXPECT_THROW(PixelsChunkCache(chunkSize, 0), InvalidArgumentException);
+}
+
+TEST(PixelsChunkCacheTest, RejectChunkSize) {
+    PixelsChunkCache cache(4 * chunkSize, 2);
+    auto chunk = newChunk(1);
+    EXPECT_FALSE(cache.put("empty", chunk.data(), 0));
+    // each of the two shards holds two chunks
+    std::vector<uint8_t> large(2 * chunkSize + 1, 1);
+    EXPECT_FALSE(cache.put("large", large.data(), large.size()));
+    EXPECT_EQ(cache.getSize(), 0);
+}
+
+TEST(PixelsChunkCacheTest, ColdChunkNotAdmitted) {
+    PixelsChunkCache cache(4 * chunkSize, 1);
+    // the hot chunks are read three times
+    for (int pass = 0; pass < 3; pass++) {
+        for (int c = 0; c < 4; c++) {
+            ASSERT_TRUE(read(cache, "hot" + std::to_string(c), c));
+        }
+    }
+    // a scan that reads each chunk once does not flush out the hot chunks
+    for (int c = 0; c < 16; c++) {
+        EXPECT_FALSE(read(cache, "scan" + std::to_string(c), 100));
+    }
+    for (int c = 0; c < 4; c++) {
+        expectChunk(cache.find("hot" + std::to_string(c)), c);
+    }
+    EXPECT_EQ(cache.getSize(), 4 * chunkSize);
+}
+
+TEST(PixelsChunkCacheTest, HotChunkReplacesColdChunk) {
+    PixelsChunkCache cache(4 * chunkSize, 1);
+    for (int c = 0; c < 4; c++) {
+        ASSERT_TRUE(read(cache, "cold" + std::to_string(c), c));
+    }
+    // the new chunk is read more often than the least recently used chunk cold0
+    EXPECT_FALSE(read(cache, "hot", 100));
+    EXPECT_TRUE(read(cache, "hot", 100));
+    expectChunk(cache.find("hot"), 100);
+    EXPECT_EQ(cache.find("cold0"), nullptr);
+    for (int c = 1; c < 4; c++) {
+        expectChunk(cache.find("cold" + std::to_string(c)), c);
+    }
+    EXPECT_EQ(cache.getSize(), 4 * chunkSize);
+}
+
+TEST(PixelsChunkCacheTest, ViewOutlivesEviction) {
+    PixelsChunkCache cache(chunkSize, 1);
+    ASSERT_TRUE(read(cache, "a", 1));
+    auto view = cache.find("a");
+    // b is read more often than a, so it replaces a while the view is still read
+    for (int i = 0; i < 3; i++) {
+        cache.find("b");
+    }
+    auto chunk = newChunk(2);
+    ASSERT_TRUE(cache.put("b", chunk.data(), chunk.size()));
+    EXPECT_EQ(cache.find("a"), nullptr);
+    expectChunk(view, 1);
+    // each view has its own read position
+    auto other = cache.find("b");
+    auto another = cache.find("b");
+    other->getInt();
+    EXPECT_EQ(another->getReadPos(), 0);
+}
@@ -0,0 +1,172 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#include "PixelsTestUtils.h"
+#include "reader/PixelsRecordReaderImpl.h"
+#include "physical/BufferPool.h"
+#include "physical/natives/DirectUringRandomAccessFile.h"
+#include "vector/LongColumnVector.h"
+#include "vector/BinaryColumnVector.h"
+#include "duckdb/planner/table_filter.hpp"
+#include "gtest/gtest.h"
+#include <functional>
+
+/**
+ * Scan a compressed file with the async reads of io_uring, where the columns are decompressed and
+ * decoded in the order their reads complete, while the next row group is read on the same ring the
+ * way pixels_scan does. The filter columns are decoded first, and the other columns are skipped
+ * once no row of a batch passes the filters.
+ */
+class PixelsCompletionOrderTest : public ::testing::TestWithParam<const char *> {
+protected:
+    void SetUp() override {
+        properties.set("compression.kind", GetParam());
+        properties.set("localfs.enable.async.io", "true");
+        properties.set("localfs.async.lib", "iouring");
+        for (int k = 0; k < 7; k++) {
+            keys.push_back("k" + std::to_string(k));
+        }
+        // small compression blocks, so that each chunk is decompressed block by block
+        file.reset(new TempPixelsFile("pixels_completion_order", "struct<a:bigint,s:varchar(8),c:bigint>",
+                                      pixelStride, 400, rowNum, [this](VectorizedRowBatch &rowBatch, int row, int i) {
+            auto s = std::static_pointer_cast<BinaryColumnVector>(rowBatch.cols[1]);
+            std::static_pointer_cast<LongColumnVector>(rowBatch.cols[0])->add((int64_t) i * 3);
+            s->setRef(row, (uint8_t *) keys[i % keys.size()].data(), 0, keys[i % keys.size()].size());
+            s->isNull[row] = false;
+            std::static_pointer_cast<LongColumnVector>(rowBatch.cols[2])->add((int64_t) i * 7);
+        }, 64));
+        ::DirectUringRandomAccessFile::Initialize();
+    }
+
+    void TearDown() override {
+        ::DirectUringRandomAccessFile::Release(::BufferPool::Release());
+    }
+
+    std::shared_ptr<PixelsRecordReader> readRowGroup(const std::shared_ptr<PixelsReader> &reader, int rgId,
+                                                     duckdb::TableFilterSet &filters) {
+        auto option = TempPixelsFile::scanOption({"a", "s", "c"}, pixelStride, rgId, 1);
+        option.setFilter(&filters);
+        option.setEnabledFilterPushDown(!filters.filters.empty());
+        auto recordReader = reader->read(option);
+        // issue the async reads of the row group
+        std::static_pointer_cast<PixelsRecordReaderImpl>(recordReader)->read();
+        return recordReader;
+    }
+
+    /**
+     * Scan the row groups one by one, issuing the reads of the next row group before the current one
+     * is decoded, and check the rows that pass the filters.
+     */
+    void expectScan(duckdb::TableFilterSet &filters, const std::function<bool(int)> &predicate) {
+        auto reader = file->openReader();
+        int rgNum = reader->getRowGroupNum();
+        ASSERT_GT(rgNum, 2);
+
+        std::shared_ptr<PixelsRecordReader> curr;
+        // the first rows of the current and the next row groups
+        int currStart = 0;
+        int nextStart = 0;
+        int passed = 0;
+        for (int rgId = 0; rgId <= rgNum; rgId++) {
+            ::BufferPool::Switch();
+            auto next = rgId < rgNum ? readRowGroup(reader, rgId, filters) : nullptr;
+            if (curr != nullptr) {
+                auto impl = std::static_pointer_cast<PixelsRecordReaderImpl>(curr);
+                int rowId = currStart;
+                while (true) {
+                    auto rowBatch = curr->readBatch(false);
+                    if (rowBatch->cols.empty()) {
+                        break;
+                    }
+                    auto mask = filters.filters.empty() ? nullptr : impl->getFilterMask();
+                    auto a = std::static_pointer_cast<LongColumnVector>(rowBatch->cols[0]);
+                    auto s = std::static_pointer_cast<BinaryColumnVector>(rowBatch->cols[1]);
+                    auto c = std::static_pointer_cast<LongColumnVector>(rowBatch->cols[2]);
+                    for (int i = 0; i < rowBatch->rowCount; i++) {
+                        int row = rowId + i;
+                        if (mask != nullptr && !mask->get(i)) {
+                            continue;
+                        }
+                        passed++;
+                        ASSERT_TRUE(predicate(row)) << "row " << row;
+                        ASSERT_EQ(a->longVector[i], (int64_t) row * 3) << "row " << row;
+                        ASSERT_EQ(c->longVector[i], (int64_t) row * 7) << "row " << row;
+                        std::string value = s->isDictionary ? s->dictionary->values[s->dictIds[i]].GetString()
+                                                            : s->vector[i].GetString();
+                        ASSERT_EQ(value, keys[row % keys.size()]) << "row " << row;
+                    }
+                    rowId += rowBatch->rowCount;
+                    if (rowBatch->isEndOfFile()) {
+                        break;
+                    }
+                }
+                // the row group is read to the end, unless it is pruned by its statistics
+                EXPECT_TRUE(rowId == currStart || rowId == nextStart) << "row group " << rgId - 1;
+                // the reads of the skipped columns are completed as well, none is left on the ring
+                EXPECT_EQ(impl->has_async_task_num_, 0);
+                curr->close();
+            }
+            curr = next;
+            currStart = nextStart;
+            if (rgId < rgNum) {
+                nextStart += (int) reader->getRowGroupInfo(rgId).numberofrows();
+            }
+        }
+        EXPECT_EQ(nextStart, rowNum);
+        int expected = 0;
+        for (int row = 0; row < rowNum; row++) {
+            expected += predicate(row);
+        }
+        EXPECT_EQ(passed, expected);
+        reader->close();
+    }
+
+    static duckdb::unique_ptr<duckdb::TableFilter> compare(duckdb::ExpressionType type, duckdb::Value value) {
+        return duckdb::make_uniq<duckdb::ConstantFilter>(type, std::move(value));
+    }
+
+    static const int pixelStride = 10;
+    const int rowNum = 2000;
+    ScopedProperties properties;
+    std::unique_ptr<TempPixelsFile> file;
+    std::vector<std::string> keys;
+};
+
+TEST_P(PixelsCompletionOrderTest, NoFilter) {
+    duckdb::TableFilterSet filters;
+    expectScan(filters, [](int row) { return true; });
+}
+
+TEST_P(PixelsCompletionOrderTest, FilterColumns) {
+    duckdb::TableFilterSet filters;
+    filters.filters[2] = compare(duckdb::ExpressionType::COMPARE_GREATERTHANOREQUALTO, duckdb::Value::BIGINT(5000));
+    filters.filters[1] = compare(duckdb::ExpressionType::COMPARE_EQUAL, duckdb::Value("k3"));
+    expectScan(filters, [](int row) { return row * 7 >= 5000 && row % 7 == 3; });
+}
+
+TEST_P(PixelsCompletionOrderTest, NoRowPasses) {
+    // the statistics can not prune the row groups, but the batches are abandoned after the first
+    // filter column that no row passes, and the other chunks are still completed
+    duckdb::TableFilterSet filters;
+    filters.filters[0] = compare(duckdb::ExpressionType::COMPARE_NOTEQUAL, duckdb::Value::BIGINT(-1));
+    filters.filters[1] = compare(duckdb::ExpressionType::COMPARE_EQUAL, duckdb::Value("k35"));
+    expectScan(filters, [](int row) { return false; });
+}
+
+INSTANTIATE_TEST_SUITE_P(Compression, PixelsCompletionOrderTest, ::testing::Values("lz4", "zstd"));
@@ -0,0 +1,281 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#include "PixelsTestUtils.h"
+#include "reader/PixelsRecordReaderImpl.h"
+#include "vector/LongColumnVector.h"
+#include "vector/BinaryColumnVector.h"
+#include "vector/DateColumnVector.h"
+#include "vector/TimestampColumnVector.h"
+#include "duckdb/planner/table_filter.hpp"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstdio>
+
+/**
+ * Write a file with the writer and scan it with pushed-down filters, as pixels_scan does for a
+ * query with a predicate. The row groups and pixels are pruned by the statistics written by the
+ * writer, and the surviving rows must be exactly the rows satisfying the predicate.
+ */
+class PixelsFilterPushdownTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        for (int i = 0; i < rowNum; i++) {
+            char value[16];
+            snprintf(value, sizeof(value), "v%04d", i);
+            strs.emplace_back(value);
+        }
+        file.reset(new TempPixelsFile("pixels_filter_pushdown", "struct<a:bigint,b:varchar(16),c:date,d:timestamp>",
+                                      pixelStride, 200, rowNum, [this](VectorizedRowBatch &rowBatch, int row, int i) {
+            std::static_pointer_cast<LongColumnVector>(rowBatch.cols[0])->add((int64_t) i);
+            auto b = std::static_pointer_cast<BinaryColumnVector>(rowBatch.cols[1]);
+            if (isNullRow(i)) {
+                b->addNull();
+            } else {
+                b->setRef(row, (uint8_t *) strs[i].data(), 0, strs[i].size());
+                b->isNull[row] = false;
+            }
+            std::static_pointer_cast<DateColumnVector>(rowBatch.cols[2])->set(row, dayOf(i));
+            std::static_pointer_cast<TimestampColumnVector>(rowBatch.cols[3])->set(row, timeOf(i));
+        }));
+        reader = file->openReader();
+    }
+
+    void TearDown() override {
+        reader->close();
+    }
+
+    /**
+     * Scan the file with the filters.
+     * @param seen the number of rows read, i.e., not pruned by the row group statistics
+     * @return the values of column a of the rows that pass the filters
+     */
+    std::vector<int64_t> scan(duckdb::TableFilterSet &filters, int &seen) {
+        auto option = TempPixelsFile::scanOption({"a", "b", "c", "d"}, pixelStride, 0, reader->getRowGroupNum());
+        option.setFilter(&filters);
+        option.setEnabledFilterPushDown(true);
+        auto recordReader = reader->read(option);
+        auto impl = std::static_pointer_cast<PixelsRecordReaderImpl>(recordReader);
+        std::vector<int64_t> passed;
+        seen = 0;
+        while (true) {
+            auto rowBatch = recordReader->readBatch(false);
+            if (rowBatch->cols.empty()) {
+                break;
+            }
+            auto mask = impl->getFilterMask();
+            auto a = std::static_pointer_cast<LongColumnVector>(rowBatch->cols[0]);
+            auto c = std::static_pointer_cast<DateColumnVector>(rowBatch->cols[2]);
+            auto d = std::static_pointer_cast<TimestampColumnVector>(rowBatch->cols[3]);
+            for (int i = 0; i < rowBatch->rowCount; i++) {
+                if (mask == nullptr || mask->get(i)) {
+                    passed.push_back(a->longVector[i]);
+                    EXPECT_EQ(c->dates[i], dayOf((int) a->longVector[i]));
+                    EXPECT_EQ(d->times[i], timeOf((int) a->longVector[i]));
+                }
+            }
+            seen += rowBatch->rowCount;
+            if (rowBatch->isEndOfFile()) {
+                break;
+            }
+        }
+        recordReader->close();
+        return passed;
+    }
+
+    // column b is null in the middle of each pixel, so that the bounds are not null
+    static bool isNullRow(int i) {
+        return i % pixelStride == 5;
+    }
+
+    // the dates and timestamps ascend with the rows, from 2000-01-01
+    static int dayOf(int i) {
+        return 10957 + i;
+    }
+
+    static int64_t timeOf(int i) {
+        return 946684800000000L + (int64_t) i * 1000000;
+    }
+
+    const int rowNum = 1000;
+    static const int pixelStride = 10;
+    std::vector<std::string> strs;
+    std::unique_ptr<TempPixelsFile> file;
+    std::shared_ptr<PixelsReader> reader;
+};
+
+TEST_F(PixelsFilterPushdownTest, WriterStatistics) {
+    int rgNum = reader->getRowGroupNum();
+    ASSERT_GT(rgNum, 2);
+    ASSERT_EQ(reader->getRowGroupStats().size(), rgNum);
+    int64_t rowId = 0;
+    for (int rgId = 0; rgId < rgNum; rgId++) {
+        auto rgInfo = reader->getRowGroupInfo(rgId);
+        auto rgStats = reader->getRowGroupStat(rgId);
+        auto &stats = rgStats.columnchunkstats(0);
+        EXPECT_EQ(stats.numberofvalues(), rgInfo.numberofrows());
+        EXPECT_FALSE(stats.hasnull());
+        EXPECT_EQ(stats.intstatistics().minimum(), rowId);
+        EXPECT_EQ(stats.intstatistics().maximum(), rowId + rgInfo.numberofrows() - 1);
+        EXPECT_TRUE(rgStats.columnchunkstats(1).hasnull());
+        auto &stringStats = rgStats.columnchunkstats(1).stringstatistics();
+        EXPECT_EQ(stringStats.minimum(), strs[rowId]);
+        EXPECT_EQ(stringStats.maximum(), strs[rowId + rgInfo.numberofrows() - 1]);
+        auto &dateStats = rgStats.columnchunkstats(2).datestatistics();
+        EXPECT_EQ(dateStats.minimum(), dayOf(rowId));
+        EXPECT_EQ(dateStats.maximum(), dayOf(rowId + rgInfo.numberofrows() - 1));
+        auto &timestampStats = rgStats.columnchunkstats(3).timestampstatistics();
+        EXPECT_EQ(timestampStats.minimum(), timeOf(rowId));
+        EXPECT_EQ(timestampStats.maximum(), timeOf(rowId + rgInfo.numberofrows() - 1));
+        rowId += rgInfo.numberofrows();
+    }
+    EXPECT_EQ(rowId, rowNum);
+
+    auto fileStats = reader->getColumnStat("a");
+    EXPECT_EQ(fileStats.numberofvalues(), rowNum);
+    EXPECT_EQ(fileStats.intstatistics().minimum(), 0);
+    EXPECT_EQ(fileStats.intstatistics().maximum(), rowNum - 1);
+    EXPECT_EQ(fileStats.intstatistics().sum(), (int64_t) rowNum * (rowNum - 1) / 2);
+}
+
+TEST_F(PixelsFilterPushdownTest, IntegerRangePredicate) {
+    // a >= 900
+    duckdb::TableFilterSet filters;
+    filters.filters[0] = duckdb::make_uniq<duckdb::ConstantFilter>(
+            duckdb::ExpressionType::COMPARE_GREATERTHANOREQUALTO, duckdb::Value::BIGINT(900));
+    int seen;
+    auto passed = scan(filters, seen);
+    ASSERT_EQ(passed.size(), 100);
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(passed[i], 900 + i);
+    }
+    // the row groups before 900 are pruned
+    EXPECT_LT(seen, rowNum);
+}
+
+TEST_F(PixelsFilterPushdownTest, StringEqualPredicate) {
+    // b = 'v0500'
+    duckdb::TableFilterSet filters;
+    filters.filters[1] = duckdb::make_uniq<duckdb::ConstantFilter>(
+            duckdb::ExpressionType::COMPARE_EQUAL, duckdb::Value("v0500"));
+    int seen;
+    auto passed = scan(filters, seen);
+    ASSERT_EQ(passed.size(), 1);
+    EXPECT_EQ(passed[0], 500);
+    EXPECT_LT(seen, rowNum);
+}
+
+TEST_F(PixelsFilterPushdownTest, IsNullPredicate) {
+    // there are no nulls, so all the row groups are pruned
+    duckdb::TableFilterSet filters;
+    filters.filters[0] = duckdb::make_uniq<duckdb::IsNullFilter>();
+    int seen;
+    auto passed = scan(filters, seen);
+    EXPECT_TRUE(passed.empty());
+    EXPECT_EQ(seen, 0);
+}
+
+TEST_F(PixelsFilterPushdownTest, StringNullPredicates) {
+    int seen;
+    {
+        duckdb::TableFilterSet filters;
+        filters.filters[1] = duckdb::make_uniq<duckdb::IsNullFilter>();
+        auto passed = scan(filters, seen);
+        EXPECT_EQ(passed.size(), rowNum / pixelStride);
+        for (auto value : passed) {
+            EXPECT_TRUE(isNullRow((int) value)) << value;
+        }
+    }
+    {
+        duckdb::TableFilterSet filters;
+        filters.filters[1] = duckdb::make_uniq<duckdb::IsNotNullFilter>();
+        auto passed = scan(filters, seen);
+        ASSERT_EQ(passed.size(), rowNum - rowNum / pixelStride);
+        for (auto value : passed) {
+            EXPECT_FALSE(isNullRow((int) value));
+        }
+    }
+    {
+        // b > 'v0900', the null rows do not satisfy a comparison
+        duckdb::TableFilterSet filters;
+        filters.filters[1] = duckdb::make_uniq<duckdb::ConstantFilter>(
+                duckdb::ExpressionType::COMPARE_GREATERTHAN, duckdb::Value("v0900"));
+        auto passed = scan(filters, seen);
+        std::vector<int64_t> expected;
+        for (int i = 901; i < rowNum; i++) {
+            if (!isNullRow(i)) {
+                expected.push_back(i);
+            }
+        }
+        EXPECT_EQ(passed, expected);
+    }
+}
+
+TEST_F(PixelsFilterPushdownTest, NotEqualPredicate) {
+    int seen;
+    {
+        // a <> 500
+        duckdb::TableFilterSet filters;
+        filters.filters[0] = duckdb::make_uniq<duckdb::ConstantFilter>(
+                duckdb::ExpressionType::COMPARE_NOTEQUAL, duckdb::Value::BIGINT(500));
+        auto passed = scan(filters, seen);
+        ASSERT_EQ(passed.size(), rowNum - 1);
+        EXPECT_EQ(std::count(passed.begin(), passed.end(), 500), 0);
+    }
+    {
+        // b <> 'v0500', the null rows do not satisfy a comparison
+        duckdb::TableFilterSet filters;
+        filters.filters[1] = duckdb::make_uniq<duckdb::ConstantFilter>(
+                duckdb::ExpressionType::COMPARE_NOTEQUAL, duckdb::Value("v0500"));
+        auto passed = scan(filters, seen);
+        std::vector<int64_t> expected;
+        for (int i = 0; i < rowNum; i++) {
+            if (i != 500 && !isNullRow(i)) {
+                expected.push_back(i);
+            }
+        }
+        EXPECT_EQ(passed, expected);
+    }
+}
+
+TEST_F(PixelsFilterPushdownTest, DateAndTimestampPredicates) {
+    int seen;
+    {
+        // c < dayOf(50)
+        duckdb::TableFilterSet filters;
+        filters.filters[2] = duckdb::make_uniq<duckdb::ConstantFilter>(
+                duckdb::ExpressionType::COMPARE_LESSTHAN, duckdb::Value::DATE(duckdb::date_t(dayOf(50))));
+        auto passed = scan(filters, seen);
+        ASSERT_EQ(passed.size(), 50);
+        EXPECT_EQ(passed.back(), 49);
+        // the row groups after 50 are pruned
+        EXPECT_LT(seen, rowNum);
+    }
+    {
+        // d >= timeOf(990)
+        duckdb::TableFilterSet filters;
+        filters.filters[3] = duckdb::make_uniq<duckdb::ConstantFilter>(
+                duckdb::ExpressionType::COMPARE_GREATERTHANOREQUALTO,
+                duckdb::Value::TIMESTAMP(duckdb::timestamp_t(timeOf(990))));
+        auto passed = scan(filters, seen);
+        ASSERT_EQ(passed.size(), 10);
+        EXPECT_EQ(passed.front(), 990);
+        EXPECT_LT(seen, rowNum);
+    }
+}
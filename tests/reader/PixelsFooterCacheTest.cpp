@@ -0,0 +1,142 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#include "PixelsFooterCache.h"
+#include "exception/InvalidArgumentException.h"
+#include "gtest/gtest.h"
+#include <thread>
+
+namespace {
+
+// a tail of the given number of row groups, the tails of the same number of row groups have the same size
+std::shared_ptr<FileTail> newFileTail(int rowGroupNum) {
+    auto fileTail = std::make_shared<FileTail>();
+    for (int i = 0; i < rowGroupNum; i++) {
+        auto info = fileTail->mutable_footer()->add_rowgroupinfos();
+        info->set_footeroffset(i * 4096);
+        info->set_datalength(4096);
+        info->set_footerlength(128);
+        info->set_numberofrows(1000);
+    }
+    fileTail->set_footerlength(rowGroupNum * 16);
+    return fileTail;
+}
+
+// @return the bytes that an entry of the tail and the id takes in the cache
+uint64_t entryBytes(const std::string &id, int rowGroupNum) {
+    PixelsFooterCache cache(1024 * 1024, 1);
+    cache.putFileTail(id, newFileTail(rowGroupNum));
+    return cache.getSize();
+}
+
+}
+
+TEST(PixelsFooterCacheTest, PutAndFind) {
+    PixelsFooterCache cache;
+    auto fileTail = newFileTail(3);
+    cache.putFileTail("a", fileTail);
+    EXPECT_EQ(cache.findFileTail("a"), fileTail);
+    EXPECT_EQ(cache.getFileTail("a"), fileTail);
+    EXPECT_TRUE(cache.containsFileTail("a"));
+    EXPECT_EQ(cache.findFileTail("b"), nullptr);
+    EXPECT_FALSE(cache.containsFileTail("b"));
+    EXPECT_THROW(cache.getFileTail("b"), InvalidArgumentException);
+
+    auto footer = std::make_shared<RowGroupFooter>();
+    cache.putRGFooter("a-0", footer);
+    EXPECT_EQ(cache.findRGFooter("a-0"), footer);
+    EXPECT_EQ(cache.findRGFooter("a-1"), nullptr);
+}
+
+TEST(PixelsFooterCacheTest, EvictLeastRecentlyUsed) {
+    uint64_t bytes = entryBytes("f0", 10);
+    // three tails fit into the single shard, four do not
+    PixelsFooterCache cache(3 * bytes + bytes / 2, 1);
+    for (const char *id : {"f0", "f1", "f2"}) {
+        cache.putFileTail(id, newFileTail(10));
+    }
+    EXPECT_EQ(cache.getSize(), 3 * bytes);
+    // f0 is used again, so f1 is the least recently used tail
+    ASSERT_NE(cache.findFileTail("f0"), nullptr);
+    cache.putFileTail("f3", newFileTail(10));
+    EXPECT_EQ(cache.getSize(), 3 * bytes);
+    EXPECT_NE(cache.findFileTail("f0"), nullptr);
+    EXPECT_EQ(cache.findFileTail("f1"), nullptr);
+    EXPECT_NE(cache.findFileTail("f2"), nullptr);
+    EXPECT_NE(cache.findFileTail("f3"), nullptr);
+}
+
+TEST(PixelsFooterCacheTest, KeepEntryLargerThanShard) {
+    uint64_t bytes = entryBytes("f0", 10);
+    PixelsFooterCache cache(2 * bytes, 1);
+    cache.putFileTail("f0", newFileTail(10));
+    cache.putFileTail("f1", newFileTail(10));
+    // the large tail evicts the others, but it is kept itself
+    cache.putFileTail("large", newFileTail(1000));
+    EXPECT_NE(cache.findFileTail("large"), nullptr);
+    EXPECT_EQ(cache.findFileTail("f0"), nullptr);
+    EXPECT_EQ(cache.findFileTail("f1"), nullptr);
+    EXPECT_EQ(cache.getSize(), entryBytes("large", 1000));
+}
+
+TEST(PixelsFooterCacheTest, ReplaceEntry) {
+    PixelsFooterCache cache(1024 * 1024, 1);
+    cache.putFileTail("f0", newFileTail(10));
+    uint64_t size = cache.getSize();
+    auto fileTail = newFileTail(10);
+    cache.putFileTail("f0", fileTail);
+    EXPECT_EQ(cache.getSize(), size);
+    EXPECT_EQ(cache.findFileTail("f0"), fileTail);
+}
+
+TEST(PixelsFooterCacheTest, FileId) {
+    std::string id = PixelsFooterCache::getFileId("/data/a.pxl", 100, 1);
+    EXPECT_EQ(id, PixelsFooterCache::getFileId("/data/a.pxl", 100, 1));
+    // a rewritten file has a different length or modification time
+    EXPECT_NE(id, PixelsFooterCache::getFileId("/data/a.pxl", 101, 1));
+    EXPECT_NE(id, PixelsFooterCache::getFileId("/data/a.pxl", 100, 2));
+    EXPECT_NE(id, PixelsFooterCache::getFileId("/data/b.pxl", 100, 1));
+}
+
+TEST(PixelsFooterCacheTest, ConcurrentAccess) {
+    uint64_t bytes = entryBytes("t0-000", 10);
+    const int shardNum = 4;
+    // each shard holds a few tails, so that the threads evict each other's tails
+    PixelsFooterCache cache(shardNum * 8 * bytes, shardNum);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([&cache, t]() {
+            for (int i = 0; i < 500; i++) {
+                char id[16];
+                snprintf(id, sizeof(id), "t%d-%03d", t, i % 100);
+                auto fileTail = cache.findFileTail(id);
+                if (fileTail == nullptr) {
+                    cache.putFileTail(id, newFileTail(10));
+                } else {
+                    ASSERT_EQ(fileTail->footer().rowgroupinfos_size(), 10);
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_GT(cache.getSize(), 0);
+    EXPECT_LE(cache.getSize(), shardNum * 8 * bytes);
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#include "PixelsFooterPrefetcher.h"
+#include "PixelsTestUtils.h"
+#include "physical/PhysicalReaderUtil.h"
+#include "vector/LongColumnVector.h"
+#include "gtest/gtest.h"
+#include <dirent.h>
+
+/**
+ * Prefetch the tails of several files with each localfs.async.lib, and compare them with the
+ * tails read synchronously by the reader.
+ */
+class PixelsFooterPrefetcherTest : public ::testing::TestWithParam<const char *> {
+protected:
+    void SetUp() override {
+        properties.set("localfs.async.lib", GetParam());
+        for (int f = 0; f < fileNum; f++) {
+            // the files have different numbers of row groups, so that their tails differ
+            tempFiles.emplace_back(new TempPixelsFile("pixels_footer_prefetcher_" + std::to_string(f),
+                                                      "struct<a:bigint>", pixelStride, 100, 100 * (f + 1),
+                                                      [](VectorizedRowBatch &rowBatch, int row, int i) {
+                std::static_pointer_cast<LongColumnVector>(rowBatch.cols[0])->add((int64_t) i);
+            }));
+            files.push_back(tempFiles.back()->getPath());
+        }
+    }
+
+    // prefetch the tails into an empty cache and compare them with the synchronously read tails
+    void checkPrefetch() {
+        auto footerCache = std::make_shared<PixelsFooterCache>();
+        auto fileTails = PixelsFooterPrefetcher::prefetch(files, footerCache);
+        ASSERT_EQ(fileTails.size(), files.size());
+        auto storage = StorageFactory::getInstance()->getStorage(::Storage::file);
+        for (int f = 0; f < fileNum; f++) {
+            ASSERT_NE(fileTails[f], nullptr) << files[f];
+            auto fsReader = PhysicalReaderUtil::newPhysicalReader(storage, files[f]);
+            auto expected = PixelsReaderBuilder::readFileTail(fsReader);
+            fsReader->close();
+            EXPECT_EQ(fileTails[f]->SerializeAsString(), expected->SerializeAsString()) << files[f];
+        }
+        EXPECT_GT(footerCache->getSize(), 0);
+    }
+
+    // the number of the open files of the process
+    static int openFiles() {
+        int count = 0;
+        DIR * dir = opendir("/proc/self/fd");
+        while (readdir(dir) != nullptr) {
+            count++;
+        }
+        closedir(dir);
+        return count;
+    }
+
+    static const int pixelStride = 10;
+    const int fileNum = 5;
+    ScopedProperties properties;
+    std::vector<std::unique_ptr<TempPixelsFile>> tempFiles;
+    std::vector<std::string> files;
+};
+
+TEST_P(PixelsFooterPrefetcherTest, MatchesSyncReads) {
+    properties.set("footer.prefetch.depth", "2");
+    checkPrefetch();
+}
+
+TEST_P(PixelsFooterPrefetcherTest, TailLargerThanPrefetch) {
+    // the tails are read again by the workers
+    properties.set("footer.prefetch.size", "16");
+    checkPrefetch();
+}
+
+TEST_P(PixelsFooterPrefetcherTest, RingSetupFails) {
+    // io_uring rejects a queue deeper than 32768 entries, the tails are read by pread instead
+    properties.set("footer.prefetch.depth", "65536");
+    checkPrefetch();
+}
+
+TEST_P(PixelsFooterPrefetcherTest, ClosesFiles) {
+    auto footerCache = std::make_shared<PixelsFooterCache>();
+    int before = openFiles();
+    // the second prefetch finds the tails in the cache
+    for (int pass = 0; pass < 2; pass++) {
+        auto fileTails = PixelsFooterPrefetcher::prefetch(files, footerCache);
+        EXPECT_EQ(openFiles(), before) << "pass " << pass;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(AsyncLib, PixelsFooterPrefetcherTest, ::testing::Values("iouring", "aio", "pread"));
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#include "PixelsManifest.h"
+#include "PixelsTestUtils.h"
+#include "vector/LongColumnVector.h"
+#include "gtest/gtest.h"
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <unistd.h>
+
+class PixelsManifestTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char tmpl[] = "/tmp/pixels_manifest_XXXXXX";
+        ASSERT_NE(mkdtemp(tmpl), nullptr);
+        dir = tmpl;
+        for (int i = 0; i < fileNum; i++) {
+            files.push_back(dir + "/" + std::to_string(i) + ".pxl");
+            writeFile(files.back(), 100 + i * 10);
+        }
+    }
+
+    void TearDown() override {
+        for (const auto &file : files) {
+            unlink(file.c_str());
+        }
+        unlink((dir + "/" + PixelsManifest::FILE_NAME).c_str());
+        rmdir(dir.c_str());
+    }
+
+    static void writeFile(const std::string &path, int rows) {
+        TempPixelsFile::write(path, "struct<a:bigint>", 10, 200, rows,
+                              [](VectorizedRowBatch &rowBatch, int row, int i) {
+            std::static_pointer_cast<LongColumnVector>(rowBatch.cols[0])->add((int64_t) i);
+        });
+    }
+
+    const int fileNum = 5;
+    std::string dir;
+    std::vector<std::string> files;
+};
+
+TEST_F(PixelsManifestTest, WriteAndRead) {
+    EXPECT_EQ(PixelsManifest::open(dir), nullptr);
+    auto manifest = PixelsManifest::refresh(dir);
+    ASSERT_NE(manifest, nullptr);
+    EXPECT_EQ(manifest->getFileNum(), fileNum);
+
+    manifest = PixelsManifest::open(dir);
+    ASSERT_NE(manifest, nullptr);
+    EXPECT_EQ(manifest->getFileNum(), fileNum);
+    for (int i = 0; i < fileNum; i++) {
+        auto tail = manifest->getFileTail(files[i]);
+        ASSERT_NE(tail, nullptr);
+        EXPECT_EQ(tail->postscript().numberofrows(), 100 + i * 10);
+    }
+
+    // the tails seeded into the footer cache are used by the reader
+    auto footerCache = std::make_shared<PixelsFooterCache>();
+    auto tails = PixelsManifest::getFileTails(files, footerCache);
+    ASSERT_EQ(tails.size(), files.size());
+    auto storage = StorageFactory::getInstance()->getStorage(::Storage::file);
+    auto reader = std::make_shared<PixelsReaderBuilder>()
+            ->setPath(files[2])
+            ->setStorage(storage)
+            ->setPixelsFooterCache(footerCache)
+            ->build();
+    EXPECT_EQ(reader->getNumberOfRows(), 120);
+}
+
+TEST_F(PixelsManifestTest, StaleDetection) {
+    PixelsManifest::refresh(dir);
+    // make sure the modification time changes
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    writeFile(files[3], 77);
+
+    auto tails = PixelsManifest::getFileTails(files, nullptr);
+    EXPECT_EQ(tails[3], nullptr);
+    ASSERT_NE(tails[2], nullptr);
+
+    PixelsManifest::refresh(dir);
+    tails = PixelsManifest::getFileTails(files, nullptr);
+    ASSERT_NE(tails[3], nullptr);
+    EXPECT_EQ(tails[3]->postscript().numberofrows(), 77);
+
+    unlink(files[4].c_str());
+    files.pop_back();
+    auto manifest = PixelsManifest::refresh(dir);
+    EXPECT_EQ(manifest->getFileNum(), fileNum - 1);
+}
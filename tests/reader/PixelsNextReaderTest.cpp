@@ -0,0 +1,88 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#include "PixelsTestUtils.h"
+#include "reader/PixelsRecordReaderImpl.h"
+#include "physical/BufferPool.h"
+#include "vector/LongColumnVector.h"
+#include "gtest/gtest.h"
+
+/**
+ * Scan a compressed file one row group at a time the way pixels_scan does: the next reader
+ * reads (and decompresses) its chunks before the current reader decodes its own, so their
+ * buffers in the buffer pool must not be shared.
+ */
+class PixelsNextReaderTest : public ::testing::TestWithParam<const char *> {
+protected:
+    void SetUp() override {
+        properties.set("compression.kind", GetParam());
+        properties.set("localfs.enable.async.io", "false");
+        file.reset(new TempPixelsFile("pixels_next_reader", "struct<a:bigint>", pixelStride, 400, rowNum,
+                                      [](VectorizedRowBatch &rowBatch, int row, int i) {
+            // every row has its own value, so that decoding the chunk of another row group is detected
+            std::static_pointer_cast<LongColumnVector>(rowBatch.cols[0])->add((int64_t) i * 3);
+        }, 64));
+    }
+
+    std::shared_ptr<PixelsRecordReader> readRowGroup(const std::shared_ptr<PixelsReader> &reader, int rgId) {
+        auto recordReader = reader->read(TempPixelsFile::scanOption({"a"}, pixelStride, rgId, 1));
+        std::static_pointer_cast<PixelsRecordReaderImpl>(recordReader)->read();
+        return recordReader;
+    }
+
+    static const int pixelStride = 10;
+    const int rowNum = 2000;
+    ScopedProperties properties;
+    std::unique_ptr<TempPixelsFile> file;
+};
+
+TEST_P(PixelsNextReaderTest, ReadNextWhileDecoding) {
+    auto reader = file->openReader();
+    int rgNum = reader->getRowGroupNum();
+    ASSERT_GT(rgNum, 2);
+
+    std::shared_ptr<PixelsRecordReader> curr;
+    int64_t rowId = 0;
+    for (int rgId = 0; rgId <= rgNum; rgId++) {
+        ::BufferPool::Switch();
+        auto next = rgId < rgNum ? readRowGroup(reader, rgId) : nullptr;
+        if (curr != nullptr) {
+            while (true) {
+                auto rowBatch = curr->readBatch(false);
+                if (rowBatch->cols.empty()) {
+                    break;
+                }
+                auto a = std::static_pointer_cast<LongColumnVector>(rowBatch->cols[0]);
+                for (int i = 0; i < rowBatch->rowCount; i++) {
+                    ASSERT_EQ(a->longVector[i], (rowId + i) * 3) << "row " << rowId + i;
+                }
+                rowId += rowBatch->rowCount;
+                if (rowBatch->isEndOfFile()) {
+                    break;
+                }
+            }
+            curr->close();
+        }
+        curr = next;
+    }
+    EXPECT_EQ(rowId, rowNum);
+    reader->close();
+}
+
+INSTANTIATE_TEST_SUITE_P(Compression, PixelsNextReaderTest, ::testing::Values("lz4", "zstd"));
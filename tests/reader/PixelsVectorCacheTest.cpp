@@ -0,0 +1,120 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#include "PixelsVectorCache.h"
+#include "vector/LongColumnVector.h"
+#include "gtest/gtest.h"
+#include <cstring>
+
+namespace {
+
+const uint64_t vectorBytes = 1024;
+
+std::shared_ptr<DecodedVector> newVector() {
+    auto vector = std::make_shared<DecodedVector>();
+    vector->values = std::unique_ptr<uint8_t[]>(new uint8_t[vectorBytes]);
+    vector->bytes = vectorBytes;
+    return vector;
+}
+
+}
+
+TEST(PixelsVectorCacheTest, EvictLeastRecentlyUsed) {
+    PixelsVectorCache cache(3 * vectorBytes, 1, "", "");
+    for (const char *id : {"v0", "v1", "v2"}) {
+        ASSERT_TRUE(cache.put(id, newVector(), false));
+    }
+    // v0 is used again, so v1 is the least recently used vector
+    ASSERT_NE(cache.find("v0"), nullptr);
+    ASSERT_TRUE(cache.put("v3", newVector(), false));
+    EXPECT_NE(cache.find("v0"), nullptr);
+    EXPECT_EQ(cache.find("v1"), nullptr);
+    EXPECT_NE(cache.find("v2"), nullptr);
+    EXPECT_NE(cache.find("v3"), nullptr);
+    EXPECT_EQ(cache.getSize(), 3 * vectorBytes);
+}
+
+TEST(PixelsVectorCacheTest, PinnedNotEvicted) {
+    PixelsVectorCache cache(3 * vectorBytes, 1, "", "");
+    auto pinned = newVector();
+    ASSERT_TRUE(cache.put("pinned", pinned, true));
+    // the other vectors evict each other, but never the pinned one, even if it is not used
+    for (int i = 0; i < 10; i++) {
+        ASSERT_TRUE(cache.put("v" + std::to_string(i), newVector(), false));
+    }
+    EXPECT_EQ(cache.find("pinned"), pinned);
+    EXPECT_NE(cache.find("v9"), nullptr);
+    EXPECT_NE(cache.find("v8"), nullptr);
+    EXPECT_EQ(cache.find("v7"), nullptr);
+    EXPECT_EQ(cache.getSize(), 3 * vectorBytes);
+
+    // the pinned vectors fill the cache, so no other vector can be cached
+    ASSERT_TRUE(cache.put("pinned1", newVector(), true));
+    ASSERT_TRUE(cache.put("pinned2", newVector(), true));
+    EXPECT_EQ(cache.find("v9"), nullptr);
+    EXPECT_EQ(cache.find("v8"), nullptr);
+    EXPECT_FALSE(cache.put("v10", newVector(), false));
+    EXPECT_FALSE(cache.put("pinned3", newVector(), true));
+    for (const char *id : {"pinned", "pinned1", "pinned2"}) {
+        EXPECT_NE(cache.find(id), nullptr) << id;
+    }
+    EXPECT_EQ(cache.getSize(), 3 * vectorBytes);
+}
+
+TEST(PixelsVectorCacheTest, RejectLargeVector) {
+    PixelsVectorCache cache(4 * vectorBytes, 2, "", "");
+    auto vector = newVector();
+    vector->bytes = 2 * vectorBytes + 1;
+    EXPECT_FALSE(cache.put("large", vector, false));
+    EXPECT_EQ(cache.find("large"), nullptr);
+    EXPECT_EQ(cache.getSize(), 0);
+}
+
+TEST(PixelsVectorCacheTest, Columns) {
+    PixelsVectorCache all(vectorBytes, 1, "", "");
+    EXPECT_TRUE(all.isCached("/data/orders/v-0-order/a.pxl", "o_orderkey"));
+    EXPECT_FALSE(all.isPinned("/data/orders/v-0-order/a.pxl", "o_orderkey"));
+
+    PixelsVectorCache cache(vectorBytes, 1, " l_shipdate, orders.o_orderkey ", "nation.n_name");
+    EXPECT_TRUE(cache.isCached("/data/lineitem/v-0-order/a.pxl", "l_shipdate"));
+    EXPECT_TRUE(cache.isCached("/data/orders/v-0-order/a.pxl", "O_ORDERKEY"));
+    // the column is only cached in the files of its table
+    EXPECT_FALSE(cache.isCached("/data/orders_old/v-0-order/a.pxl", "o_orderkey"));
+    EXPECT_FALSE(cache.isCached("/data/lineitem/v-0-order/a.pxl", "l_orderkey"));
+    // the pinned columns are always cached
+    EXPECT_TRUE(cache.isCached("/data/nation/v-0-order/a.pxl", "n_name"));
+    EXPECT_TRUE(cache.isPinned("/data/nation/v-0-order/a.pxl", "n_name"));
+    EXPECT_FALSE(cache.isPinned("/data/region/v-0-order/a.pxl", "n_name"));
+}
+
+TEST(PixelsVectorCacheTest, CopyOfLongVector) {
+    auto vector = std::make_shared<LongColumnVector>(100);
+    for (int i = 0; i < 100; i++) {
+        vector->add((int64_t) i * 7);
+    }
+    std::pair<std::shared_ptr<BinaryDictionary>, std::shared_ptr<BinaryDictionary>> copiedDictionary;
+    auto decoded = DecodedVector::copyOf(vector, TypeDescription::LONG, 100, copiedDictionary);
+    ASSERT_NE(decoded, nullptr);
+    EXPECT_EQ(decoded->bytes, 100 * sizeof(int64_t) + 2 * sizeof(uint64_t));
+    EXPECT_EQ(std::memcmp(decoded->values.get(), vector->longVector, 100 * sizeof(int64_t)), 0);
+    EXPECT_EQ(decoded->valid, std::vector<uint64_t>(vector->isValid, vector->isValid + 2));
+    // the copy does not change with the vector
+    vector->longVector[0] = -1;
+    EXPECT_EQ(((int64_t *) decoded->values.get())[0], 0);
+}
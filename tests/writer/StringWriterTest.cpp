@@ -0,0 +1,96 @@
+/*
+ * Copyright 2024 PixelsDB.
+ *
+ * This file is part of Pixels.
+ *
+ * Pixels is free software: you can redistribute it and/or modify
+ * it under the terms of the Affero GNU General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * Pixels is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * Affero GNU General Public License for more details.
+ *
+ * You should have received a copy of the Affero GNU General Public
+ * License along with Pixels.  If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+#include "writer/StringColumnWriter.h"
+#include "reader/StringColumnReader.h"
+#include "vector/BinaryColumnVector.h"
+
+#include "gtest/gtest.h"
+
+namespace {
+
+std::shared_ptr<BinaryColumnVector> createStringVector(std::vector<std::string> & values) {
+    auto vector = std::make_shared<BinaryColumnVector>(values.size());
+    for (int i = 0; i < values.size(); ++i) {
+        vector->vector[i] = duckdb::string_t(values[i].data(), values[i].size());
+        vector->isNull[i] = false;
+    }
+    return vector;
+}
+
+void writeAndCheck(std::vector<std::string> & values, EncodingLevel::Level level, int pixel_stride,
+                   pixels::proto::ColumnEncoding_Kind expected_kind) {
+    int len = values.size();
+    auto string_column_vector = createStringVector(values);
+    auto option = std::make_shared<PixelsWriterOption>();
+    option->setPixelsStride(pixel_stride);
+    option->setNullsPadding(false);
+    option->setEncodingLevel(EncodingLevel(level));
+
+    auto string_column_writer = std::make_unique<StringColumnWriter>(TypeDescription::createString(), option);
+    string_column_writer->write(string_column_vector, len);
+    string_column_writer->flush();
+    auto content = string_column_writer->getColumnChunkContent();
+    EXPECT_GT(content.size(), 0);
+    auto column_chunk_encoding = string_column_writer->getColumnChunkEncoding();
+    EXPECT_EQ(column_chunk_encoding.kind(), expected_kind);
+
+    auto string_column_reader = std::make_unique<StringColumnReader>(TypeDescription::createString());
+    auto buffer = std::make_shared<ByteBuffer>(content.size());
+    buffer->putBytes(content.data(), content.size());
+    auto string_result_vector = std::make_shared<BinaryColumnVector>(len);
+
+    auto num_to_read = len;
+    auto pixel_offset = 0;
+    auto vector_index = 0;
+    while(num_to_read) {
+        auto size = std::min(pixel_stride, num_to_read);
+        string_column_reader->read(buffer, column_chunk_encoding, pixel_offset, size, pixel_stride, vector_index,
+            string_result_vector, *string_column_writer->getColumnChunkIndexPtr(), nullptr);
+        for(int i = vector_index; i < vector_index + size; i++) {
+            EXPECT_EQ(string_result_vector->vector[i].GetString(), values[i]);
+        }
+        pixel_offset += size;
+        vector_index += size;
+        num_to_read -= size;
+    }
+    string_column_writer->close();
+}
+
+}
+
+TEST(StringWriterTest, WriteDictionaryEncodeWithoutNull) {
+    std::vector<std::string> values;
+    std::vector<std::string> modes = {"AIR", "MAIL", "SHIP", "TRUCK"};
+    for (int i = 0; i < 45; ++i) {
+        values.push_back(modes[i % modes.size()]);
+    }
+    writeAndCheck(values, EncodingLevel::EL2, 10, pixels::proto::ColumnEncoding_Kind_DICTIONARY);
+    writeAndCheck(values, EncodingLevel::EL1, 10, pixels::proto::ColumnEncoding_Kind_DICTIONARY);
+}
+
+TEST(StringWriterTest, WriteHighCardinalityWithoutDictionary) {
+    std::vector<std::string> values;
+    for (int i = 0; i < 20; ++i) {
+        values.push_back("value-" + std::to_string(i));
+    }
+    // the first pixel has only distinct values, so dictionary encoding is given up
+    writeAndCheck(values, EncodingLevel::EL2, 5, pixels::proto::ColumnEncoding_Kind_NONE);
+    writeAndCheck(values, EncodingLevel::EL0, 5, pixels::proto::ColumnEncoding_Kind_NONE);
+}